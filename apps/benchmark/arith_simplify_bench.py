@@ -0,0 +1,98 @@
+"""Compile-time benchmark of the arithmetic simplifiers.
+
+Index expressions are collected from lowered topi schedules and
+simplified by both CanonicalSimplify and the rewrite simplifier.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import tvm
+import topi
+
+
+def conv2d_nchw(batch, in_channel, in_size, num_filter, kernel, stride, padding):
+    A = tvm.placeholder((batch, in_channel, in_size, in_size), name='A')
+    W = tvm.placeholder((num_filter, in_channel, kernel, kernel), name='W')
+    with tvm.target.create('llvm'):
+        B = topi.nn.conv2d(A, W, (stride, stride), (padding, padding), (1, 1),
+                           layout='NCHW', out_dtype='float32')
+        s = topi.generic.schedule_conv2d_nchw([B])
+    return s, [A, W, B]
+
+
+def depthwise_conv2d_nchw(batch, in_channel, in_size, kernel, stride, padding):
+    A = tvm.placeholder((batch, in_channel, in_size, in_size), name='A')
+    W = tvm.placeholder((in_channel, 1, kernel, kernel), name='W')
+    with tvm.target.create('llvm'):
+        B = topi.nn.depthwise_conv2d_nchw(A, W, (stride, stride), padding, (1, 1))
+        s = topi.generic.schedule_depthwise_conv2d_nchw([B])
+    return s, [A, W, B]
+
+
+def dense(batch, in_dim, out_dim):
+    A = tvm.placeholder((batch, in_dim), name='A')
+    W = tvm.placeholder((out_dim, in_dim), name='W')
+    with tvm.target.create('llvm'):
+        B = topi.nn.dense(A, W)
+        s = topi.generic.schedule_dense([B])
+    return s, [A, W, B]
+
+
+# workloads taken from resnet-18 and mobilenet
+CORPUS = [
+    ("conv2d_3x3", lambda: conv2d_nchw(1, 64, 56, 64, 3, 1, 1)),
+    ("conv2d_1x1", lambda: conv2d_nchw(1, 128, 28, 256, 1, 2, 0)),
+    ("conv2d_7x7", lambda: conv2d_nchw(1, 3, 224, 64, 7, 2, 3)),
+    ("depthwise_3x3", lambda: depthwise_conv2d_nchw(1, 256, 28, 3, 1, 1)),
+    ("dense", lambda: dense(1, 512, 1000)),
+]
+
+
+def collect_index_exprs(stmt):
+    """Collect the integer expressions of loads and stores in stmt."""
+    exprs = []
+    def _visit(node):
+        if isinstance(node, (tvm.expr.Load, tvm.stmt.Store)):
+            if node.index.dtype.startswith("int"):
+                exprs.append(node.index)
+    tvm.ir_pass.PostOrderVisit(stmt, _visit)
+    return exprs
+
+
+def time_simplify(func, exprs, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.time()
+        for e in exprs:
+            func(e)
+        best = min(best, time.time() - start)
+    return best * 1000
+
+
+def benchmark(name, make_schedule, repeat):
+    s, args = make_schedule()
+    start = time.time()
+    stmt = tvm.lower(s, args, simple_mode=True)
+    lower_time = (time.time() - start) * 1000
+    exprs = collect_index_exprs(stmt)
+    analyzer = tvm.arith.Analyzer()
+    canonical = time_simplify(tvm.ir_pass.CanonicalSimplify, exprs, repeat)
+    rewrite = time_simplify(analyzer.rewrite_simplify, exprs, repeat)
+    print("%-16s %-8d %-12s %-14s %-12s" % (
+        name, len(exprs), "%.2f ms" % lower_time,
+        "%.2f ms" % canonical, "%.2f ms" % rewrite))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--workload", type=str, choices=[x[0] for x in CORPUS],
+                        help="The name of the workload, run all workloads if not set")
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    print("%-16s %-8s %-12s %-14s %-12s" % (
+        "workload", "#exprs", "lower", "canonical", "rewrite"))
+    for name, make_schedule in CORPUS:
+        if args.workload is None or args.workload == name:
+            benchmark(name, make_schedule, args.repeat)
@@ -0,0 +1,65 @@
+"""Benchmark of autotvm itervar feature extraction.
+
+Compare extracting features one config at a time with the batched,
+multi-threaded extraction. see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import numpy as np
+import tvm
+from tvm import autotvm
+from tvm.autotvm import feature
+
+
+@autotvm.template
+def matmul(N, L, M, dtype):
+    A = tvm.placeholder((N, L), name='A', dtype=dtype)
+    B = tvm.placeholder((L, M), name='B', dtype=dtype)
+    k = tvm.reduce_axis((0, L), name='k')
+    C = tvm.compute((N, M), lambda i, j: tvm.sum(A[i, k] * B[k, j], axis=k), name='C')
+    s = tvm.create_schedule(C.op)
+
+    y, x = s[C].op.axis
+    k = s[C].op.reduce_axis[0]
+
+    cfg = autotvm.get_config()
+    cfg.define_split("tile_y", y, num_outputs=3)
+    cfg.define_split("tile_x", x, num_outputs=3)
+    cfg.define_split("tile_k", k, num_outputs=2)
+    yo, ym, yi = cfg["tile_y"].apply(s, C, y)
+    xo, xm, xi = cfg["tile_x"].apply(s, C, x)
+    ko, ki = cfg["tile_k"].apply(s, C, k)
+    s[C].reorder(yo, xo, ko, ym, xm, ki, yi, xi)
+    return s, [A, B, C]
+
+
+def benchmark(num_configs, num_threads, size):
+    task = autotvm.task.create(matmul, args=(size, size, size, 'float32'), target='llvm')
+    space = task.config_space
+    indexes = np.random.choice(len(space), min(num_configs, len(space)), replace=False)
+
+    with tvm.target.create('llvm'):
+        sch_args = [task.instantiate(space.get(i)) for i in indexes]
+
+    start = time.time()
+    for s, args in sch_args:
+        feature.get_itervar_feature_flatten(s, args, take_log=True)
+    single = time.time() - start
+
+    start = time.time()
+    feature.get_itervar_feature_flatten_batch(sch_args, take_log=True, num_threads=num_threads)
+    batch = time.time() - start
+
+    print("%-10d %-12s %-12s" % (len(indexes), "%.2f s" % single, "%.2f s" % batch))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num-configs", type=int, default=1000)
+    parser.add_argument("--num-threads", type=int, default=0)
+    parser.add_argument("--size", type=int, default=512)
+    args = parser.parse_args()
+
+    print("%-10s %-12s %-12s" % ("#configs", "one-by-one", "batch"))
+    benchmark(args.num_configs, args.num_threads, args.size)
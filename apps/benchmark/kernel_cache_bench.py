@@ -0,0 +1,63 @@
+"""Compile-time benchmark of the persistent kernel cache.
+
+A network is built with relay three times: without the cache, with an
+empty cache and with the cache filled by the previous build. The compile
+engine is cleared before each build, as in a new process. The cache keeps
+lowered kernels, so a warm build still runs the LLVM code generation of
+every kernel: the difference between the cold and the warm build is the
+lowering time that is saved.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import tvm
+from tvm import relay
+from tvm.contrib import util
+import tvm.relay.testing
+
+
+def get_network(name, batch_size):
+    if name == 'resnet-18':
+        return relay.testing.resnet.get_workload(num_layers=18, batch_size=batch_size)
+    if name == 'mobilenet':
+        return relay.testing.mobilenet.get_workload(batch_size=batch_size)
+    raise ValueError("Unsupported network: " + name)
+
+
+def timed_build(net, params, target):
+    relay.backend.compile_engine.get().clear()
+    start = time.time()
+    with relay.build_config(opt_level=3):
+        relay.build(net, target=target, params=params)
+    return time.time() - start
+
+
+def benchmark(network, target):
+    net, params = get_network(network, 1)
+    temp = util.tempdir()
+    tvm.codegen.kernel_cache_config(None)
+    cost_nocache = timed_build(net, params, target)
+    tvm.codegen.kernel_cache_config(temp.temp_dir)
+    try:
+        cost_cold = timed_build(net, params, target)
+        cost_warm = timed_build(net, params, target)
+        stats = tvm.codegen.kernel_cache_stats()
+    finally:
+        tvm.codegen.kernel_cache_config(None)
+    print("%-12s %-10s %-10s %-10s %-8d" % (network,
+                                          "%.2f s" % cost_nocache,
+                                          "%.2f s" % cost_cold,
+                                          "%.2f s" % cost_warm,
+                                          stats["hits"]))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--network", type=str, choices=['resnet-18', 'mobilenet'],
+                        default='resnet-18')
+    parser.add_argument("--target", type=str, default='llvm')
+    args = parser.parse_args()
+
+    print("%-12s %-10s %-10s %-10s %-8s" % ("network", "no cache", "cold", "warm", "hits"))
+    benchmark(args.network, args.target)
@@ -0,0 +1,154 @@
+# pylint: disable=invalid-name, too-many-locals, too-many-arguments
+"""Benchmark of the CPU non-maximum suppression on detection sized inputs.
+
+The vectorized nms of topi, parallel over batches and groups of classes, is
+compared with the previous kernel, which computes the IoU of one pair of boxes
+at a time in a serial loop per batch. Both use the argsort of the contrib sort
+library, so build TVM with `USE_SORT` enabled.
+see README.md for the usage of this script.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import api
+import topi
+
+
+def baseline_nms_ir(data, sort_result, valid_count, out, nms_threshold, force_suppress, nms_topk):
+    """The pairwise nms IR this benchmark compares against."""
+    def calculate_overlap(out_tensor, box_a_idx, box_b_idx):
+        """Calculate overlap of two boxes.
+        """
+        w = tvm.make.Max(0.0, tvm.make.Min(out_tensor[box_a_idx + 2], out_tensor[box_b_idx + 2])
+                         - tvm.make.Max(out_tensor[box_a_idx], out_tensor[box_b_idx]))
+        h = tvm.make.Max(0.0, tvm.make.Min(out_tensor[box_a_idx + 3], out_tensor[box_b_idx + 3])
+                         - tvm.make.Max(out_tensor[box_a_idx + 1], out_tensor[box_b_idx + 1]))
+        i = w * h
+        u = (out_tensor[box_a_idx + 2] - out_tensor[box_a_idx]) * \
+            (out_tensor[box_a_idx + 3] - out_tensor[box_a_idx + 1]) + \
+            (out_tensor[box_b_idx + 2] - out_tensor[box_b_idx]) * \
+            (out_tensor[box_b_idx + 3] - out_tensor[box_b_idx + 1]) - i
+        return tvm.expr.Select(u <= 0.0, 0.0, i / u)
+
+    ib = tvm.ir_builder.create()
+    p_data = ib.buffer_ptr(data)
+    p_sort_result = ib.buffer_ptr(sort_result)
+    p_valid_count = ib.buffer_ptr(valid_count)
+    p_out = ib.buffer_ptr(out)
+    batch_size = out.shape[0]
+    num_anchors = out.shape[1]
+
+    nms_threshold_node = tvm.make.node("FloatImm", dtype="float32", value=nms_threshold)
+    nms_topk_node = tvm.make.node("IntImm", dtype="int32", value=nms_topk)
+    force_suppress_node = tvm.make.node("IntImm", dtype="int32", value=1 if force_suppress else 0)
+    with ib.for_range(0, batch_size, for_type="parallel", name="n") as n:
+        with ib.if_scope(tvm.all(nms_threshold_node > 0, nms_threshold_node < 1,
+                                 p_valid_count[0] > 0)):
+            # Reorder output
+            nkeep = tvm.if_then_else(
+                tvm.all(nms_topk_node > 0, nms_topk < p_valid_count[n]),
+                nms_topk, p_valid_count[n])
+            with ib.for_range(0, nkeep, name="l") as l:
+                with ib.for_range(0, 6, name="m") as m:
+                    p_out[(n * num_anchors * 6
+                           + l * 6 + m)] = p_data[(n * num_anchors * 6
+                                                   + p_sort_result[n * num_anchors + l] * 6 + m)]
+            with ib.if_scope(tvm.all(nms_topk_node > 0, nms_topk < p_valid_count[n])):
+                with ib.for_range(0, p_valid_count[n] - nkeep, name="l") as l:
+                    with ib.for_range(0, 6, name="m") as m:
+                        p_out[(n * num_anchors * 6
+                               + (l + nkeep) * 6 + m)] = p_data[(n * num_anchors * 6
+                                                                 + (l + nkeep) * 6 + m)]
+            # Apply nms
+            with ib.for_range(0, p_valid_count[n], name="l") as l:
+                offset_l = l * 6
+                with ib.if_scope(p_out[n * num_anchors * 6 + offset_l] >= 0):
+                    with ib.for_range(0, p_valid_count[n], name="m") as m:
+                        offset_m = m * 6
+                        with ib.if_scope(tvm.all(m > l, p_out[n * num_anchors * 6
+                                                              + offset_m] >= 0)):
+                            with ib.if_scope(tvm.any(force_suppress_node > 0,
+                                                     p_out[n * num_anchors * 6 + offset_l] ==
+                                                     p_out[n * num_anchors * 6 + offset_m])):
+                                # When force_suppress == True or class_id equals
+                                iou = calculate_overlap(p_out, n * num_anchors * 6 + offset_l + 2,
+                                                        n * num_anchors * 6 + offset_m + 2)
+                                with ib.if_scope(iou >= nms_threshold):
+                                    p_out[n * num_anchors * 6 + offset_m] = -1.0
+        with ib.else_scope():
+            with ib.for_range(0, p_valid_count[n], name="l") as l:
+                with ib.for_range(0, 6, name="m") as m:
+                    p_out[(n * num_anchors * 6
+                           + l * 6 + m)] = p_data[n * num_anchors * 6 + l * 6 + m]
+        # Set invalid entry to be -1
+        with ib.for_range(0, num_anchors - p_valid_count[n], name="l") as l:
+            with ib.for_range(0, 6, name="m") as m:
+                p_out[n * num_anchors * 6 + (l + p_valid_count[n]) * 6 + m] = -1.0
+    return ib.get()
+
+
+
+def build_nms(batch, num_anchors, nms_threshold, force_suppress, nms_topk, baseline):
+    data = tvm.placeholder((batch, num_anchors, 6), name='data')
+    valid_count = tvm.placeholder((batch,), name='valid_count', dtype='int32')
+    with tvm.target.create('llvm'):
+        out = topi.vision.nms(data, valid_count, nms_threshold, force_suppress, nms_topk)
+        if baseline:
+            # replace the nms kernel, keep the sort
+            sort_tensor = out.op.input_tensors[1]
+            valid_count_buf = api.decl_buffer(valid_count.shape, 'int32', 'valid_count_buf',
+                                              data_alignment=4)
+            sort_tensor_buf = api.decl_buffer(sort_tensor.shape, 'int32', 'sort_tensor_buf',
+                                              data_alignment=8)
+            out = tvm.extern(data.shape, [data, sort_tensor, valid_count],
+                             lambda ins, outs: baseline_nms_ir(
+                                 ins[0], ins[1], ins[2], outs[0], nms_threshold,
+                                 force_suppress, nms_topk),
+                             dtype='float32',
+                             in_buffers=[api.decl_buffer(data.shape, data.dtype, 'data_buf',
+                                                         data_alignment=8),
+                                         sort_tensor_buf, valid_count_buf],
+                             tag='nms')
+        s = topi.generic.schedule_nms(out)
+    return tvm.build(s, [data, valid_count, out], 'llvm')
+
+
+def benchmark(batch, num_anchors, num_classes, force_suppress, nms_topk, repeat):
+    ctx = tvm.cpu(0)
+    np_data = np.zeros((batch, num_anchors, 6), dtype='float32')
+    np_data[:, :, 0] = np.random.randint(0, num_classes, size=(batch, num_anchors))
+    np_data[:, :, 1] = np.random.uniform(size=(batch, num_anchors))
+    np_data[:, :, 2:4] = np.random.uniform(0, 1, size=(batch, num_anchors, 2))
+    np_data[:, :, 4:6] = np_data[:, :, 2:4] + \
+        np.random.uniform(0.01, 0.1, size=(batch, num_anchors, 2))
+    data = tvm.nd.array(np_data, ctx)
+    valid_count = tvm.nd.array(np.full((batch,), num_anchors, dtype='int32'), ctx)
+    out = tvm.nd.empty((batch, num_anchors, 6), 'float32', ctx)
+
+    costs = []
+    for baseline in [True, False]:
+        f = build_nms(batch, num_anchors, 0.5, force_suppress, nms_topk, baseline)
+        costs.append(f.time_evaluator(f.entry_name, ctx, number=repeat)(
+            data, valid_count, out).mean)
+    print("%-8d %-10d %-10d %-8s %-12s %-12s" % (batch, num_anchors, num_classes,
+                                                force_suppress,
+                                                "%.2f ms" % (costs[0] * 1000),
+                                                "%.2f ms" % (costs[1] * 1000)))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batch", type=int, default=1)
+    parser.add_argument("--num-anchors", type=int, default=8732)
+    parser.add_argument("--num-classes", type=int, default=20)
+    parser.add_argument("--topk", type=int, default=400)
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    print("%-8s %-10s %-10s %-8s %-12s %-12s" % ("batch", "#anchors", "#classes", "force",
+                                                "baseline", "nms"))
+    for force in [False, True]:
+        benchmark(args.batch, args.num_anchors, args.num_classes, force, args.topk,
+                  args.repeat)
@@ -0,0 +1,48 @@
+"""Compile-time benchmark of bound inference on deep schedules.
+
+A chain of elementwise stages is attached to the loop nest of the
+final stage, and each stage reads the two stages before it.
+see README.md for the usage of this script.
+"""
+import argparse
+import time
+
+import tvm
+
+
+def build_schedule(num_stages, n):
+    A = tvm.placeholder((n, n), name='A')
+    stages = [tvm.compute((n, n), lambda i, j: A[i, j] + 1, name='S0')]
+    for k in range(1, num_stages):
+        prev = stages[-1]
+        prev2 = stages[-2] if k > 1 else A
+        stages.append(tvm.compute(
+            (n, n), lambda i, j, p=prev, q=prev2: p[i, j] + q[i, j],
+            name='S%d' % k))
+    out = stages[-1]
+    s = tvm.create_schedule(out.op)
+    xo, xi = s[out].split(out.op.axis[0], 8)
+    for t in stages[:-1]:
+        s[t].compute_at(s[out], xo)
+    return s
+
+
+def benchmark(num_stages, n, repeat):
+    s = build_schedule(num_stages, n).normalize()
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.time()
+        tvm.schedule.InferBound(s)
+        best = min(best, time.time() - start)
+    print("%-10d %-12s" % (num_stages, "%.2f ms" % (best * 1000)))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num-stages", type=int, default=100)
+    parser.add_argument("--size", type=int, default=1024)
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    print("%-10s %-12s" % ("#stages", "InferBound"))
+    benchmark(args.num_stages, args.size, args.repeat)
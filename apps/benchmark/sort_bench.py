@@ -0,0 +1,60 @@
+"""Benchmark of the sort contrib library on detection sized inputs.
+
+The scores of about 100k boxes per image are sorted, as in the
+post-processing of SSD before non-maximum suppression.
+see README.md for the usage of this script.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm.contrib import sort
+
+
+def build_argsort(batch, num_boxes, dtype):
+    data = tvm.placeholder((batch, num_boxes), name='data', dtype=dtype)
+    valid_count = tvm.placeholder((batch,), name='valid_count', dtype='int32')
+    out = sort.argsort(data, valid_count, axis=1, is_descend=True)
+    s = tvm.create_schedule(out.op)
+    return tvm.build(s, [data, valid_count, out], 'llvm')
+
+
+def build_topk(batch, num_boxes, k, dtype):
+    data = tvm.placeholder((batch, num_boxes), name='data', dtype=dtype)
+    values, indices = sort.topk(data, k, axis=1, is_descend=True)
+    s = tvm.create_schedule(values.op)
+    return tvm.build(s, [data, values, indices], 'llvm')
+
+
+def benchmark(batch, num_boxes, k, dtype, repeat):
+    ctx = tvm.cpu(0)
+    np_data = np.random.uniform(size=(batch, num_boxes)).astype(dtype)
+    data = tvm.nd.array(np_data, ctx)
+    valid_count = tvm.nd.array(np.full((batch,), num_boxes, dtype='int32'), ctx)
+    out = tvm.nd.empty((batch, num_boxes), 'int32', ctx)
+    values = tvm.nd.empty((batch, k), dtype, ctx)
+    indices = tvm.nd.empty((batch, k), 'int32', ctx)
+
+    f = build_argsort(batch, num_boxes, dtype)
+    cost_argsort = f.time_evaluator(f.entry_name, ctx, number=repeat)(
+        data, valid_count, out).mean
+    f = build_topk(batch, num_boxes, k, dtype)
+    cost_topk = f.time_evaluator(f.entry_name, ctx, number=repeat)(
+        data, values, indices).mean
+    print("%-8d %-10d %-8s %-12s %-12s" % (batch, num_boxes, dtype,
+                                          "%.2f ms" % (cost_argsort * 1000),
+                                          "%.2f ms" % (cost_topk * 1000)))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batch", type=int, default=8)
+    parser.add_argument("--num-boxes", type=int, default=100000)
+    parser.add_argument("--topk", type=int, default=400)
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    print("%-8s %-10s %-8s %-12s %-12s" % ("batch", "#boxes", "dtype", "argsort", "topk"))
+    for dtype in ["float32", "float16", "int32"]:
+        benchmark(args.batch, args.num_boxes, args.topk, dtype, args.repeat)
@@ -111,6 +111,10 @@ set(USE_RANDOM OFF)
 # Whether use NNPack
 set(USE_NNPACK OFF)
 
+# Whether run NNPack on the TVM thread pool instead of linking pthreadpool,
+# so that NNPack and TVM kernels share the same worker threads
+set(USE_NNPACK_TVM_THREADPOOL ON)
+
 # Whether use CuDNN
 set(USE_CUDNN OFF)
 
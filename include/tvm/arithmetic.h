@@ -9,6 +9,7 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <limits>
 #include "expr.h"
 
 namespace tvm {
@@ -154,6 +155,227 @@ struct ModularEntry {
                           const ModularEntry& b);
 };
 
+class Analyzer;
+class ConstIntBound;
+
+/*!
+ * \brief Constant integer up and lower bound(inclusive).
+ *  Useful for value bound analysis.
+ *
+ *  set = [min_value, max_value]
+ */
+class ConstIntBoundNode : public Node {
+ public:
+  /*! \brief The minimum value, kNegInf if unbounded. */
+  int64_t min_value;
+  /*! \brief The maximum value, kPosInf if unbounded. */
+  int64_t max_value;
+
+  void VisitAttrs(tvm::AttrVisitor* v) final {
+    v->Visit("min_value", &min_value);
+    v->Visit("max_value", &max_value);
+  }
+  /*!
+   * \brief Construct a bound.
+   * \param min_value The minimum value.
+   * \param max_value The maximum value.
+   * \return The created bound.
+   */
+  TVM_DLL static ConstIntBound make(int64_t min_value, int64_t max_value);
+
+  /*! \brief Number to represent +inf */
+  static const constexpr int64_t kPosInf = std::numeric_limits<int64_t>::max();
+  /*! \brief Number to represent -inf */
+  static const constexpr int64_t kNegInf = -kPosInf;
+
+  static constexpr const char* _type_key = "arith.ConstIntBound";
+  TVM_DECLARE_NODE_TYPE_INFO(ConstIntBoundNode, Node);
+};
+
+TVM_DEFINE_NODE_REF(ConstIntBound, ConstIntBoundNode);
+
+/*!
+ * \brief Analyzer to get constant integer bound over expression.
+ */
+class ConstIntBoundAnalyzer {
+ public:
+  /*!
+   * \brief analyze the expr
+   * \param expr The expression of interest.
+   * \return the result of the analysis.
+   */
+  TVM_DLL ConstIntBound operator()(const Expr& expr);
+  /*!
+   * \brief Update constant int bound information of var.
+   *
+   * \param var The variable of interest.
+   * \param info The bound information.
+   * \param override Whether do we allow override of existing information.
+   */
+  TVM_DLL void Update(const Var& var,
+                      const ConstIntBound& info,
+                      bool override = false);
+  /*!
+   * \brief Bind variable to a range.
+   *
+   * \param var The variable.
+   * \param range The range we bind to.
+   */
+  TVM_DLL void Bind(const Var& var, const Range& range);
+
+ private:
+  friend class Analyzer;
+  explicit ConstIntBoundAnalyzer(Analyzer* parent);
+  ~ConstIntBoundAnalyzer();
+  class Impl;
+  /*! \brief Internal impl */
+  Impl* impl_;
+};
+
+/*!
+ * \brief Analyzer to get the modular set of an expression.
+ *
+ *  The analysis is done by EvalModular over the recorded variables.
+ */
+class ModularSetAnalyzer {
+ public:
+  /*!
+   * \brief analyze the expr
+   * \param expr The expression of interest.
+   * \return the result of the analysis.
+   */
+  TVM_DLL ModularEntry operator()(const Expr& expr);
+  /*!
+   * \brief Update modular information of var.
+   *
+   * \param var The variable of interest.
+   * \param info The modular information.
+   * \param override Whether do we allow override of existing information.
+   */
+  TVM_DLL void Update(const Var& var,
+                      const ModularEntry& info,
+                      bool override = false);
+
+ private:
+  friend class Analyzer;
+  explicit ModularSetAnalyzer(Analyzer* parent);
+  /*! \brief The parent analyzer */
+  Analyzer* parent_;
+  /*! \brief The modular information of the variables */
+  std::unordered_map<const Variable*, ModularEntry> var_map_;
+};
+
+/*!
+ * \brief Rewrite-rule based simplifier.
+ *
+ *  The rules are declared with the pattern matcher in
+ *  src/arithmetic/pattern_match.h, and use the constant integer
+ *  bound and modular set analysis of the parent analyzer to
+ *  check the side conditions.
+ */
+class RewriteSimplifier {
+ public:
+  /*!
+   * \brief analyze the expr
+   * \param expr The expression of interest.
+   * \return the result of the analysis.
+   */
+  TVM_DLL Expr operator()(const Expr& expr);
+  /*!
+   * \brief Update binding of var to a new expression.
+   *
+   * \param var The variable of interest.
+   * \param new_expr The expression the variable is substituted with.
+   * \param override Whether do we allow override of existing information.
+   */
+  TVM_DLL void Update(const Var& var,
+                      const Expr& new_expr,
+                      bool override = false);
+
+ private:
+  friend class Analyzer;
+  explicit RewriteSimplifier(Analyzer* parent);
+  ~RewriteSimplifier();
+  class Impl;
+  /*! \brief Internal impl */
+  Impl* impl_;
+};
+
+/*!
+ * \brief Analyzer that contains bunch of sub-analyzers.
+ *
+ *  Each sub-analyzer can make use of another sub-analyzer
+ *  by weak reference of this.
+ *
+ *  NOTE for sub-analyzer developers:
+ *  If the analyzer uses memoization, we need to clear the internal
+ *  cache when information about a Var has been overridden.
+ */
+class Analyzer {
+ public:
+  /*! \brief sub-analyzer: const integer bound */
+  ConstIntBoundAnalyzer const_int_bound;
+  /*! \brief sub-analyzer: modular set */
+  ModularSetAnalyzer modular_set;
+  /*! \brief sub-analyzer rewrite simplify */
+  RewriteSimplifier rewrite_simplify;
+  /*! \brief constructor */
+  TVM_DLL Analyzer();
+  Analyzer(const Analyzer&) = delete;
+  Analyzer& operator=(const Analyzer&) = delete;
+  /*!
+   * \brief Notify all the sub-analyzers that var
+   *        is created and binded to expr.
+   *
+   *  Each var can only be binded once.
+   *
+   * \param var The variable.
+   * \param expr The expression we bind to.
+   */
+  TVM_DLL void Bind(const VarExpr& var, const Expr& expr);
+  /*!
+   * \brief Notify all the sub-analyzers that var
+   *        is created and binded to a range.
+   *
+   *  Each var can only be binded once.
+   *
+   * \param var The variable.
+   * \param range The range we bind to.
+   */
+  TVM_DLL void Bind(const VarExpr& var, const Range& range);
+  /*!
+   * \brief Whether can we proof expr >= val.
+   *
+   *  Non-negative proof is very useful in integer analysis
+   *  to lower divisions and mods given difference in trunc and ceil mode.
+   *
+   * \param expr The expression.
+   * \param lower_bound The lower bound.
+   * \return Whether we can proof it.
+   *
+   * \note Analyzer will call into sub-analyzers to get the result.
+   */
+  TVM_DLL bool CanProveGreaterEqual(const Expr& expr, int64_t lower_bound);
+  /*!
+   * \brief Whether can we prove condition.
+   *
+   * \param cond The expression to be proved.
+   * \return The result.
+   *
+   * \note Analyzer will call into sub-analyzers to get the result.
+   */
+  TVM_DLL bool CanProve(const Expr& cond);
+  /*!
+   * \brief Simplify expr.
+   *
+   * \param expr The expression to be simplified.
+   * \return The result.
+   *
+   * \note Analyzer will call into sub-analyzers to get the result.
+   */
+  TVM_DLL Expr Simplify(const Expr& expr);
+};
+
 /*!
  * \brief Base class of all IntSet containers.
  */
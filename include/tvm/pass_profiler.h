@@ -0,0 +1,174 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file tvm/pass_profiler.h
+ * \brief Instrumentation of pass invocations.
+ *
+ *  When enabled, the profiler records the wall time, the number of IR
+ *  nodes before and after and the memory usage of each pass invocation.
+ *  The records can be queried, or exported in the Chrome trace format.
+ */
+#ifndef TVM_PASS_PROFILER_H_
+#define TVM_PASS_PROFILER_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "base.h"
+#include "runtime/packed_func.h"
+
+namespace tvm {
+
+/*! \brief Profile of one pass invocation. */
+struct PassProfileRecord {
+  /*! \brief Name of the pass. */
+  std::string name;
+  /*! \brief Start time in microseconds since the profiler was created. */
+  int64_t start_us{0};
+  /*! \brief Wall time of the pass in microseconds. */
+  int64_t duration_us{0};
+  /*! \brief Number of IR nodes reachable from the input. */
+  int64_t nodes_before{0};
+  /*! \brief Number of IR nodes reachable from the output. */
+  int64_t nodes_after{0};
+  /*! \brief Resident memory of the process before the pass. */
+  int64_t rss_before_bytes{0};
+  /*! \brief Resident memory of the process after the pass. */
+  int64_t rss_after_bytes{0};
+  /*! \brief Peak resident memory of the process at the end of the pass. */
+  int64_t peak_rss_bytes{0};
+  /*! \brief Nesting depth, passes invoked by other passes have depth > 0. */
+  int depth{0};
+  /*! \brief Index of the thread that ran the pass. */
+  int thread_index{0};
+};
+
+/*!
+ * \brief Global recorder of pass invocations.
+ *
+ *  Passes are bracketed with Begin/End, usually through
+ *  PassProfileScope or ProfilePass. Nothing is recorded
+ *  while the profiler is disabled.
+ */
+class PassProfiler {
+ public:
+  /*! \return Whether the profiler is recording. */
+  bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  /*!
+   * \brief Enable or disable the recording.
+   * \param enabled Whether to record.
+   */
+  TVM_DLL void SetEnabled(bool enabled);
+  /*!
+   * \brief Mark the beginning of a pass on the current thread.
+   * \param name The name of the pass.
+   * \param input The input IR of the pass, can be undefined.
+   */
+  TVM_DLL void Begin(const std::string& name, const NodeRef& input);
+  /*!
+   * \brief Mark the end of the innermost pass on the current thread.
+   * \param output The output IR of the pass, can be undefined.
+   */
+  TVM_DLL void End(const NodeRef& output);
+  /*! \return The records of the finished passes. */
+  TVM_DLL std::vector<PassProfileRecord> GetRecords();
+  /*! \brief Remove all records. */
+  TVM_DLL void Clear();
+  /*! \return The records as a JSON array. */
+  TVM_DLL std::string ToJSON();
+  /*! \return The records in the Chrome trace event format. */
+  TVM_DLL std::string ToChromeTrace();
+  /*! \return The global pass profiler. */
+  TVM_DLL static PassProfiler* Global();
+  /*!
+   * \brief Count the nodes reachable from an IR node.
+   * \param node The root node.
+   * \return The number of distinct nodes.
+   */
+  TVM_DLL static int64_t CountNodes(const NodeRef& node);
+
+ private:
+  PassProfiler();
+  /*! \brief Whether the profiler is recording. */
+  std::atomic<bool> enabled_{false};
+  /*! \brief Lock of the records. */
+  std::mutex mutex_;
+  /*! \brief The finished records. */
+  std::vector<PassProfileRecord> records_;
+};
+
+/*!
+ * \brief RAII scope that records one pass invocation.
+ *
+ * \code
+ *   PassProfileScope scope("StorageRewrite", stmt);
+ *   stmt = ir::StorageRewrite(stmt);
+ *   scope.set_output(stmt);
+ * \endcode
+ */
+class PassProfileScope {
+ public:
+  /*!
+   * \brief Begin the pass if the profiler is enabled.
+   * \param name The name of the pass.
+   * \param input The input IR of the pass.
+   */
+  PassProfileScope(const std::string& name, const NodeRef& input)
+      : active_(PassProfiler::Global()->enabled()) {
+    if (active_) PassProfiler::Global()->Begin(name, input);
+  }
+  ~PassProfileScope() {
+    if (active_) PassProfiler::Global()->End(output_);
+  }
+  /*!
+   * \brief Set the output IR of the pass.
+   * \param output The output IR.
+   */
+  void set_output(const NodeRef& output) {
+    if (active_) output_ = output;
+  }
+
+ private:
+  /*! \brief Whether the pass is recorded. */
+  bool active_;
+  /*! \brief The output of the pass. */
+  NodeRef output_;
+};
+
+/*!
+ * \brief Run a pass under the profiler.
+ * \param name The name of the pass.
+ * \param input The input IR of the pass.
+ * \param fpass The function that runs the pass.
+ * \return The result of fpass.
+ */
+template<typename FPass>
+inline auto ProfilePass(const std::string& name,
+                        const NodeRef& input,
+                        FPass fpass) -> decltype(fpass()) {
+  if (!PassProfiler::Global()->enabled()) return fpass();
+  PassProfileScope scope(name, input);
+  auto ret = fpass();
+  scope.set_output(ret);
+  return ret;
+}
+
+/*!
+ * \brief Get the IR node held by a packed function argument or return value.
+ *  Returns an undefined node unless the profiler is enabled.
+ * \param value The TVMArgValue or TVMRetValue.
+ * \return The node.
+ */
+template<typename TValue>
+inline NodeRef ProfiledNode(const TValue& value) {
+  if (!PassProfiler::Global()->enabled() ||
+      value.type_code() != kNodeHandle) {
+    return NodeRef();
+  }
+  return value.template AsNodeRef<NodeRef>();
+}
+
+}  // namespace tvm
+#endif  // TVM_PASS_PROFILER_H_
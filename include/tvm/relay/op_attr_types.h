@@ -137,6 +137,17 @@ using FForwardRewrite = runtime::TypedPackedFunc<
 using FPrimalGradient = runtime::TypedPackedFunc<tvm::Array<Expr>(const Expr& orig_call,
                                                                   const Expr& output_grad)>;
 
+/*!
+ * \brief The number of MACs (Multiply-Accumulate) of a call.
+ *  Only valid after type inference.
+ *
+ * \param call_node The call node.
+ *
+ * \return The number of MACs.
+ */
+using FMacCount = runtime::TypedPackedFunc<
+  int64_t(const Call& call_node)>;
+
 }  // namespace relay
 }  // namespace tvm
 #endif  // TVM_RELAY_OP_ATTR_TYPES_H_
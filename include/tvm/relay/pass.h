@@ -9,6 +9,7 @@
 #include <tvm/relay/expr.h>
 #include <tvm/relay/module.h>
 #include <tvm/relay/op_attr_types.h>
+#include <ostream>
 #include <string>
 
 namespace tvm {
@@ -226,6 +227,15 @@ TVM_DLL Expr DeadCodeElimination(const Expr& e);
  */
 TVM_DLL Expr FoldConstant(const Expr& expr);
 
+/*!
+ * \brief Replace the calls, tuples and tuple projections which are equal to
+ *  an earlier one with the earlier one.
+ *  Calls to stateful operators are never combined.
+ * \param expr The expression to be optimized.
+ * \return The optimized expression.
+ */
+TVM_DLL Expr EliminateCommonSubexpr(const Expr& expr);
+
 /*!
  * \brief Fuse operations into expr into seperate functions.
  * \param expr The expression.
@@ -234,6 +244,22 @@ TVM_DLL Expr FoldConstant(const Expr& expr);
  */
 TVM_DLL Expr FuseOps(const Expr& expr, int fuse_opt_level);
 
+/*!
+ * \brief Fuse operations into expr into seperate functions,
+ *  only commit the fusions which are estimated to be profitable.
+ * \param expr The expression.
+ * \param fuse_opt_level Optimization level.
+ * \param fcost The cost function, called with the source node, its post-dominator,
+ *  the nodes to be fused into the post-dominator and the default gain estimate
+ *  (bytes of memory traffic saved). It returns the gain of the fusion, and
+ *  the fusion is committed if the gain is positive.
+ *  If it is null, the default gain estimate is used.
+ * \param log If not nullptr, the accepted and rejected fusions are dumped into it.
+ * \return The optimized expression.
+ */
+TVM_DLL Expr FuseOps(const Expr& expr, int fuse_opt_level,
+                     runtime::PackedFunc fcost, std::ostream* log);
+
 /*!
  * \brief Apply rewrite rules to rewrite the expr in post DFS order.
  * \param expr The expression.
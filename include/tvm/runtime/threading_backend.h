@@ -77,6 +77,15 @@ void Yield();
  */
 int MaxConcurrency();
 
+/*!
+ * \brief Restrict the calling thread, and the threads it creates
+ *  afterwards, to run on the given cores.
+ *  The thread pool only binds its workers to these cores after that.
+ * \param cores The ids of the cores.
+ * \return Whether the affinity is set, false if not supported.
+ */
+bool SetCPUAffinity(const std::vector<unsigned int>& cores);
+
 
 }  // namespace threading
 }  // namespace runtime
@@ -269,8 +269,23 @@ class CompileEngine {
     gf->func_name = GetUniqeName(readable_name);
     gf->inputs = inputs;
     gf->outputs = outputs;
+    // reuse the lowered function from the persistent kernel cache.
+    static const PackedFunc& fcache_key = GetPackedFunc("codegen._KernelCacheKey");
+    static const PackedFunc& fcache_lookup = GetPackedFunc("codegen._KernelCacheLookup");
+    static const PackedFunc& fcache_insert = GetPackedFunc("codegen._KernelCacheInsert");
+    std::string cache_key = fcache_key(sch, all_args, target);
+    if (!cache_key.empty()) {
+      Array<tvm::LoweredFunc> cached = fcache_lookup(cache_key, gf->func_name);
+      if (cached.size() != 0) {
+        gf->funcs = cached;
+        return GraphFunc(gf);
+      }
+    }
     static const PackedFunc& flower = GetPackedFunc("nnvm.compiler.lower");
     gf->funcs = flower(sch, all_args, gf->func_name, graph);
+    if (!cache_key.empty()) {
+      fcache_insert(cache_key, gf->func_name, gf->funcs);
+    }
     return GraphFunc(gf);
   }
 
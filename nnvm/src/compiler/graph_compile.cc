@@ -37,6 +37,7 @@ nnvm::Graph DecorateMemoryPlan(
   const IndexedGraph& idx = g.indexed_graph();
   StorageVector storage_vec = g.MoveCopyAttr<StorageVector>("storage_id");
   g.attrs.erase("storage_allocated_bytes");
+  g.attrs.erase("storage_allocated_bytes_sequential");
   g.attrs.erase("storage_inplace_index");
   size_t num_not_allocated = g.MoveCopyAttr<size_t>(
       "storage_num_not_allocated");
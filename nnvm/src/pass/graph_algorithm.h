@@ -106,6 +106,51 @@ inline uint32_t ColorNodeGroup(
   return cindex + 1;
 }
 
+/*!
+ * \brief Compute the ancestor set of each node in the graph.
+ *  A node is an ancestor of another node if there is a path of data
+ *  or control dependency from it to the other node.
+ *
+ * \param graph the original indexed graph.
+ * \param ancestors the ancestor bitset of each of the node.
+ */
+inline void ComputeAncestors(
+    const IndexedGraph &graph,
+    std::vector<std::vector<uint64_t> > *ancestors) {
+  const uint32_t num_nodes = static_cast<uint32_t>(graph.num_nodes());
+  const size_t num_words = (num_nodes + 63) / 64;
+  ancestors->clear();
+  ancestors->resize(num_nodes, std::vector<uint64_t>(num_words, 0));
+  auto merge = [ancestors](uint32_t nid, uint32_t prev) {
+    std::vector<uint64_t>& dst = (*ancestors)[nid];
+    const std::vector<uint64_t>& src = (*ancestors)[prev];
+    for (size_t i = 0; i < dst.size(); ++i) dst[i] |= src[i];
+    dst[prev / 64] |= static_cast<uint64_t>(1) << (prev % 64);
+  };
+  // node ids are in topo order
+  for (uint32_t nid = 0; nid < num_nodes; ++nid) {
+    for (const auto& e : graph[nid].inputs) {
+      merge(nid, e.node_id);
+    }
+    for (uint32_t prev : graph[nid].control_deps) {
+      merge(nid, prev);
+    }
+  }
+}
+
+/*!
+ * \brief Check whether a node is an ancestor of another node.
+ * \param ancestors the ancestor bitsets computed by ComputeAncestors.
+ * \param prev the candidate ancestor.
+ * \param nid the node.
+ * \return whether prev is an ancestor of nid.
+ */
+inline bool IsAncestor(
+    const std::vector<std::vector<uint64_t> >& ancestors,
+    uint32_t prev, uint32_t nid) {
+  return (ancestors[nid][prev / 64] >> (prev % 64)) & 1;
+}
+
 }  // namespace pass
 }  // namespace nnvm
 
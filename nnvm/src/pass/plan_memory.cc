@@ -56,20 +56,20 @@ class GraphAllocator {
   StorageID Request(int dev_id, int dtype, TShape shape, uint32_t node_id) {
     if (shape.ndim() == 0) return kBadStorageID;
     // search memory block in [size / match_range_, size * match_range_)
-    // TODO(tqchen) add size of the dtype, assume 4 bytes for now
-    size_t size = shape.Size() * 4;
-    if (match_range_ == 0) return this->Alloc(dev_id, size);
+    // unknown dtype is assumed to take 4 bytes.
+    size_t dtype_size = dtype == -1 ? 4 : static_cast<size_t>(GetDTypeSize(dtype));
+    size_t size = shape.Size() * dtype_size;
+    if (match_range_ == 0) return this->Alloc(dev_id, size, node_id);
     auto begin = free_.lower_bound(size / match_range_);
     auto mid = free_.lower_bound(size);
     auto end = free_.upper_bound(size * match_range_);
     // search for memory blocks larger than requested
     for (auto it = mid; it != end; ++it) {
       StorageEntry *e = it->second;
-      if (e->device_id != dev_id) continue;
-      if (node_color_.size() != 0 &&
-          node_color_[e->released_by_node] != node_color_[node_id]) continue;
+      if (!CanReuse(*e, dev_id, node_id)) continue;
       // Use exect matching strategy
       e->max_bytes = std::max(size, e->max_bytes);
+      e->users.assign(1, node_id);
       // find a exact match, erase from map and return
       free_.erase(it);
       return e->id;
@@ -78,17 +78,21 @@ class GraphAllocator {
     for (auto it = mid; it != begin;) {
       --it;
       StorageEntry *e = it->second;
-      if (e->device_id != dev_id) continue;
-      if (node_color_.size() != 0 &&
-          node_color_[e->released_by_node] != node_color_[node_id]) continue;
+      if (!CanReuse(*e, dev_id, node_id)) continue;
       // Use exect matching strategy
       e->max_bytes = std::max(size, e->max_bytes);
+      e->users.assign(1, node_id);
       // erase from map and return
       free_.erase(it);
       return e->id;
     }
     // cannot find anything return a new one.
-    return this->Alloc(dev_id, size);
+    return this->Alloc(dev_id, size, node_id);
+  }
+  // record that a node reads or writes a storage.
+  void Touch(StorageID id, uint32_t node_id) {
+    if (id < 0) return;
+    data_[id]->users.push_back(node_id);
   }
   // release a memory space.
   void Release(StorageID id, uint32_t node_id) {
@@ -109,15 +113,20 @@ class GraphAllocator {
   }
 
   // constructor
-  explicit GraphAllocator(const IndexedGraph* idx, const size_t match_range) : idx_(idx) {
-    this->Init(match_range, dmlc::GetEnv("NNVM_EXEC_NUM_TEMP", 1));
+  GraphAllocator(const IndexedGraph* idx,
+                 const size_t match_range,
+                 const bool parallel_exec) : idx_(idx) {
+    this->Init(match_range, dmlc::GetEnv("NNVM_EXEC_NUM_TEMP", 1), parallel_exec);
   }
 
  private:
   // initialize the graph allocator
-  void Init(const size_t match_range, const uint32_t num_match_color) {
+  void Init(const size_t match_range,
+            const uint32_t num_match_color,
+            const bool parallel_exec) {
     match_range_ = match_range;
     num_match_color_ = num_match_color;
+    parallel_exec_ = parallel_exec;
     if (num_match_color_ > 1) {
       std::vector<uint32_t> importance(idx_->num_nodes(), 0);
       for (uint32_t nid = 0; nid < idx_->num_nodes(); ++nid) {
@@ -127,14 +136,34 @@ class GraphAllocator {
       num_match_color_ = pass::ColorNodeGroup(
           *idx_, importance, num_match_color_, &node_color_);
     }
+    if (parallel_exec_) {
+      pass::ComputeAncestors(*idx_, &ancestors_);
+    }
+  }
+  // internal storage entry
+  struct StorageEntry;
+  // whether node_id can take over the storage e.
+  bool CanReuse(const StorageEntry& e, int dev_id, uint32_t node_id) const {
+    if (e.device_id != dev_id) return false;
+    if (node_color_.size() != 0 &&
+        node_color_[e.released_by_node] != node_color_[node_id]) return false;
+    if (parallel_exec_) {
+      // Every previous user of the storage must have finished before
+      // node_id starts, which only holds when it is an ancestor of node_id.
+      for (uint32_t user : e.users) {
+        if (!pass::IsAncestor(ancestors_, user, node_id)) return false;
+      }
+    }
+    return true;
   }
 
-  StorageID Alloc(int dev_id, size_t size) {
+  StorageID Alloc(int dev_id, size_t size, uint32_t node_id) {
     StorageID id = static_cast<StorageID>(data_.size());
     std::unique_ptr<StorageEntry> ptr(new StorageEntry());
     ptr->id = id;
     ptr->device_id = dev_id;
     ptr->max_bytes = size;
+    ptr->users.assign(1, node_id);
     data_.emplace_back(std::move(ptr));
     return id;
   }
@@ -148,13 +177,18 @@ class GraphAllocator {
     size_t max_bytes{0};
     // node index that released it last time
     uint32_t released_by_node{0};
+    // nodes that used the storage since it was last requested
+    std::vector<uint32_t> users;
   };
   // scale used for rough match
   size_t match_range_;
   // whether use color based match algorithm
   uint32_t num_match_color_{1};
-  // the size of each dtype
-  std::vector<size_t> dtype_size_dict_;
+  // whether independent nodes may run at the same time,
+  // then storage is only reused along dependencies
+  bool parallel_exec_{false};
+  // ancestor set of each node, used when parallel_exec_ is set
+  std::vector<std::vector<uint64_t> > ancestors_;
   // free list of storage entry
   std::multimap<size_t, StorageEntry*> free_;
   // all the storage resources available
@@ -233,6 +267,7 @@ size_t AllocMemory(const Graph& ret, const IndexedGraph& idx,
           // inplace optimization
           taken[kv.first] = true;
           storage[eid_out] = sid_in;
+          allocator->Touch(sid_in, nid);
           // Reuse storage for output and add ref count of output
           // to storage. This will get substracted later in free
           // input section.
@@ -278,6 +313,7 @@ size_t AllocMemory(const Graph& ret, const IndexedGraph& idx,
       auto sid = storage[eid];
       // storage_ref_count == 0 means it is taken by inplace op
       if (sid < 0) continue;
+      allocator->Touch(sid, nid);
       // if we decrease it to zero, we are ready to relase
       --storage_ref_count[sid];
       if (storage_ref_count[sid] == 0) {
@@ -346,36 +382,55 @@ Graph PlanMemory(Graph ret) {
     storage.resize(idx.num_node_entries(), -1);
   }
 
-  // Search the best NNVM_EXEC_MATCH_RANGE parameter. This is turned off by default
-  size_t min_allocated_bytes = -1;
-  size_t max_match_range = dmlc::GetEnv("NNVM_EXEC_MATCH_RANGE", 16);
-  size_t min_match_range =
-         dmlc::GetEnv("NNVM_AUTO_SEARCH_MATCH_RANGE", false) ? 1 : max_match_range;
-  for (size_t match_range = min_match_range; match_range <= max_match_range; match_range *= 2) {
-    // Make a copy of related fields
-    StorageVector storage_vec(storage);
-    std::vector<int> storage_inplace_index(idx.num_node_entries(), -1);
+  // Whether independent nodes may run at the same time, then storage is
+  // never shared between nodes that are not ordered by a dependency.
+  // Any executor running two nodes at once needs this, whatever its
+  // number of workers, so it is a switch rather than a level.
+  bool parallel_exec = dmlc::GetEnv("NNVM_EXEC_PARALLEL", false);
+  if (ret.attrs.count("parallel_exec") != 0) {
+    parallel_exec = ret.MoveCopyAttr<int>("parallel_exec") != 0;
+  }
+  // Plan the sequential policy first so both totals can be reported,
+  // the plan of the last policy is kept.
+  std::vector<bool> policies = {false};
+  if (parallel_exec) policies.push_back(true);
 
-    // the allocator
-    GraphAllocator allocator(&idx, match_range);
+  for (bool parallel : policies) {
+    // Search the best NNVM_EXEC_MATCH_RANGE parameter. This is turned off by default
+    size_t min_allocated_bytes = -1;
+    size_t max_match_range = dmlc::GetEnv("NNVM_EXEC_MATCH_RANGE", 16);
+    size_t min_match_range =
+           dmlc::GetEnv("NNVM_AUTO_SEARCH_MATCH_RANGE", false) ? 1 : max_match_range;
+    for (size_t match_range = min_match_range; match_range <= max_match_range; match_range *= 2) {
+      // Make a copy of related fields
+      StorageVector storage_vec(storage);
+      std::vector<int> storage_inplace_index(idx.num_node_entries(), -1);
 
-    // number of entries that are not statically allocated.
-    size_t storage_num_not_allocated =
-      AllocMemory(ret, idx, node_range, &storage_vec, &storage_inplace_index,
-                  ref_count, &allocator);
-    size_t storage_allocated_bytes = allocator.TotalAllocBytes();
+      // the allocator
+      GraphAllocator allocator(&idx, match_range, parallel);
 
-    // Choose the plan which leads to minimal memory usage
-    if (min_allocated_bytes > storage_allocated_bytes) {
-      ret.attrs["storage_id"] = std::make_shared<any>(std::move(storage_vec));
-      ret.attrs["storage_inplace_index"] = std::make_shared<any>(std::move(storage_inplace_index));
-      ret.attrs["storage_allocated_bytes"] = std::make_shared<any>(storage_allocated_bytes);
-      ret.attrs["storage_num_not_allocated"] = std::make_shared<any>(storage_num_not_allocated);
-      min_allocated_bytes = storage_allocated_bytes;
-    }
+      // number of entries that are not statically allocated.
+      size_t storage_num_not_allocated =
+        AllocMemory(ret, idx, node_range, &storage_vec, &storage_inplace_index,
+                    ref_count, &allocator);
+      size_t storage_allocated_bytes = allocator.TotalAllocBytes();
+
+      // Choose the plan which leads to minimal memory usage
+      if (min_allocated_bytes > storage_allocated_bytes) {
+        ret.attrs["storage_id"] = std::make_shared<any>(std::move(storage_vec));
+        ret.attrs["storage_inplace_index"] = std::make_shared<any>(std::move(storage_inplace_index));
+        ret.attrs["storage_allocated_bytes"] = std::make_shared<any>(storage_allocated_bytes);
+        ret.attrs["storage_num_not_allocated"] = std::make_shared<any>(storage_num_not_allocated);
+        min_allocated_bytes = storage_allocated_bytes;
+      }
 
-    if (max_match_range == 0) {
-      break;
+      if (max_match_range == 0) {
+        break;
+      }
+    }
+    if (!parallel) {
+      ret.attrs["storage_allocated_bytes_sequential"] =
+          std::make_shared<any>(min_allocated_bytes);
     }
   }
   return ret;
@@ -388,7 +443,9 @@ NNVM_REGISTER_PASS(PlanMemory)
 .depend_graph_attr("dtype")
 .depend_graph_attr("shape")
 .provide_graph_attr("storage_id")
-.provide_graph_attr("storage_inplace_index");
+.provide_graph_attr("storage_inplace_index")
+.provide_graph_attr("storage_allocated_bytes")
+.provide_graph_attr("storage_allocated_bytes_sequential");
 
 }  // namespace
 }  // namespace pass
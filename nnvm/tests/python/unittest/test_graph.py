@@ -103,6 +103,47 @@ def test_plan_memory():
     assert (storage_id[jnode_row_ptr[nindex["add2"]]] ==
             storage_id[jnode_row_ptr[nindex["reshapek"]]])
 
+def test_plan_memory_dtype():
+    x = sym.Variable('x', shape=(4, 2))
+    y = sym.cast(x, dtype="int8")
+    y = sym.sum(y, axis=1)
+    g = graph.create(y)
+    g._set_json_attr("shape_attr_key", "shape")
+    g = g.apply(["InferShape", "InferType", "PlanMemory"])
+    # 8 bytes for the cast and 4 bytes for the sum.
+    assert g.json_attr('storage_allocated_bytes') == 12
+
+def test_plan_memory_parallel():
+    x = sym.Variable('x', shape=(4, 2))
+    a1 = sym.exp(x, name="a1")
+    a2 = sym.sum(a1, axis=1, name="a2")
+    b1 = sym.sigmoid(x, name="b1")
+    b2 = sym.sum(b1, axis=1, name="b2")
+    y = sym.elemwise_add(a2, b2)
+
+    def plan(parallel_exec):
+        g = graph.create(y)
+        g._set_json_attr("shape_attr_key", "shape")
+        g._set_json_attr("parallel_exec", parallel_exec, "int")
+        g = g.apply(["InferShape", "InferType", "PlanMemory"])
+        jgraph = json.loads(g.apply('SaveJSON').json_attr('json'))
+        nindex = {n['name']: i for i, n in enumerate(jgraph['nodes'])}
+        row_ptr = jgraph['node_row_ptr']
+        storage_id = g.json_attr('storage_id')
+        sid = lambda name: storage_id[row_ptr[nindex[name]]]
+        return g, sid
+
+    # a1 is dead when b1 is computed sequentially.
+    g, sid = plan(0)
+    assert sid("a1") == sid("b1")
+    seq_bytes = g.json_attr('storage_allocated_bytes')
+    assert g.json_attr('storage_allocated_bytes_sequential') == seq_bytes
+    # the two branches can run at the same time.
+    g, sid = plan(1)
+    assert sid("a1") != sid("b1")
+    assert g.json_attr('storage_allocated_bytes_sequential') == seq_bytes
+    assert g.json_attr('storage_allocated_bytes') > seq_bytes
+
 def test_print_graph_ir():
     x = sym.Variable("x", shape=(1, 1, 10, 20))
     y = sym.conv2d(x + 1, name="y", channels=10, kernel_size=(3,3))
@@ -140,5 +181,7 @@ if __name__ == "__main__":
     test_infer_shape_known_partial()
     test_infer_type()
     test_plan_memory()
+    test_plan_memory_dtype()
+    test_plan_memory_parallel()
     test_list_args()
     test_gradient()
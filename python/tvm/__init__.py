@@ -19,6 +19,7 @@ from . import target
 from . import generic
 from . import hybrid
 from . import testing
+from . import pass_profiler
 
 from . import ndarray as nd
 from .ndarray import context, cpu, gpu, opencl, cl, vulkan, metal, mtl
@@ -188,6 +188,14 @@ class FunctionBase(object):
         return RETURN_SWITCH[ret_tcode.value](ret_val)
 
 
+def call_release_gil(func, *args):
+    """Call func with the GIL released until it returns.
+
+    ctypes already releases the GIL during every call.
+    """
+    return func(*args)
+
+
 def __init_handle_by_constructor__(fconstructor, args):
     """Initialize handle by constructor"""
     temp_args = []
@@ -7,7 +7,7 @@ from ..node_generic import convert_to_node, NodeGeneric
 from ..runtime_ctypes import TVMType, TVMContext, TVMByteArray
 
 
-cdef void tvm_callback_finalize(void* fhandle):
+cdef void tvm_callback_finalize(void* fhandle) with gil:
     local_pyfunc = <object>(fhandle)
     Py_DECREF(local_pyfunc)
 
@@ -233,6 +233,28 @@ cdef inline int FuncCall(void* chandle,
     return 0
 
 
+cdef inline int FuncCallReleaseGIL(void* chandle,
+                                   tuple args,
+                                   TVMValue* ret_val,
+                                   int* ret_tcode) except -1:
+    """Same as FuncCall, but the GIL is released during TVMFuncCall"""
+    cdef int nargs
+    cdef int c_api_ret_code
+    cdef vector[TVMValue] values
+    cdef vector[int] tcodes
+    nargs = len(args)
+    values.resize(max(nargs, 1))
+    tcodes.resize(max(nargs, 1))
+    temp_args = []
+    for i in range(nargs):
+        make_arg(args[i], &values[i], &tcodes[i], temp_args)
+    with nogil:
+        c_api_ret_code = TVMFuncCall(chandle, &values[0], &tcodes[0],
+                                     nargs, ret_val, ret_tcode)
+    CALL(c_api_ret_code)
+    return 0
+
+
 cdef inline int ConstructorCall(void* constructor_handle,
                                 int type_code,
                                 tuple args,
@@ -286,6 +308,20 @@ cdef class FunctionBase:
         FuncCall(self.chandle, args, &ret_val, &ret_tcode)
         return make_ret(ret_val, ret_tcode)
 
+
+def call_release_gil(func, *args):
+    """Call func with the GIL released until it returns.
+
+    Only for functions that do not touch python objects
+    other than through callbacks, which acquire the GIL again.
+    """
+    cdef TVMValue ret_val
+    cdef int ret_tcode
+    if not isinstance(func, FunctionBase):
+        return func(*args)
+    FuncCallReleaseGIL((<FunctionBase>func).chandle, args, &ret_val, &ret_tcode)
+    return make_ret(ret_val, ret_tcode)
+
 _CLASS_FUNCTION = None
 _CLASS_MODULE = None
 
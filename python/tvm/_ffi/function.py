@@ -15,16 +15,16 @@ try:
     if sys.version_info >= (3, 0):
         from ._cy3.core import _set_class_function, _set_class_module
         from ._cy3.core import FunctionBase as _FunctionBase
-        from ._cy3.core import convert_to_tvm_func
+        from ._cy3.core import convert_to_tvm_func, call_release_gil
     else:
         from ._cy2.core import _set_class_function, _set_class_module
         from ._cy2.core import FunctionBase as _FunctionBase
-        from ._cy2.core import convert_to_tvm_func
+        from ._cy2.core import convert_to_tvm_func, call_release_gil
 except IMPORT_EXCEPT:
     # pylint: disable=wrong-import-position
     from ._ctypes.function import _set_class_function, _set_class_module
     from ._ctypes.function import FunctionBase as _FunctionBase
-    from ._ctypes.function import convert_to_tvm_func
+    from ._ctypes.function import convert_to_tvm_func, call_release_gil
 
 FunctionHandle = ctypes.c_void_p
 
@@ -38,4 +38,133 @@ class ModularSet(IntSet):
     """Represent range of (coeff * x + base) for x in Z """
 
 
+@register_node("arith.ConstIntBound")
+class ConstIntBound(NodeBase):
+    """Represent constant integer bound
+
+    Parameters
+    ----------
+    min_value : int
+        The minimum value of the bound.
+
+    max_value : int
+        The maximum value of the bound.
+    """
+    POS_INF = (1 << 63) - 1
+    NEG_INF = -POS_INF
+
+    def __init__(self, min_value, max_value):
+        self.__init_handle_by_constructor__(
+            _make_ConstIntBound, min_value, max_value)
+
+
+class Analyzer:
+    """Integer arithmetic analyzer
+
+    This is a stateful analyzer class that can
+    be used to perform various symbolic integer analysis.
+    """
+    def __init__(self):
+        _mod = _CreateAnalyzer()
+        self._const_int_bound = _mod("const_int_bound")
+        self._const_int_bound_update = _mod("const_int_bound_update")
+        self._bind = _mod("bind")
+        self._modular_set = _mod("modular_set")
+        self._rewrite_simplify = _mod("rewrite_simplify")
+        self._can_prove = _mod("can_prove")
+
+    def const_int_bound(self, expr):
+        """Find constant integer bound for expr.
+
+        Parameters
+        ----------
+        expr : tvm.Expr
+            The expression.
+
+        Returns
+        -------
+        bound : ConstIntBound
+            The result bound
+        """
+        return self._const_int_bound(expr)
+
+    def modular_set(self, expr):
+        """Find a modular set that expr belongs to.
+
+        Parameters
+        ----------
+        expr : tvm.Expr
+            The expression.
+
+        Returns
+        -------
+        result : ModularSet
+            The result.
+        """
+        return self._modular_set(expr)
+
+    def rewrite_simplify(self, expr):
+        """Simplify expression via rewriting rules.
+
+        Parameters
+        ----------
+        expr : tvm.Expr
+            The expression.
+
+        Returns
+        -------
+        result : Expr
+            The result.
+        """
+        return self._rewrite_simplify(expr)
+
+    def can_prove(self, cond):
+        """Check whether cond can be proven to be true.
+
+        Parameters
+        ----------
+        cond : tvm.Expr
+            The boolean condition.
+
+        Returns
+        -------
+        result : bool
+            Whether the condition is proven to be true.
+        """
+        return bool(self._can_prove(cond))
+
+    def bind(self, var, expr):
+        """Bind a variable to the expression.
+
+        Parameters
+        ----------
+        var : tvm.Var
+            The variable.
+
+        expr : tvm.Expr or tvm.Range
+            The expression or the range to bind to.
+        """
+        return self._bind(var, expr)
+
+    def update(self, var, info, override=False):
+        """Update infomation about var
+
+        Parameters
+        ----------
+        var : tvm.Var
+            The variable.
+
+        info : tvm.NodeBase
+            Related information.
+
+        override : bool
+            Whether allow override.
+        """
+        if isinstance(info, ConstIntBound):
+            self._const_int_bound_update(var, info, override)
+        else:
+            raise TypeError(
+                "Do not know how to handle type {}".format(type(info)))
+
+
 _init_api("tvm.arith")
@@ -14,6 +14,7 @@ import struct
 import numpy as np
 
 from tvm import schedule, ir_pass, build_module, get_global_func, target as _target
+from tvm._ffi.function import call_release_gil
 
 def ana_lower(sch, args,
               binds=None,
@@ -36,11 +37,16 @@ try:
         "autotvm.feature.GetCurveSampleFeatureFlatten")
     _get_itervar_feature = get_global_func("autotvm.feature.GetItervarFeature")
     _get_itervar_feature_flatten = get_global_func("autotvm.feature.GetItervarFeatureFlatten")
+    _get_itervar_feature_flatten_batch = get_global_func(
+        "autotvm.feature.GetItervarFeatureFlattenBatch")
+    _get_buffer_curve_sample_flatten_batch = get_global_func(
+        "autotvm.feature.GetCurveSampleFeatureFlattenBatch")
 except ValueError as e:
     def raise_error(*args, **kwargs):  # pylint: disable=unused-argument
         raise RuntimeError("Cannot load autotvm c++ API")
     _get_buffer_curve_sample_flatten = _get_itervar_feature = _get_itervar_feature_flatten = \
         raise_error
+    _get_itervar_feature_flatten_batch = _get_buffer_curve_sample_flatten_batch = raise_error
 
 def get_itervar_feature(sch, args, take_log=False):
     """get features of iter vars
@@ -111,6 +117,34 @@ def get_itervar_feature_flatten(sch, args, take_log=True):
     feas = struct.unpack('%df' % (len(feas)//4), feas)
     return feas
 
+def get_itervar_feature_flatten_batch(sch_args, take_log=True, num_threads=0):
+    """get flatten features of iter vars for a batch of schedules.
+    Lowering and feature extraction run on a pool of threads in C++,
+    the GIL is released during the call.
+
+    Parameters
+    ----------
+    sch_args: list of (tvm.schedule.Schedule, Array of tvm.tensor.Tensor)
+        the schedules and their buffer args for lower
+    take_log: bool
+        whether take log of numerical statics
+    num_threads: int
+        number of threads, 0 means the number of cores
+
+    Returns
+    -------
+    flatten_feature: np.ndarray
+        two-dimensional matrix, one row for each schedule.
+        shorter rows are padded with zeros.
+    """
+    schs = [x[0] for x in sch_args]
+    args = [list(x[1]) for x in sch_args]
+    if not schs:
+        return np.empty((0, 0), dtype=np.float32)
+    feas = call_release_gil(_get_itervar_feature_flatten_batch,
+                            schs, args, take_log, num_threads)
+    return feas.asnumpy()
+
 def get_flatten_name(fea):
     """ Get names of feature after flatten.
 
@@ -179,3 +213,33 @@ def get_buffer_curve_sample_flatten(sch, args, sample_n=30):
     feas = _get_buffer_curve_sample_flatten(stmt, sample_n, False)
     feas = struct.unpack('%df' % (len(feas)//4), feas)
     return feas
+
+
+def get_buffer_curve_sample_flatten_batch(sch_args, sample_n=30, num_threads=0):
+    """
+    Get flatten curve sample feature (relation feature) for a batch of schedules.
+    Lowering and feature extraction run on a pool of threads in C++,
+    the GIL is released during the call.
+
+    Parameters
+    ----------
+    sch_args: list of (tvm.schedule.Schedule, Array of tvm.tensor.Tensor)
+        the schedules and their buffer args for lower
+    sample_n: int
+        number of sample points along one dimension
+    num_threads: int
+        number of threads, 0 means the number of cores
+
+    Returns
+    -------
+    flatten_feature: np.ndarray
+        two-dimensional matrix, one row for each schedule.
+        shorter rows are padded with zeros.
+    """
+    schs = [x[0] for x in sch_args]
+    args = [list(x[1]) for x in sch_args]
+    if not schs:
+        return np.empty((0, 0), dtype=np.float32)
+    feas = call_release_gil(_get_buffer_curve_sample_flatten_batch,
+                            schs, args, sample_n, num_threads)
+    return feas.asnumpy()
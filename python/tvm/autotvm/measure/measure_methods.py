@@ -81,13 +81,18 @@ class LocalBuilder(Builder):
         shutil.rmtree(self.tmp_dir)
         self.tmp_dir = tempfile.mkdtemp()
 
+        build_kwargs = dict(self.build_kwargs)
+        cpu_affinity = build_kwargs.pop('cpu_affinity', None)
+
         for i in range(0, len(measure_inputs), self.n_parallel):
             futures = []
             for inp in measure_inputs[i:i + self.n_parallel]:
-                ret = self.executor.submit(self.build_func,
+                ret = self.executor.submit(_call_with_affinity,
+                                           cpu_affinity,
+                                           self.build_func,
                                            inp,
                                            self.tmp_dir,
-                                           **self.build_kwargs)
+                                           **build_kwargs)
                 futures.append(ret)
 
             for future in futures:
@@ -162,12 +167,18 @@ class RPCRunner(Runner):
         Whether check correctness after measurement. This will use llvm cpu target to
         call your template and get the reference output.
         This can work for TOPI templates, but may not work for your custom template.
+    noise_tolerance: float, optional
+        If is not None, reject the repeats which are slower than the fastest one
+        by more than this ratio. The measurement is taken again (at most
+        `max_noise_retries` times) if more than half of the repeats are rejected.
+    max_noise_retries: int, optional
+        The maximum number of times a noisy measurement is taken again.
     """
     def __init__(self,
                  key, host, port, priority=1,
                  timeout=10, n_parallel=None,
                  number=4, repeat=3, min_repeat_ms=0, cooldown_interval=0.1,
-                 check_correctness=False):
+                 check_correctness=False, noise_tolerance=None, max_noise_retries=2):
         super(RPCRunner, self).__init__(timeout, n_parallel)
 
         self.key = key
@@ -184,6 +195,8 @@ class RPCRunner(Runner):
         self.ref_output = None
         self.check_correctness = check_correctness
         self.cooldown_interval = cooldown_interval
+        self.noise_tolerance = noise_tolerance
+        self.max_noise_retries = max_noise_retries
 
         self.executor = LocalExecutor()
 
@@ -246,7 +259,9 @@ class RPCRunner(Runner):
                                            self.cooldown_interval,
                                            remote_args,
                                            self.ref_input,
-                                           self.ref_output)
+                                           self.ref_output,
+                                           self.noise_tolerance,
+                                           self.max_noise_retries)
                 futures.append(ret)
 
             for future in futures:
@@ -288,6 +303,18 @@ class LocalRunner(RPCRunner):
         Whether check correctness after measurement. This will use llvm cpu target to
         call your template and get the reference output.
         This can work for TOPI templates, but may not work for your custom template.
+    noise_tolerance: float, optional
+        If is not None, reject the repeats which are slower than the fastest one
+        by more than this ratio. The measurement is taken again (at most
+        `max_noise_retries` times) if more than half of the repeats are rejected.
+    max_noise_retries: int, optional
+        The maximum number of times a noisy measurement is taken again.
+    measure_cores: list of int, optional
+        If is not None, the measurement server is pinned to these cores
+        and the build processes forked by a LocalBuilder are pinned to the
+        other cores, so that builds do not disturb measurements.
+        The affinity of this process is left unchanged.
+        Only supported on Linux.
 
     Note
     ----
@@ -297,13 +324,18 @@ class LocalRunner(RPCRunner):
     def __init__(self,
                  timeout=10,
                  number=4, repeat=3, min_repeat_ms=0, cooldown_interval=0.1,
-                 check_correctness=False):
+                 check_correctness=False, noise_tolerance=None, max_noise_retries=2,
+                 measure_cores=None):
         super(LocalRunner, self).__init__('', None, None, 0,
                                           timeout=timeout, n_parallel=1,
                                           number=number, repeat=repeat,
                                           min_repeat_ms=min_repeat_ms,
                                           cooldown_interval=cooldown_interval,
-                                          check_correctness=check_correctness)
+                                          check_correctness=check_correctness,
+                                          noise_tolerance=noise_tolerance,
+                                          max_noise_retries=max_noise_retries)
+        self.measure_cores = measure_cores
+        self.build_cores = None
         self.tracker = None
         self.server = None
 
@@ -313,12 +345,23 @@ class LocalRunner(RPCRunner):
         from ...rpc.tracker import Tracker
         from ...rpc.server import Server
 
+        if self.measure_cores:
+            if not hasattr(os, 'sched_setaffinity'):
+                raise RuntimeError("measure_cores is only supported on Linux with python3")
+            build_cores = set(os.sched_getaffinity(0)) - set(self.measure_cores)
+            if not build_cores:
+                raise RuntimeError("No core is left for building")
+            # only the build processes are pinned, see LocalBuilder.build
+            self.build_cores = sorted(build_cores)
+            check_cpu_frequency(self.measure_cores)
+
         tracker = Tracker('0.0.0.0', port=9000, port_end=10000, silent=True)
         device_key = '$local$device$%d' % tracker.port
         server = Server('0.0.0.0', port=9000, port_end=10000,
                         key=device_key,
                         use_popen=True, silent=True,
-                        tracker_addr=(tracker.host, tracker.port))
+                        tracker_addr=(tracker.host, tracker.port),
+                        cpu_affinity=self.measure_cores)
         self.key = device_key
         self.host = tracker.host
         self.port = tracker.port
@@ -326,6 +369,27 @@ class LocalRunner(RPCRunner):
         super(LocalRunner, self).set_task(task)
         return server, tracker
 
+    def get_build_kwargs(self):
+        kwargs = super(LocalRunner, self).get_build_kwargs()
+        if self.build_cores:
+            kwargs['cpu_affinity'] = self.build_cores
+        return kwargs
+
+
+def _call_with_affinity(cores, func, *args, **kwargs):
+    """Call func in a forked process, after pinning the process to cores.
+
+    Parameters
+    ----------
+    cores: Array of int
+        The ids of the cores, None to keep the affinity of the process
+    func: callable
+        The function to call
+    """
+    if cores:
+        os.sched_setaffinity(0, cores)
+    return func(*args, **kwargs)
+
 
 def _build_func_common(measure_input, check_gpu=None, cuda_arch=None, build_option=None):
     """Common part for building a configuration"""
@@ -393,7 +457,8 @@ def android_ndk_build_func(measure_input, tmp_dir, **kwargs):
 
 def run_through_rpc(measure_input, build_result,
                     number, repeat, min_repeat_ms, cooldown_interval,
-                    remote_args, ref_input=None, ref_output=None):
+                    remote_args, ref_input=None, ref_output=None,
+                    noise_tolerance=None, max_noise_retries=0):
     """Run a generated library through rpc
 
     Parameters
@@ -426,6 +491,10 @@ def run_through_rpc(measure_input, build_result,
         The reference input used for checking correctness
     ref_output: List of np.ndarray
         The reference output used for checking correctness
+    noise_tolerance: float, optional
+        If is not None, reject the noisy repeats, see `reject_noisy_costs`
+    max_noise_retries: int, optional
+        The maximum number of times a noisy measurement is taken again
     """
     if isinstance(build_result, MeasureResult):
         return build_result
@@ -452,13 +521,24 @@ def run_through_rpc(measure_input, build_result,
             ctx.sync()
 
         costs = time_f(*args).results
+        if noise_tolerance is not None:
+            for _ in range(max_noise_retries):
+                _, noisy = reject_noisy_costs(costs, noise_tolerance)
+                if not noisy:
+                    break
+                logger.debug("Noisy measurement %s, measure again", costs)
+                costs = time_f(*args).results
+            costs, noisy = reject_noisy_costs(costs, noise_tolerance)
+            if noisy:
+                logger.warning("Measurement is still noisy after %d retries", max_noise_retries)
 
         # clean up remote files
         remote.remove(build_result.filename)
         remote.remove(os.path.splitext(build_result.filename)[0] + '.so')
         remote.remove('')
 
-        if len(costs) > 2:  # remove largest and smallest value to reduce variance
+        if noise_tolerance is None and len(costs) > 2:
+            # remove largest and smallest value to reduce variance
             costs = list(costs)
             costs.sort()
             costs = tuple(costs[1:-1])
@@ -482,6 +562,57 @@ def run_through_rpc(measure_input, build_result,
     return MeasureResult(costs, errno, tstamp - tic + build_result.time_cost, tstamp)
 
 
+def reject_noisy_costs(costs, tolerance):
+    """Reject the repeats disturbed by other workloads.
+    Interference only slows a run down, so the repeats which are slower than
+    the fastest one by more than `tolerance` are rejected.
+
+    Parameters
+    ----------
+    costs: Array of float
+        The costs of the repeats
+    tolerance: float
+        The tolerated ratio of slowdown
+
+    Returns
+    -------
+    kept: tuple of float
+        The costs which are kept
+    noisy: bool
+        Whether more than half of the repeats are rejected
+    """
+    if not costs:
+        return tuple(costs), False
+    bound = min(costs) * (1 + tolerance)
+    kept = tuple(x for x in costs if x <= bound)
+    return kept, len(kept) * 2 < len(costs)
+
+
+def check_cpu_frequency(cores):
+    """Warn if the frequency of the cores may change during measurement.
+
+    Parameters
+    ----------
+    cores: Array of int
+        The ids of the cores used for measurement
+    """
+    for core in cores:
+        path = "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor" % core
+        if os.path.isfile(path):
+            with open(path) as fin:
+                governor = fin.read().strip()
+            if governor != "performance":
+                logger.warning("The frequency governor of core %d is '%s', the measurement "
+                               "may be noisy. Consider setting it to 'performance'.",
+                               core, governor)
+    path = "/sys/devices/system/cpu/intel_pstate/no_turbo"
+    if os.path.isfile(path):
+        with open(path) as fin:
+            if fin.read().strip() == "0":
+                logger.warning("Turbo boost is enabled, the measurement may depend on "
+                               "the load of the other cores.")
+
+
 def request_remote(device_key, host=None, port=None, priority=1, timeout=60):
     """Request a remote session
 
@@ -9,9 +9,13 @@ import time
 
 import numpy as np
 
+from ... import get_global_func, nd
+from ..task.space import ConfigEntity
 from ..util import sample_ints
 from .model_based_tuner import ModelOptimizer, knob2point, point2knob
 
+_simulated_annealing = get_global_func("autotvm.tuner.SimulatedAnnealing", allow_missing=True)
+
 logger = logging.getLogger('autotvm')
 
 class SimulatedAnnealingOptimizer(ModelOptimizer):
@@ -121,6 +125,89 @@ class SimulatedAnnealingOptimizer(ModelOptimizer):
 
         return [x[1] for x in heap_items]
 
+class NativeSimulatedAnnealingOptimizer(SimulatedAnnealingOptimizer):
+    """simulated annealing optimization algorithm running in C++
+
+    The cost model is evaluated natively on knob features, which makes
+    every iteration much cheaper than the python version. So it can
+    afford more chains and iterations in the same time.
+    It falls back to the python version if the cost model cannot be
+    exported to C++ (see XGBoostCostModel.to_native).
+
+    Parameters
+    ----------
+    task: Task
+        The tuning task
+    n_iter: int
+        The number of iterations of simulated annealing
+    temp: float or Array of float
+        If is a single float, then use a constant temperature.
+        If is an Array, then perform linear cooling from temp[0] to temp[1]
+    parallel_size: int
+        The number of annealing chains
+    early_stop: int, optional
+        Stop iteration if the optimal set do not change in `early_stop` rounds
+    num_threads: int, optional
+        The number of threads, 0 means the number of cores
+    """
+    def __init__(self, task, n_iter=500, temp=(1, 0), persistent=True, parallel_size=1280,
+                 early_stop=50, log_interval=50, num_threads=0):
+        super(NativeSimulatedAnnealingOptimizer, self).__init__(
+            task, n_iter=n_iter, temp=temp, persistent=persistent,
+            parallel_size=parallel_size, early_stop=early_stop, log_interval=log_interval)
+        self.num_threads = num_threads
+        self.table = None
+
+    def _knob_feature_table(self):
+        """build the knob feature of every entity of every knob"""
+        if self.table is None:
+            space = self.task.config_space
+            widths, table = [], []
+            for name, knob in space.space_map.items():
+                rows = [ConfigEntity(0, '', '', {name: knob[i]}, []).get_flatten_feature()
+                        for i in range(len(knob))]
+                widths.append(len(rows[0]))
+                table.extend(rows)
+            self.table = (nd.array(np.array(self.dims, dtype=np.int64)),
+                          nd.array(np.array(widths, dtype=np.int64)),
+                          nd.array(np.concatenate(table).astype(np.float32)))
+        return self.table
+
+    def find_maximums(self, model, num, exclusive):
+        native = model.to_native() if hasattr(model, 'to_native') else None
+        # points are int64 in C++
+        if native is None or len(self.task.config_space) >= (1 << 63):
+            return super(NativeSimulatedAnnealingOptimizer, self).find_maximums(
+                model, num, exclusive)
+
+        tic = time.time()
+        if self.persistent and self.points is not None:
+            points = self.points
+        else:
+            points = np.array(sample_ints(0, len(self.task.config_space), self.parallel_size),
+                              dtype=np.int64)
+        if isinstance(self.temp, (tuple, list, np.ndarray)):
+            temp = (self.temp[0], self.temp[1])
+        else:
+            temp = (self.temp, self.temp)
+
+        dims, widths, table = self._knob_feature_table()
+        points = nd.array(np.asarray(points, dtype=np.int64))
+        maximums = _simulated_annealing(
+            native, dims, widths, table, points,
+            nd.array(np.array(list(exclusive), dtype=np.int64)),
+            int(num), int(self.n_iter), int(min(self.early_stop, 1 << 30)),
+            float(temp[0]), float(temp[1]), int(self.num_threads),
+            int(np.random.randint(1 << 31))).asnumpy()
+
+        logger.debug("Native SA chains: %d\tfound: %d\telapsed: %.2f",
+                     self.parallel_size, len(maximums), time.time() - tic)
+        if self.persistent:
+            self.points = points.asnumpy()
+
+        return [int(x) for x in maximums]
+
+
 def random_walk(p, dims):
     """random walk as local transition
 
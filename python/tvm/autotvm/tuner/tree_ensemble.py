@@ -0,0 +1,115 @@
+# pylint: disable=invalid-name
+"""Native tree ensemble used to evaluate cost models without python overhead"""
+
+import json
+
+import numpy as np
+
+from ..._ffi.node import NodeBase, register_node
+from ... import get_global_func, nd
+
+_make_TreeEnsemble = get_global_func("autotvm.tuner._make_TreeEnsemble", allow_missing=True)
+_predict = get_global_func("autotvm.tuner.TreeEnsemblePredict", allow_missing=True)
+
+
+@register_node("autotvm.TreeEnsemble")
+class TreeEnsemble(NodeBase):
+    """A tree ensemble evaluated in C++
+
+    Parameters
+    ----------
+    tree_root: Array of int
+        The root node of each tree
+    split_feature: Array of int
+        The feature index used to split each node
+    threshold: Array of float
+        The split threshold of each node
+    left: Array of int
+        The child taken when the feature is less than the threshold, -1 for leaf
+    right: Array of int
+        The child taken when the feature is not less than the threshold
+    missing: Array of int
+        The child taken when the feature is missing
+    leaf_value: Array of float
+        The value of each leaf
+    base_margin: float
+        The constant added to the sum of the leaves
+    """
+    def __init__(self, tree_root, split_feature, threshold, left, right, missing,
+                 leaf_value, base_margin=0.0):
+        def _int(x):
+            return nd.array(np.array(x, dtype=np.int32))
+
+        def _float(x):
+            return nd.array(np.array(x, dtype=np.float32))
+
+        self.__init_handle_by_constructor__(
+            _make_TreeEnsemble, _int(tree_root), _int(split_feature), _float(threshold),
+            _int(left), _int(right), _int(missing), _float(leaf_value), float(base_margin))
+
+    def predict(self, feas):
+        """Predict the margin of features
+
+        Parameters
+        ----------
+        feas: np.ndarray
+            two dimensional feature matrix
+
+        Returns
+        -------
+        scores: np.ndarray
+            the predicted margin of every row
+        """
+        feas = np.ascontiguousarray(feas, dtype=np.float32)
+        return _predict(self, nd.array(feas)).asnumpy()
+
+
+def from_xgboost(bst, base_margin=0.5):
+    """Convert a trained xgboost booster to a native tree ensemble
+
+    Parameters
+    ----------
+    bst: xgboost.Booster
+        The booster, trained on features without feature names
+    base_margin: float
+        The base score of the booster
+
+    Returns
+    -------
+    model: TreeEnsemble
+    """
+    tree_root, split_feature, threshold = [], [], []
+    left, right, missing, leaf_value = [], [], [], []
+
+    for dump in bst.get_dump(dump_format='json'):
+        tree = json.loads(dump)
+
+        # assign ids in pre-order, so that children are stored after their parents
+        order = []
+        stack = [tree]
+        while stack:
+            node = stack.pop()
+            order.append(node)
+            stack.extend(reversed(node.get('children', [])))
+        base = len(left)
+        index = {node['nodeid']: base + i for i, node in enumerate(order)}
+
+        tree_root.append(base)
+        for node in order:
+            if 'leaf' in node:
+                split_feature.append(0)
+                threshold.append(0.0)
+                left.append(-1)
+                right.append(-1)
+                missing.append(-1)
+                leaf_value.append(node['leaf'])
+            else:
+                split_feature.append(int(node['split'][1:]))
+                threshold.append(node['split_condition'])
+                left.append(index[node['yes']])
+                right.append(index[node['no']])
+                missing.append(index[node['missing']])
+                leaf_value.append(0.0)
+
+    return TreeEnsemble(tree_root, split_feature, threshold, left, right, missing,
+                        leaf_value, base_margin)
@@ -270,6 +270,21 @@ class XGBoostCostModel(CostModel):
 
         return self.bst.predict(dtest, output_margin=output_margin)
 
+    def to_native(self):
+        """Export the model to a native tree ensemble, which can be evaluated
+        in C++ without python overhead.
+
+        Returns
+        -------
+        model: TreeEnsemble or None
+            None if the model cannot be evaluated natively. Only the models
+            trained on 'knob' feature without a base model are supported.
+        """
+        if self.bst is None or self.fea_type != 'knob' or self.base_model:
+            return None
+        from .tree_ensemble import from_xgboost
+        return from_xgboost(self.bst, self.xgb_params.get('base_score', 0.5))
+
     def load_basemodel(self, base_model):
         self.base_model = base_model
         self.base_model._close_pool()
@@ -291,8 +306,10 @@ class XGBoostCostModel(CostModel):
         need_extract = [x for x in indexes if x not in fea_cache]
 
         if need_extract:
-            pool = self._get_pool()
-            feas = pool.map(self.feature_extract_func, need_extract)
+            feas = self._extract_feature_batch(need_extract)
+            if feas is None:
+                pool = self._get_pool()
+                feas = pool.map(self.feature_extract_func, need_extract)
             for i, fea in zip(need_extract, feas):
                 fea_cache[i] = fea
 
@@ -301,6 +318,27 @@ class XGBoostCostModel(CostModel):
             ret[i, :] = fea_cache[ii]
         return ret
 
+    def _extract_feature_batch(self, indexes):
+        """extract the itervar or curve features of indexes in one batched call,
+        which lowers the instantiated schedules on a pool of threads in C++.
+        Return None if the feature type or the C++ library does not support it."""
+        if self.fea_type not in ('itervar', 'curve'):
+            return None
+        configs = [self.space.get(index) for index in indexes]
+        with self.target:
+            sch_args = [self.task.instantiate(config) for config in configs]
+        try:
+            if self.fea_type == 'itervar':
+                feas = feature.get_itervar_feature_flatten_batch(
+                    sch_args, take_log=True, num_threads=self.num_threads or 0)
+            else:
+                feas = feature.get_buffer_curve_sample_flatten_batch(
+                    sch_args, sample_n=20, num_threads=self.num_threads or 0)
+        except RuntimeError:
+            return None
+        return [np.concatenate((fea, list(config.get_other_option().values())))
+                for fea, config in zip(feas, configs)]
+
     def __del__(self):
         self._close_pool()
 
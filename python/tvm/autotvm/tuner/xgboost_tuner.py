@@ -2,7 +2,7 @@
 
 from .model_based_tuner import ModelBasedTuner, ModelOptimizer
 from .xgboost_cost_model import XGBoostCostModel
-from .sa_model_optimizer import SimulatedAnnealingOptimizer
+from .sa_model_optimizer import SimulatedAnnealingOptimizer, NativeSimulatedAnnealingOptimizer
 
 class XGBTuner(ModelBasedTuner):
     """Tuner that uses xgboost as cost model
@@ -38,6 +38,8 @@ class XGBTuner(ModelBasedTuner):
     num_threads: int, optional
         The number of threads.  optimizer: str or ModelOptimizer, optional
         If is 'sa', use a default simulated annealing optimizer.
+        If is 'native_sa', use a simulated annealing optimizer running in C++,
+        which only speeds up 'knob' feature and falls back to 'sa' otherwise.
         Otherwise it should be a ModelOptimizer object.
     diversity_filter_ratio: int or float, optional
         If is not None, the tuner will first select
@@ -58,6 +60,8 @@ class XGBTuner(ModelBasedTuner):
                                       log_interval=log_interval // 2)
         if optimizer == 'sa':
             optimizer = SimulatedAnnealingOptimizer(task, log_interval=log_interval)
+        elif optimizer == 'native_sa':
+            optimizer = NativeSimulatedAnnealingOptimizer(task, log_interval=log_interval)
         else:
             assert isinstance(optimizer, ModelOptimizer), "Optimizer must be " \
                                                           "a supported name string" \
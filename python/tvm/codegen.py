@@ -19,4 +19,43 @@ def build_module(lowered_func, target):
     """
     return _Build(lowered_func, target)
 
+
+def kernel_cache_config(path, max_bytes=1 << 30):
+    """Configure the persistent kernel cache.
+
+    The relay and nnvm compile engines look up lowered kernels in
+    the cache before lowering them, and store newly lowered kernels.
+    The cache can also be enabled by setting TVM_KERNEL_CACHE_DIR.
+
+    Only the lowering is saved: the code generation of the target
+    still runs for every kernel on a warm build, see
+    apps/benchmark/kernel_cache_bench.py for the time it saves.
+
+    Parameters
+    ----------
+    path : str
+        The cache directory, None or empty string disables the cache.
+
+    max_bytes : int
+        The size limit of the cache, least recently used
+        kernels are evicted when it is exceeded.
+    """
+    _KernelCacheConfig(path if path else "", max_bytes)
+
+
+def kernel_cache_clear():
+    """Remove all kernels from the persistent kernel cache."""
+    _KernelCacheClear()
+
+
+def kernel_cache_stats():
+    """Get the statistics of the persistent kernel cache.
+
+    Returns
+    -------
+    stats : dict of str to int
+        The number of hits, misses, inserts and evictions in this process.
+    """
+    return {k: v.value for k, v in _KernelCacheStats().items()}
+
 _init_api("tvm.codegen")
@@ -3,6 +3,7 @@ from __future__ import absolute_import as _abs
 
 from .. import api as _api
 from .. import intrin as _intrin
+from .. import expr as _expr
 
 def matmul(lhs, rhs, transa=False, transb=False):
     """Create an extern op that compute matrix mult of A and rhs with CrhsLAS
@@ -32,3 +33,35 @@ def matmul(lhs, rhs, transa=False, transb=False):
         lambda ins, outs: _intrin.call_packed(
             "tvm.contrib.cblas.matmul",
             ins[0], ins[1], outs[0], transa, transb), name="C")
+
+
+def batch_matmul(lhs, rhs, transa=False, transb=False):
+    """Create an extern op that compute batched matrix mult of A and rhs with CBLAS
+
+    Parameters
+    ----------
+    lhs : Tensor
+        The left matrix operand, 3-D with the batch as the first axis
+    rhs : Tensor
+        The right matrix operand, 3-D with the batch as the first axis.
+        Either operand can have a batch of 1, which is broadcast.
+    transa : bool
+        Whether transpose lhs
+    transb : bool
+        Whether transpose rhs
+
+    Returns
+    -------
+    C : Tensor
+        The result tensor.
+    """
+    lhs_batch = lhs.shape[0]
+    b = rhs.shape[0] if isinstance(lhs_batch, _expr.IntImm) and lhs_batch.value == 1 \
+        else lhs_batch
+    n = lhs.shape[2] if transa else lhs.shape[1]
+    m = rhs.shape[1] if transb else rhs.shape[2]
+    return _api.extern(
+        (b, n, m), [lhs, rhs],
+        lambda ins, outs: _intrin.call_packed(
+            "tvm.contrib.cblas.batch_matmul",
+            ins[0], ins[1], outs[0], transa, transb), name="C")
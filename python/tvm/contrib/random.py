@@ -3,10 +3,24 @@ from __future__ import absolute_import as _abs
 
 from .. import api as _api
 from .. import intrin as _intrin
-from .._ffi.function import _init_api
+from .._ffi.function import _init_api, get_global_func
 
 
-def randint(low, high, size, dtype='int32'):
+def seed(value):
+    """Seed the random engines of the calling thread.
+
+    The philox engine also restarts its counter, so the tensors generated
+    afterwards only depend on the seed and the sequence of calls.
+
+    Parameters
+    ----------
+    value : int
+        The seed.
+    """
+    get_global_func("tvm.contrib.random.seed")(int(value))
+
+
+def randint(low, high, size, dtype='int32', engine='mt19937'):
     """Return random integers from low (inclusive) to high (exclusive).
     Return random integers from the "discrete uniform" distribution of the
     specified dtype in the "half-open" interval [low, high).
@@ -17,6 +31,10 @@ def randint(low, high, size, dtype='int32'):
         Lowest (signed) integer to be drawn from the distribution
     high : int
         One above the largest (signed) integer to be drawn from the distribution
+    engine : str
+        The random engine, "mt19937" or "philox". The counter based philox engine
+        fills the tensor in parallel and its result does not depend on the
+        number of threads.
 
     Returns
     -------
@@ -25,10 +43,10 @@ def randint(low, high, size, dtype='int32'):
     """
     assert 'int' in dtype, "the type of randint output must be int or uint"
     return _api.extern(size, [], lambda ins, outs: _intrin.call_packed(
-        "tvm.contrib.random.randint", int(low), int(high), outs[0]), dtype=dtype)
+        "tvm.contrib.random.randint", int(low), int(high), outs[0], engine), dtype=dtype)
 
 
-def uniform(low, high, size):
+def uniform(low, high, size, engine='mt19937'):
     """Draw samples from a uniform distribution.
 
     Samples are uniformly distributed over the half-open interval [low, high)
@@ -46,6 +64,8 @@ def uniform(low, high, size):
     size : tuple of ints
         Output shape. If the given shape is, e.g., (m, n, k), then m * n * k
         samples are drawn.
+    engine : str
+        The random engine, "mt19937" or "philox".
 
     Returns
     -------
@@ -53,10 +73,11 @@ def uniform(low, high, size):
         A tensor with specified size and dtype.
     """
     return _api.extern(size, [], lambda ins, outs: _intrin.call_packed(
-        "tvm.contrib.random.uniform", float(low), float(high), outs[0]), dtype='float32')
+        "tvm.contrib.random.uniform", float(low), float(high), outs[0], engine),
+                       dtype='float32')
 
 
-def normal(loc, scale, size):
+def normal(loc, scale, size, engine='mt19937'):
     """Draw samples from a normal distribution.
 
     Return random samples from a normal distribution.
@@ -70,6 +91,11 @@ def normal(loc, scale, size):
     size : tuple of ints
         Output shape. If the given shape is, e.g., (m, n, k), then m * n * k
         samples are drawn.
+    engine : str
+        The random engine, "mt19937" or "philox". The philox samples do not
+        depend on the number of threads, but the transform of its uniform
+        numbers into normal ones uses the math library, so they are only
+        bitwise reproducible on platforms with the same libm.
 
     Returns
     ------
@@ -77,7 +103,8 @@ def normal(loc, scale, size):
         A tensor with specified size and dtype
     """
     return _api.extern(size, [], lambda ins, outs: _intrin.call_packed(
-        "tvm.contrib.random.normal", float(loc), float(scale), outs[0]), dtype='float32')
+        "tvm.contrib.random.normal", float(loc), float(scale), outs[0], engine),
+                       dtype='float32')
 
 
 _init_api("tvm.contrib.random")
@@ -0,0 +1,66 @@
+"""External function interface to the sort library."""
+from __future__ import absolute_import as _abs
+
+from .. import api as _api
+from .. import intrin as _intrin
+
+
+def argsort(data, valid_count, axis=-1, is_descend=False):
+    """Create an extern op that returns the indices which sort data along axis.
+
+    Parameters
+    ----------
+    data : Tensor
+        The input tensor, of float16/32/64 or integer type.
+    valid_count : Tensor
+        The number of elements to sort in each slice along axis, of int32 type.
+        It has the shape of data without axis.
+    axis : int
+        The axis to sort along.
+    is_descend : bool
+        Whether to sort in descending order.
+
+    Returns
+    -------
+    out : Tensor
+        The int32 indices. The elements after valid_count keep their position.
+    """
+    return _api.extern(
+        data.shape, [data, valid_count],
+        lambda ins, outs: _intrin.call_packed(
+            "tvm.contrib.sort.argsort",
+            ins[0], ins[1], outs[0], axis, is_descend),
+        dtype="int32", name="argsort")
+
+
+def topk(data, k, axis=-1, is_descend=True):
+    """Create an extern op that selects the k largest (or smallest) elements along axis.
+
+    Only the k selected elements are sorted, which is cheaper than a full sort.
+
+    Parameters
+    ----------
+    data : Tensor
+        The input tensor, of float16/32/64 or integer type.
+    k : int
+        The number of elements to select.
+    axis : int
+        The axis to select along.
+    is_descend : bool
+        Whether to select the largest elements in descending order.
+
+    Returns
+    -------
+    values : Tensor
+        The selected elements, with the dimension of axis being k.
+    indices : Tensor
+        The int32 indices of the selected elements.
+    """
+    ndim = len(data.shape)
+    out_shape = [k if i == axis % ndim else dim for i, dim in enumerate(data.shape)]
+    return _api.extern(
+        [out_shape, out_shape], [data],
+        lambda ins, outs: _intrin.call_packed(
+            "tvm.contrib.sort.topk",
+            ins[0], outs[0], outs[1], k, axis, is_descend),
+        dtype=[data.dtype, "int32"], name="topk")
@@ -7,6 +7,7 @@ import multiprocessing
 import sys
 import logging
 from .. import rpc
+from .._ffi.function import get_global_func
 
 def main(args):
     """Main function"""
@@ -21,6 +22,11 @@ def main(args):
     else:
         tracker_addr = None
 
+    if args.cpu_affinity:
+        # pin the server and the sessions it forks to the given cores
+        if not get_global_func("runtime.SetCPUAffinity")(args.cpu_affinity):
+            logging.warning("Cannot set cpu affinity on this platform")
+
     server = rpc.Server(args.host,
                         args.port,
                         args.port_end,
@@ -55,6 +61,9 @@ if __name__ == "__main__":
                          and ROCM compilers.")
     parser.add_argument('--custom-addr', type=str,
                         help="Custom IP Address to Report to RPC Tracker")
+    parser.add_argument('--cpu-affinity', type=str,
+                        help="Comma separated ids of the cores the server runs on. "
+                             "e.g. (2,3)")
 
     parser.set_defaults(fork=True)
     args = parser.parse_args()
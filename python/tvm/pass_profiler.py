@@ -0,0 +1,135 @@
+"""Instrumentation of the IR passes.
+
+The profiler records the wall time, the number of IR nodes before and
+after, and the memory usage of every pass invocation of the lowering
+pipeline and of the relay passes.
+
+.. code-block:: python
+
+    with tvm.pass_profiler.PassProfiler() as prof:
+        graph, lib, params = relay.build(func, "llvm")
+    print(prof.summary())
+    prof.export_chrome_trace("passes.json")
+"""
+from __future__ import absolute_import as _abs
+
+import functools
+import json
+
+from ._ffi.node import NodeBase
+from . import _api_internal
+
+
+class PassProfiler(object):
+    """Context to record the pass invocations.
+
+    Records of the previous profiling session are cleared on enter.
+    """
+    def __enter__(self):
+        _api_internal._PassProfilerClear()
+        _api_internal._PassProfilerSetEnabled(True)
+        return self
+
+    def __exit__(self, ptype, value, trace):
+        _api_internal._PassProfilerSetEnabled(False)
+
+    def records(self):
+        """Get the records of the finished passes.
+
+        Returns
+        -------
+        records : list of dict
+            One record per pass invocation, with name, start_us,
+            duration_us, nodes_before, nodes_after, rss_before_bytes,
+            rss_after_bytes, peak_rss_bytes, depth and thread_index.
+        """
+        return json.loads(_api_internal._PassProfilerToJSON())
+
+    def summary(self):
+        """Summarize the records per pass.
+
+        Returns
+        -------
+        summary : str
+            A table of the number of calls, the total time and the
+            total node count change of each pass, slowest first.
+        """
+        stats = {}
+        for rec in self.records():
+            item = stats.setdefault(rec["name"], [0, 0, 0])
+            item[0] += 1
+            item[1] += rec["duration_us"]
+            item[2] += rec["nodes_after"] - rec["nodes_before"]
+        rows = sorted(stats.items(), key=lambda x: -x[1][1])
+        lines = ["%-40s %8s %14s %12s" % ("pass", "calls", "time(ms)", "nodes diff")]
+        for name, (calls, time_us, nodes) in rows:
+            lines.append("%-40s %8d %14.3f %12d" % (name, calls, time_us / 1000.0, nodes))
+        return "\n".join(lines)
+
+    def export_chrome_trace(self, path):
+        """Save the records in the Chrome trace event format.
+
+        The file can be opened in chrome://tracing.
+
+        Parameters
+        ----------
+        path : str
+            The output file.
+        """
+        with open(path, "w") as out_file:
+            out_file.write(_api_internal._PassProfilerToChromeTrace())
+
+
+def _as_node(value):
+    return value if isinstance(value, NodeBase) else None
+
+
+def instrument(name, func):
+    """Wrap a pass function so that its invocations are recorded.
+
+    Parameters
+    ----------
+    name : str
+        The name of the pass in the records.
+
+    func : function
+        The pass function, its first argument is the input IR.
+
+    Returns
+    -------
+    wrapped : function
+        The instrumented function.
+    """
+    @functools.wraps(func)
+    def _wrapped(*args, **kwargs):
+        if not _api_internal._PassProfilerEnabled():
+            return func(*args, **kwargs)
+        _api_internal._PassProfilerBegin(name, _as_node(args[0]) if args else None)
+        ret = None
+        try:
+            ret = func(*args, **kwargs)
+        finally:
+            _api_internal._PassProfilerEnd(_as_node(ret))
+        return ret
+    return _wrapped
+
+
+def instrument_passes(module, prefix, names):
+    """Instrument the given pass functions of a module.
+
+    Analyses and helpers of the module are left alone, only the passes
+    that transform the IR should be listed.
+
+    Parameters
+    ----------
+    module : module
+        The module populated by _init_api.
+
+    prefix : str
+        The prefix of the pass names in the records.
+
+    names : list of str
+        The names of the pass functions in the module.
+    """
+    for name in names:
+        setattr(module, name, instrument(prefix + name, getattr(module, name)))
@@ -1,5 +1,25 @@
 """FFI exposing the Relay type inference and checking."""
+import sys
 
 from tvm._ffi.function import _init_api
+from tvm import pass_profiler as _pass_profiler
 
 _init_api("relay._ir_pass", __name__)
+_pass_profiler.instrument_passes(sys.modules[__name__], "relay.", [
+    "infer_type",
+    "simplify_inference",
+    "canonicalize_ops",
+    "dead_code_elimination",
+    "FoldConstant",
+    "FuseOps",
+    "EliminateCommonSubexpr",
+    "CombineParallelConv2D",
+    "CombineParallelDense",
+    "AlterOpLayout",
+    "RewriteDeviceAnnotation",
+    "backward_fold_scale_axis",
+    "forward_fold_scale_axis",
+    "to_a_normal_form",
+    "to_graph_normal_form",
+    "first_order_gradient",
+])
@@ -100,10 +100,13 @@ class GraphRuntimeCodegen(ExprFunctor):
     nodes = attr.ib()
     var_map = attr.ib()
 
-    def __init__(self, mod, target):
+    def __init__(self, mod, target, memory_planner="pool"):
         ExprFunctor.__init__(self)
+        if memory_planner not in ("pool", "arena"):
+            raise ValueError("Unknown memory planner %s" % memory_planner)
         self.mod = mod
         self.target = target
+        self.memory_planner = memory_planner
         self.nodes = []
         self.var_map = {}
         self.params = {}
@@ -133,8 +136,11 @@ class GraphRuntimeCodegen(ExprFunctor):
         # setup storage ids
         assert expr in self.storage_device_map
         storage_device_info = self.storage_device_map[expr]
-        assert len(storage_device_info) == 2
+        assert len(storage_device_info) in (2, 3)
         node.attrs["storage_id"] = [x.value for x in storage_device_info[0]]
+        # The arena planner also gives the byte offset in the storage.
+        if len(storage_device_info) == 3:
+            node.attrs["storage_offset"] = [x.value for x in storage_device_info[2]]
         device_types = [x.value for x in storage_device_info[1]]
         num_unknown_devices = device_types.count(0)
         if num_unknown_devices != 0 and num_unknown_devices != len(device_types):
@@ -327,6 +333,7 @@ class GraphRuntimeCodegen(ExprFunctor):
         num_entry = 0
         shapes = []
         storage_ids = []
+        storage_offsets = []
         device_types = []
         dltypes = []
         node_row_ptr = [0]
@@ -335,6 +342,8 @@ class GraphRuntimeCodegen(ExprFunctor):
             shapes += node.attrs["shape"]
             dltypes += node.attrs["dtype"]
             storage_ids += node.attrs["storage_id"]
+            if "storage_offset" in node.attrs:
+                storage_offsets += node.attrs["storage_offset"]
             if "device_index" in node.attrs:
                 device_types += node.attrs["device_index"]
             num_entry += node.num_outputs
@@ -344,6 +353,8 @@ class GraphRuntimeCodegen(ExprFunctor):
         attrs = {}
         attrs["shape"] = ["list_shape", shapes]
         attrs["storage_id"] = ["list_int", storage_ids]
+        if storage_offsets:
+            attrs["storage_offset"] = ["list_int", storage_offsets]
         if device_types:
             attrs["device_index"] = ["list_int", device_types]
         attrs["dltype"] = ["list_str", dltypes]
@@ -363,7 +374,7 @@ class GraphRuntimeCodegen(ExprFunctor):
         def _annotate(expr):
             if expr in self.storage_device_map:
                 storage_device_info = self.storage_device_map[expr]
-                assert len(storage_device_info) == 2
+                assert len(storage_device_info) in (2, 3)
                 return str(storage_device_info[0])
             return ""
         return func.astext(show_meta_data=False, annotate=_annotate)
@@ -373,7 +384,7 @@ class GraphRuntimeCodegen(ExprFunctor):
         def _annotate(expr):
             if expr in self.storage_device_map:
                 storage_device_info = self.storage_device_map[expr]
-                assert len(storage_device_info) == 2
+                assert len(storage_device_info) in (2, 3)
                 return str(storage_device_info[1])
             return ""
         return func.astext(show_meta_data=False, annotate=_annotate)
@@ -398,7 +409,10 @@ class GraphRuntimeCodegen(ExprFunctor):
         params : Dict[str, tvm.nd.NDArray]
             Additional constant parameters.
         """
-        self.storage_device_map = _backend.GraphPlanMemory(func)
+        if self.memory_planner == "arena":
+            self.storage_device_map = _backend.GraphPlanMemoryArena(func, "auto")
+        else:
+            self.storage_device_map = _backend.GraphPlanMemory(func)
         # First we convert all the parameters into input nodes.
         for param in func.params:
             node = InputNode(param.name_hint, {})
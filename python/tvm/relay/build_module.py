@@ -18,7 +18,9 @@ OPT_PASS_LEVEL = {
     "SimplifyInference": 0,
     "OpFusion": 1,
     "FoldConstant": 2,
+    "EliminateCommonSubexpr": 3,
     "CombineParallelConv2D": 3,
+    "CombineParallelDense": 3,
     "FoldScaleAxis": 3,
     "AlterOpLayout": 3,
 }
@@ -37,6 +39,8 @@ class BuildConfig(object):
         "opt_level": 2,
         "add_pass": None,
         "fallback_device": None,
+        "memory_planner": "pool",
+        "fuse_cost_model": None,
     }
 
     def __init__(self, **kwargs):
@@ -101,6 +105,15 @@ def build_config(**kwargs):
         The fallback device. It is also used as the default device for
         operators without specified device during heterogeneous execution.
 
+    memory_planner : str, default="pool"
+        The memory planner of the graph runtime. "pool" reuses storage
+        between tensors of similar sizes, "arena" packs all intermediate
+        tensors of a device into one buffer with byte offsets.
+
+    fuse_cost_model : str or function, default=None
+        The cost model of operator fusion, see relay.ir_pass.fuse_ops.
+        None fuses all the operators allowed by their patterns.
+
     Returns
     -------
     config: BuildConfig
@@ -161,10 +174,18 @@ def optimize(func, target=None, params=None):
         func = ir_pass.infer_type(func)
         func = ir_pass.simplify_inference(func)
 
+    if cfg.pass_enabled("EliminateCommonSubexpr"):
+        func = ir_pass.infer_type(func)
+        func = ir_pass.eliminate_common_subexpr(func)
+
     if cfg.pass_enabled("CombineParallelConv2D"):
         func = ir_pass.infer_type(func)
         func = ir_pass.combine_parallel_conv2d(func)
 
+    if cfg.pass_enabled("CombineParallelDense"):
+        func = ir_pass.infer_type(func)
+        func = ir_pass.combine_parallel_dense(func)
+
     # The constant folding pass is necessary because FoldScaleAxis pass needs
     # to check the constantness and positiveness of scales.
     if cfg.pass_enabled("FoldConstant"):
@@ -266,10 +287,11 @@ def build(func, target=None, target_host=None, params=None):
                                                          fallback_device)
         # Fuse ops before running code gen
         func = ir_pass.infer_type(func)
-        func = ir_pass.fuse_ops(func, cfg.opt_level)
+        func = ir_pass.fuse_ops(func, cfg.opt_level, cfg.fuse_cost_model)
         # Graph code generation
         func = ir_pass.infer_type(func)
-        graph_gen = _graph_gen.GraphRuntimeCodegen(mod=None, target=target)
+        graph_gen = _graph_gen.GraphRuntimeCodegen(
+            mod=None, target=target, memory_planner=cfg.memory_planner)
         graph_json, lowered_funcs, params = graph_gen.codegen(func)
         mod = _tvm_build_module(
             lowered_funcs, target=target, target_host=target_host)
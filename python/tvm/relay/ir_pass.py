@@ -379,7 +379,7 @@ def fold_constant(expr):
     return _ir_pass.FoldConstant(expr)
 
 
-def fuse_ops(expr, opt_level=1):
+def fuse_ops(expr, opt_level=1, cost_model=None):
     """Fuse operators in expr together.
 
     Parameters
@@ -390,15 +390,93 @@ def fuse_ops(expr, opt_level=1):
     opt_level : int
         The level of fuse optimization.
 
+    cost_model : None or str or function, optional
+        Decide whether a fusion allowed by the operator patterns is committed.
+        None commits all of them. "memory" commits a fusion if it is estimated
+        to reduce the memory traffic: the fused intermediates are neither written
+        nor read back, injective nodes with several consumers re-read their inputs
+        for each consumer, and a group of more than 16 nodes is charged for the
+        spills of its loop body. A function is called as
+        ``cost_model(src, sink, fused_nodes, default_gain)``, where fused_nodes
+        are the expressions fused into the post-dominator sink and default_gain
+        is the estimated number of bytes saved, and should return the gain of the
+        fusion; the fusion is committed if the gain is positive.
+
     Returns
     -------
     transformed_expr : tvm.relay.Expr
         Transformed expression, containing fused result.
     """
-    return _ir_pass.FuseOps(expr, opt_level)
+    if cost_model is None:
+        return _ir_pass.FuseOps(expr, opt_level)
+    return _ir_pass.FuseOps(expr, opt_level, cost_model)
+
+
+def fuse_ops_report(expr, opt_level=1, cost_model="memory"):
+    """Report the fusion decisions of fuse_ops.
+
+    Parameters
+    ----------
+    expr : tvm.relay.Expr
+        The input expression.
+
+    opt_level : int
+        The level of fuse optimization.
+
+    cost_model : None or str or function, optional
+        The cost model, see fuse_ops.
+
+    Returns
+    -------
+    report : str
+        One line per attempted fusion, starting with "accept" or "reject".
+    """
+    if cost_model is None:
+        return _ir_pass.FuseOpsDump(expr, opt_level)
+    return _ir_pass.FuseOpsDump(expr, opt_level, cost_model)
+
+
+def eliminate_common_subexpr(expr):
+    """Replace the calls, tuples and tuple projections which are equal to
+    an earlier one with the earlier one.
+
+    Parameters
+    ----------
+    expr : tvm.relay.Expr
+        The input expression.
+
+    Returns
+    -------
+    transformed_expr : tvm.relay.Expr
+        Transformed expression
+    """
+    return _ir_pass.EliminateCommonSubexpr(expr)
+
+
+def eliminate_common_subexpr_report(expr):
+    """Eliminate common subexpressions and report the removed work.
+
+    Parameters
+    ----------
+    expr : tvm.relay.Expr
+        The input expression, the MACs are only counted if it is type inferred.
+
+    Returns
+    -------
+    transformed_expr : tvm.relay.Expr
+        Transformed expression
+
+    num_nodes : int
+        The number of removed nodes.
+
+    num_macs : int
+        The number of MACs of the removed calls, see get_total_mac_number.
+    """
+    expr, num_nodes, num_macs = _ir_pass.EliminateCommonSubexprReport(expr)
+    return expr, num_nodes.value, num_macs.value
 
 
-def combine_parallel_conv2d(expr):
+def combine_parallel_conv2d(expr, min_num_branches=2):
     """Fold multiple conv2d into one.
 
     Parameters
@@ -406,12 +484,35 @@ def combine_parallel_conv2d(expr):
     expr : tvm.relay.Expr
         The input expression.
 
+    min_num_branches : int
+        The minimum number of parallel branches to combine.
+
     Returns
     -------
     transformed_expr : tvm.relay.Expr
         Transformed expression
     """
-    return _ir_pass.CombineParallelConv2D(expr)
+    return _ir_pass.CombineParallelConv2D(expr, min_num_branches)
+
+
+def combine_parallel_dense(expr, min_num_branches=3):
+    """Fold multiple dense with the same input into one, the weights are
+    concatenated and the output is sliced back into the branches.
+
+    Parameters
+    ----------
+    expr : tvm.relay.Expr
+        The input expression.
+
+    min_num_branches : int
+        The minimum number of parallel branches to combine.
+
+    Returns
+    -------
+    transformed_expr : tvm.relay.Expr
+        Transformed expression
+    """
+    return _ir_pass.CombineParallelDense(expr, min_num_branches)
 
 
 def alter_op_layout(expr):
@@ -530,7 +631,7 @@ def to_graph_normal_form(expr):
     return _ir_pass.to_graph_normal_form(expr)
 
 
-def gradient(expr, mod=None):
+def gradient(expr, mod=None, checkpoint=None):
     """
     Transform a function to return original result paired with gradient of input.
 
@@ -541,12 +642,28 @@ def gradient(expr, mod=None):
 
     mod : Optional[tvm.relay.Module]
 
+    checkpoint : Optional[Union[str, int]]
+        Which forward intermediates are kept alive for the backward pass,
+        the others are recomputed in the backward pass.
+        None keeps all of them.
+        "annotation" keeps the ones annotated by relay.annotation.checkpoint.
+        An integer is a memory budget in bytes: in addition to the annotated ones,
+        an intermediate is kept whenever the intermediates computed since the last
+        kept one exceed the budget. The input expression must be type inferred.
+
     Returns
     -------
     expr : tvm.relay.Expr
       The output expression.
     """
-    return _ir_pass.first_order_gradient(expr, mod)
+    if checkpoint is None:
+        return _ir_pass.first_order_gradient(expr, mod)
+    if checkpoint == "annotation":
+        checkpoint = 0
+    elif not isinstance(checkpoint, int) or checkpoint <= 0:
+        raise ValueError("checkpoint is expected to be None, \"annotation\" or "
+                         "a positive memory budget, but received %s" % str(checkpoint))
+    return _ir_pass.first_order_gradient(expr, mod, checkpoint)
 
 
 def get_total_mac_number(expr):
@@ -564,3 +681,111 @@ def get_total_mac_number(expr):
       The number of MACs (multiply-accumulate) of a model
     """
     return _ir_pass.GetTotalMacNumber(expr)
+
+
+def dense_to_sparse(func, params, blocksize=None, sparsity_threshold=0.85):
+    """Convert the dense ops whose weight is a sufficiently sparse constant
+    into sparse_dense with the weight in BSR format (CSR for 1x1 blocks).
+
+    Parameters
+    ----------
+    func : tvm.relay.Function
+        The input function.
+
+    params : dict of str to tvm.nd.NDArray
+        The weights of func, a dense weight must be one of them or a constant.
+
+    blocksize : tuple of int, optional
+        The block size (bs_r, bs_c) of the converted weights.
+        By default it is looked up in the current autotvm dispatch context,
+        see topi.x86.sparse.get_bsr_block_size, and a symbolic batch uses the
+        fallback block size.
+
+    sparsity_threshold : float
+        The minimal fraction of zero blocks for a weight to be converted.
+
+    Returns
+    -------
+    ret : tuple of (tvm.relay.Function, dict of str to tvm.nd.NDArray)
+        The converted function and its weights.
+    """
+    import numpy as np
+    import topi
+    from .. import nd as _nd
+    from .. import expr as _tvm_expr
+    from . import expr as _expr
+    from .expr_functor import ExprMutator
+    from .op import op as _op
+    from .op.nn import nn as _nn
+
+    dense_op = _op.get("nn.dense")
+    new_params = dict(params)
+
+    def convert(name, value, bs_r, bs_c):
+        """Get the BSR vars of a weight, None if it is not converted"""
+        N, K = value.shape
+        if N % bs_r != 0 or K % bs_c != 0:
+            return None
+        blocks = value.reshape(N // bs_r, bs_r, K // bs_c, bs_c).transpose(0, 2, 1, 3)
+        mask = np.any(blocks != 0, axis=(2, 3))
+        if 1 - np.mean(mask) < sparsity_threshold:
+            return None
+
+        weight_data = blocks[mask]
+        if (bs_r, bs_c) == (1, 1):
+            weight_data = weight_data.reshape(-1)
+        weight_indices = np.nonzero(mask)[1].astype("int32")
+        weight_indptr = np.concatenate(
+            [[0], np.cumsum(np.sum(mask, axis=1))]).astype("int32")
+        sparse_args = []
+        for suffix, arr in [("data", weight_data), ("indices", weight_indices),
+                            ("indptr", weight_indptr)]:
+            var_name = "%s.%s" % (name, suffix)
+            while var_name in new_params:
+                var_name += "_"
+            new_params[var_name] = _nd.array(arr)
+            sparse_args.append(_expr.var(var_name, shape=arr.shape, dtype=str(arr.dtype)))
+        return sparse_args
+
+    class DenseToSparse(ExprMutator):
+        """Replace the dense ops with a sparse constant weight"""
+        def __init__(self):
+            super(DenseToSparse, self).__init__()
+            # a weight shared by several dense ops is converted once per block size
+            self.converted = {}
+
+        def visit_call(self, call):
+            new_call = super(DenseToSparse, self).visit_call(call)
+            if call.op != dense_op:
+                return new_call
+            weight = call.args[1]
+            if isinstance(weight, _expr.Constant):
+                name, value = "weight", weight.data.asnumpy()
+            elif isinstance(weight, _expr.Var) and weight.name_hint in params:
+                name, value = weight.name_hint, params[weight.name_hint].asnumpy()
+            else:
+                return new_call
+            data_shape = call.args[0].checked_type.shape
+            if len(data_shape) != 2 or len(value.shape) != 2:
+                return new_call
+
+            N, K = value.shape
+            batch = data_shape[0]
+            batch = batch.value if isinstance(batch, _tvm_expr.IntImm) else None
+            bs_r, bs_c = blocksize or topi.x86.sparse.get_bsr_block_size(
+                batch, N, K, topi.x86.sparse.bsr_block_density(value), str(value.dtype))
+            key = (weight, bs_r, bs_c)
+            if key not in self.converted:
+                self.converted[key] = convert(name, value, bs_r, bs_c)
+            if self.converted[key] is None:
+                return new_call
+            return _nn.sparse_dense(new_call.args[0], *self.converted[key])
+
+    func = infer_type(func)
+    body = DenseToSparse().visit(func.body)
+    free = free_vars(body)
+    func_params = [p for p in func.params if p in free]
+    func_params += [v for v in free if v not in func_params]
+    new_params = {p.name_hint: new_params[p.name_hint] for p in func_params
+                  if p.name_hint in new_params}
+    return _expr.Function(func_params, body), new_params
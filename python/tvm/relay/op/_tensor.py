@@ -20,6 +20,7 @@ register_schedule("abs", schedule_broadcast)
 register_schedule("tanh", schedule_broadcast)
 register_schedule("negative", schedule_broadcast)
 register_schedule("copy", schedule_broadcast)
+register_schedule("annotation.checkpoint", schedule_broadcast)
 
 register_schedule("add", schedule_broadcast)
 register_schedule("subtract", schedule_broadcast)
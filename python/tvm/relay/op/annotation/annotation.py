@@ -45,3 +45,20 @@ def stop_fusion(data):
         The annotated expression.
     """
     return _make.stop_fusion(data)
+
+
+def checkpoint(data):
+    """Annotate an expression to be kept for the backward pass when the
+    gradient is computed with rematerialization, see relay.ir_pass.gradient.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The expression to be annotated.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The annotated expression.
+    """
+    return _make.checkpoint(data)
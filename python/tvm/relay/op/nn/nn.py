@@ -485,6 +485,64 @@ def dense(data, weight, units=None):
     return _make.dense(data, weight, units)
 
 
+def batch_matmul(x, y):
+    r"""
+    Computes batch matrix multiplication of `x` and `y` when `x` and `y` are data
+    in batch.
+
+    .. math::
+
+        \mbox{batch_matmul}(x, y)[i, :, :] = \mbox{matmul}(x[i, :, :], y[i, :, :]^T)
+
+    Parameters
+    ----------
+    x : tvm.relay.Expr
+        The first input.
+
+    y : tvm.relay.Expr
+        The second input.
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result.
+    """
+    return _make.batch_matmul(x, y)
+
+
+def sparse_dense(data, weight_data, weight_indices, weight_indptr):
+    r"""
+    Computes the matrix multiplication of `data` and a sparse `weight`,
+    given in CSR or BSR (block compressed sparse row) format.
+
+    .. math::
+
+        \mbox{sparse_dense}(data, weight) = \mbox{matmul}(data, weight^T)
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The input data, of shape (m, k).
+
+    weight_data : tvm.relay.Expr
+        The non-zero elements of the weight, of shape (nnz,) for CSR or
+        (num_blocks, bs_r, bs_c) for BSR.
+
+    weight_indices : tvm.relay.Expr
+        The column of each element (block) of weight_data.
+
+    weight_indptr : tvm.relay.Expr
+        The offsets of each row (block row) in weight_data, of shape (n + 1,)
+        for CSR or (n / bs_r + 1,) for BSR.
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result, of shape (m, n).
+    """
+    return _make.sparse_dense(data, weight_data, weight_indices, weight_indptr)
+
+
 def relu(data):
     """Rectified linear unit.
 
@@ -101,7 +101,7 @@ def register_annotate_function(op_name, frewrite=None, level=10):
 
 
 @register_func("relay.quantize.attach_simulated_quantize")
-def attach_simulated_quantize(data, kind, sign=True, rounding="round"):
+def attach_simulated_quantize(data, kind, sign=True, rounding="round", axis=-1):
     """Attach a simulated quantize operation after input data expr.
 
     Parameters
@@ -111,12 +111,15 @@ def attach_simulated_quantize(data, kind, sign=True, rounding="round"):
 
     kind: QAnnotateKind
         the kind of annotation field.
+
+    axis: int
+        the output channel axis of a weight, -1 if there is none.
     """
     dom_scale = _expr.var("dom_scale")
     clip_min = _expr.var("clip_min")
     clip_max = _expr.var("clip_max")
     return _quantize.simulated_quantize(
-        data, dom_scale, clip_min, clip_max, kind, sign, rounding)
+        data, dom_scale, clip_min, clip_max, kind, sign, rounding, axis)
 
 
 @register_annotate_function("nn.contrib_conv2d_NCHWc")
@@ -145,7 +148,32 @@ def conv2d_rewrite(ref_call, new_args, ctx):
         lhs_expr = attach_simulated_quantize(lhs_expr, QAnnotateKind.INPUT)
 
     assert rhs_kind is None
-    rhs_expr = attach_simulated_quantize(rhs_expr, QAnnotateKind.WEIGHT)
+    kernel_layout = ref_call.attrs.kernel_layout
+    # per channel scale needs an unpacked output channel axis
+    axis = kernel_layout.find('O') if 'o' not in kernel_layout else -1
+    rhs_expr = attach_simulated_quantize(rhs_expr, QAnnotateKind.WEIGHT, axis=axis)
+
+    expr = _forward_op(ref_call, [lhs_expr, rhs_expr])
+    return QAnnotateExpr(expr, QAnnotateKind.ACTIVATION)
+
+
+@register_annotate_function("nn.dense")
+def dense_rewrite(ref_call, new_args, ctx):
+    """Rewrite function for dense. Lhs of dense will be quantized to
+    input field, and rhs of dense will be quantized to weight field.
+    Output would be in activation field. Dense is only quantized with
+    per channel weights, otherwise it stays in float."""
+    if not current_qconfig().per_channel_weight:
+        return None
+
+    lhs_expr, lhs_kind = _get_expr_kind(new_args[0])
+    rhs_expr, rhs_kind = _get_expr_kind(new_args[1])
+
+    if lhs_kind is None or lhs_kind != QAnnotateKind.INPUT:
+        lhs_expr = attach_simulated_quantize(lhs_expr, QAnnotateKind.INPUT)
+
+    assert rhs_kind is None
+    rhs_expr = attach_simulated_quantize(rhs_expr, QAnnotateKind.WEIGHT, axis=0)
 
     expr = _forward_op(ref_call, [lhs_expr, rhs_expr])
     return QAnnotateExpr(expr, QAnnotateKind.ACTIVATION)
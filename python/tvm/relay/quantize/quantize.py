@@ -57,6 +57,8 @@ class QConfig(NodeBase):
         "skip_k_conv": 1,
         "round_for_shift": True,
         "store_lowbit_output": True,
+        "per_channel_weight": False,
+        "fixed_point_requantize": False,
         "debug_enabled_ops": None,
     }
 
@@ -129,11 +131,25 @@ def qconfig(**kwargs):
         Whether to store low-bit integer back as output before dequantizing.
         Some accelerators need this, e.g. VTA.
 
+    per_channel_weight: boolean
+        Whether to calibrate the weights of conv2d and dense with a scale
+        per output channel instead of a power of 2 scale per tensor.
+        Dense is only quantized when it is enabled.
+        It needs fixed_point_requantize, which is enabled by default with it.
+
+    fixed_point_requantize: boolean
+        Whether to rescale integers by an integer multiplier and a right shift
+        instead of float computation, when the scale factor is not a power of 2.
+
     Returns
     -------
     config: QConfig
         The quantization configuration
     """
+    if kwargs.get("per_channel_weight", False):
+        # per channel scales are not powers of 2, they can only be rescaled in fixed point.
+        if not kwargs.setdefault("fixed_point_requantize", True):
+            raise ValueError("per_channel_weight requires fixed_point_requantize")
     node_args = {k: v if k not in kwargs else kwargs[k]
                  for k, v in QConfig._node_defaults.items()}
     return _make.node("relay.quantize.QConfig", **node_args)
@@ -195,6 +211,13 @@ def calibrate(graph, dataset=None):
         val = np.amax(np.abs(arr.asnumpy()))
         return 2**np.math.ceil(np.math.log(val, 2)) if val > 0 else 1.0
 
+    def channel_scale(arr, axis):
+        """calculate weight scale of each channel on axis"""
+        arr = np.abs(arr.asnumpy())
+        reduce_axis = tuple(i for i in range(arr.ndim) if i != axis)
+        val = np.amax(arr, axis=reduce_axis, keepdims=True)
+        return np.where(val > 0, val, 1.0).astype('float32')
+
     cfg = current_qconfig()
     const_params = {}
     quantize_op = _op.get("relay.op.annotation.simulated_quantize")
@@ -209,10 +232,15 @@ def calibrate(graph, dataset=None):
 
             valid_bit = nbit - attrs.sign
 
+            per_channel = False
             if kind == QAnnotateKind.WEIGHT:
                 var = expr.args[0]
                 assert isinstance(var, _expr.Constant)
-                scale = power2_scale(var.data)
+                if cfg.per_channel_weight and attrs.axis >= 0:
+                    scale = channel_scale(var.data, attrs.axis)
+                    per_channel = True
+                else:
+                    scale = power2_scale(var.data)
             else:
                 scale = cfg.global_scale
 
@@ -220,7 +248,11 @@ def calibrate(graph, dataset=None):
                 return _expr.const(val, 'float32')
 
             valid_range = 2**valid_bit
-            const_params[ndom_scale] = _make_const(scale / valid_range)
+            if per_channel:
+                const_params[ndom_scale] = _expr.const(
+                    (scale / valid_range).astype('float32'))
+            else:
+                const_params[ndom_scale] = _make_const(scale / valid_range)
             const_params[nclip_min] = _make_const(- (valid_range - 1))
             const_params[nclip_max] = _make_const((valid_range - 1))
 
@@ -289,6 +289,9 @@ class Server(object):
 
     silent: bool, optional
         Whether run this server in silent mode.
+
+    cpu_affinity: list of int, optional
+        The ids of the cores the server runs on. Only used when use_popen is True.
     """
     def __init__(self,
                  host,
@@ -300,7 +303,8 @@ class Server(object):
                  key="",
                  load_library=None,
                  custom_addr=None,
-                 silent=False):
+                 silent=False,
+                 cpu_affinity=None):
         try:
             if base._ServerLoop is None:
                 raise RuntimeError("Please compile with USE_RPC=1")
@@ -330,6 +334,8 @@ class Server(object):
                 cmd += ["--custom-addr", custom_addr]
             if silent:
                 cmd += ["--silent"]
+            if cpu_affinity:
+                cmd += ["--cpu-affinity", ",".join(str(x) for x in cpu_affinity)]
 
             # prexec_fn is not thread safe and may result in deadlock.
             # python 3.2 introduced the start_new_session parameter as
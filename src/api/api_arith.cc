@@ -6,7 +6,9 @@
 #include <tvm/expr.h>
 #include <tvm/ir.h>
 #include <tvm/api_registry.h>
+#include <tvm/arithmetic.h>
 #include <tvm/tensor.h>
+#include "../arithmetic/int_set_internal.h"
 
 namespace tvm {
 namespace arith {
@@ -75,5 +77,53 @@ TVM_REGISTER_API("_IntSetIsEverything")
     *ret = args[0].operator IntSet().is_everything();
   });
 
+TVM_REGISTER_API("arith._make_ConstIntBound")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    *ret = ConstIntBoundNode::make(args[0], args[1]);
+  });
+
+TVM_REGISTER_API("arith._CreateAnalyzer")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    using runtime::PackedFunc;
+    using runtime::TypedPackedFunc;
+    auto self = std::make_shared<Analyzer>();
+    auto f = [self](std::string name) -> PackedFunc {
+      if (name == "const_int_bound") {
+        return PackedFunc([self](TVMArgs args, TVMRetValue *ret) {
+            *ret = self->const_int_bound(args[0]);
+          });
+      } else if (name == "modular_set") {
+        return PackedFunc([self](TVMArgs args, TVMRetValue *ret) {
+            NodePtr<ModularSet> n = make_node<ModularSet>();
+            n->e = self->modular_set(args[0]);
+            *ret = IntSet(n);
+          });
+      } else if (name == "const_int_bound_update") {
+        return PackedFunc([self](TVMArgs args, TVMRetValue *ret) {
+            self->const_int_bound.Update(args[0], args[1], args[2]);
+          });
+      } else if (name == "rewrite_simplify") {
+        return PackedFunc([self](TVMArgs args, TVMRetValue *ret) {
+            *ret = self->rewrite_simplify(args[0]);
+          });
+      } else if (name == "can_prove") {
+        return PackedFunc([self](TVMArgs args, TVMRetValue *ret) {
+            *ret = self->CanProve(args[0]);
+          });
+      } else if (name == "bind") {
+        return PackedFunc([self](TVMArgs args, TVMRetValue *ret) {
+            Var var = args[0];
+            if (args[1].IsNodeType<Range>()) {
+              self->Bind(var, args[1].operator Range());
+            } else {
+              self->Bind(var, args[1].operator Expr());
+            }
+          });
+      }
+      return PackedFunc();
+    };
+    *ret = TypedPackedFunc<PackedFunc(std::string)>(f);
+  });
+
 }  // namespace arith
 }  // namespace tvm
@@ -10,6 +10,7 @@
 #include <tvm/ir_visitor.h>
 #include <tvm/ir_mutator.h>
 #include <tvm/api_registry.h>
+#include <tvm/pass_profiler.h>
 
 namespace tvm {
 namespace ir {
@@ -17,11 +18,13 @@ namespace ir {
 TVM_REGISTER_API("ir_pass.Simplify")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
     if (args[0].IsNodeType<Stmt>()) {
+      PassProfileScope scope("Simplify", ProfiledNode(args[0]));
       if (args.size() > 1) {
         *ret = Simplify(args[0].operator Stmt(), args[1]);
       } else {
         *ret = Simplify(args[0].operator Stmt());
       }
+      scope.set_output(ProfiledNode(*ret));
     } else {
       if (args.size() > 1) {
         *ret = Simplify(args[0].operator Expr(), args[1]);
@@ -34,11 +37,13 @@ TVM_REGISTER_API("ir_pass.Simplify")
 TVM_REGISTER_API("ir_pass.CanonicalSimplify")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
     if (args[0].IsNodeType<Stmt>()) {
+      PassProfileScope scope("CanonicalSimplify", ProfiledNode(args[0]));
       if (args.size() > 1) {
         *ret = CanonicalSimplify(args[0].operator Stmt(), args[1]);
       } else {
         *ret = CanonicalSimplify(args[0].operator Stmt());
       }
+      scope.set_output(ProfiledNode(*ret));
     } else {
       if (args.size() > 1) {
         *ret = CanonicalSimplify(args[0].operator Expr(), args[1]);
@@ -68,11 +73,13 @@ TVM_REGISTER_API("ir_pass.Equal")
 
 TVM_REGISTER_API("ir_pass.StorageFlatten")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
+    PassProfileScope scope("StorageFlatten", ProfiledNode(args[0]));
     if (args.size() <= 3) {
       *ret = StorageFlatten(args[0], args[1], args[2]);
     } else {
       *ret = StorageFlatten(args[0], args[1], args[2], args[3]);
     }
+    scope.set_output(ProfiledNode(*ret));
   });
 
 TVM_REGISTER_API("ir_pass.AttrsEqual")
@@ -103,31 +110,41 @@ TVM_REGISTER_API("ir_pass.PostOrderVisit")
 #define REGISTER_PASS1(PassName)                                  \
   TVM_REGISTER_API("ir_pass."#PassName)                           \
   .set_body([](TVMArgs args,  TVMRetValue *ret) {                 \
+      PassProfileScope scope(#PassName, ProfiledNode(args[0]));   \
       *ret = PassName(args[0]);                                   \
+      scope.set_output(ProfiledNode(*ret));                       \
     })                                                            \
 
 #define REGISTER_PASS2(PassName)                                  \
   TVM_REGISTER_API("ir_pass."#PassName)                           \
   .set_body([](TVMArgs args,  TVMRetValue *ret) {                 \
+      PassProfileScope scope(#PassName, ProfiledNode(args[0]));   \
       *ret = PassName(args[0], args[1]);                          \
+      scope.set_output(ProfiledNode(*ret));                       \
     })                                                            \
 
 #define REGISTER_PASS3(PassName)                                        \
   TVM_REGISTER_API("ir_pass."#PassName)                                 \
   .set_body([](TVMArgs args,  TVMRetValue *ret) {                       \
+      PassProfileScope scope(#PassName, ProfiledNode(args[0]));         \
       *ret = PassName(args[0], args[1], args[2]);                       \
+      scope.set_output(ProfiledNode(*ret));                             \
     })                                                                  \
 
 #define REGISTER_PASS4(PassName)                                        \
   TVM_REGISTER_API("ir_pass."#PassName)                                 \
   .set_body([](TVMArgs args,  TVMRetValue *ret) {                       \
+      PassProfileScope scope(#PassName, ProfiledNode(args[0]));         \
       *ret = PassName(args[0], args[1], args[2], args[3]);              \
+      scope.set_output(ProfiledNode(*ret));                             \
     })                                                                  \
 
 #define REGISTER_PASS5(PassName)                                        \
   TVM_REGISTER_API("ir_pass."#PassName)                                 \
   .set_body([](TVMArgs args,  TVMRetValue *ret) {                       \
+      PassProfileScope scope(#PassName, ProfiledNode(args[0]));         \
       *ret = PassName(args[0], args[1], args[2], args[3], args[4]);     \
+      scope.set_output(ProfiledNode(*ret));                             \
     })                                                                  \
 
 REGISTER_PASS1(ConvertSSA);
@@ -8,6 +8,7 @@
 #include <tvm/schedule.h>
 #include <tvm/schedule_pass.h>
 #include <tvm/api_registry.h>
+#include <tvm/pass_profiler.h>
 #include "../schedule/graph.h"
 
 namespace tvm {
@@ -26,10 +27,12 @@ TVM_REGISTER_API("schedule.AutoInlineInjective")
 
 TVM_REGISTER_API("schedule.ScheduleOps")
 .set_body([](TVMArgs args, TVMRetValue* ret) {
+  PassProfileScope scope("ScheduleOps", ProfiledNode(args[0]));
   if (args.size() == 2)
     *ret = ScheduleOps(args[0], args[1], false);
   else
     *ret = ScheduleOps(args[0], args[1], args[2]);
+  scope.set_output(ProfiledNode(*ret));
 });
 
 #define REGISTER_SCHEDULE_PASS1(PassName)                         \
@@ -45,7 +48,13 @@ TVM_REGISTER_API("schedule.ScheduleOps")
     })                                                            \
 
 
-REGISTER_SCHEDULE_PASS1(InferBound);
+TVM_REGISTER_API("schedule.InferBound")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    PassProfileScope scope("InferBound", ProfiledNode(args[0]));
+    *ret = InferBound(args[0]);
+    scope.set_output(ProfiledNode(*ret));
+  });
+
 REGISTER_SCHEDULE_PASS1(CreateReadGraph);
 REGISTER_SCHEDULE_PASS2(PostDFSOrder);
 REGISTER_SCHEDULE_PASS1(CreateAttachPath);
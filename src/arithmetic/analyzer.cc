@@ -0,0 +1,91 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file analyzer.cc
+ */
+#include <dmlc/thread_local.h>
+#include <tvm/ir.h>
+#include <tvm/ir_pass.h>
+#include <tvm/ir_operator.h>
+#include <tvm/arithmetic.h>
+#include "compute_expr.h"
+
+namespace tvm {
+namespace arith {
+
+Analyzer::Analyzer()
+    : const_int_bound(this),
+      modular_set(this),
+      rewrite_simplify(this) {
+}
+
+void Analyzer::Bind(const VarExpr& v, const Expr& expr) {
+  Var var(v.node_);
+  this->const_int_bound.Update(var, this->const_int_bound(expr));
+  this->modular_set.Update(var, this->modular_set(expr));
+  this->rewrite_simplify.Update(var, this->rewrite_simplify(expr));
+}
+
+void Analyzer::Bind(const VarExpr& v, const Range& range) {
+  Var var(v.node_);
+  this->const_int_bound.Bind(var, range);
+  // skip modular_set
+  // skip rewrite simplify
+}
+
+bool Analyzer::CanProveGreaterEqual(const Expr& expr, int64_t lower_bound) {
+  if (const auto* ptr = expr.as<ir::IntImm>()) {
+    return ptr->value >= lower_bound;
+  }
+  auto bd = this->const_int_bound(expr);
+  if (bd->min_value >= lower_bound) return true;
+  return false;
+}
+
+bool Analyzer::CanProve(const Expr& cond) {
+  Expr res = this->rewrite_simplify(cond);
+  return is_one(res);
+}
+
+Expr Analyzer::Simplify(const Expr& expr) {
+  if (is_const(expr)) return expr;
+  return this->rewrite_simplify(expr);
+}
+
+bool ProveEqual(const Expr& lhs, const Expr& rhs) {
+  if (lhs.same_as(rhs)) return true;
+  Expr diff = lhs - rhs;
+  if (is_const(diff)) return is_zero(diff);
+  // nothing is bound to the shared analyzer, it only simplifies.
+  Analyzer* analyzer = dmlc::ThreadLocalStore<Analyzer>::Get();
+  Expr res = analyzer->rewrite_simplify(diff);
+  if (is_const(res)) return is_zero(res);
+  return is_zero(ir::Simplify(diff));
+}
+
+ModularSetAnalyzer::ModularSetAnalyzer(Analyzer* parent)
+    : parent_(parent) {
+}
+
+ModularEntry ModularSetAnalyzer::operator()(const Expr& expr) {
+  return EvalModular(expr, var_map_);
+}
+
+void ModularSetAnalyzer::Update(const Var& var,
+                                const ModularEntry& info,
+                                bool override) {
+  if (!override) {
+    auto it = var_map_.find(var.get());
+    if (it != var_map_.end()) {
+      CHECK(it->second.coeff == info.coeff &&
+            it->second.base == info.base)
+          << "Trying to update var \'" << var << "\'"
+          << " with a different modular set: "
+          << "original=(" << it->second.coeff << " * x + " << it->second.base << ")"
+          << ", new=(" << info.coeff << " * x + " << info.base << ")";
+    }
+  }
+  var_map_[var.get()] = info;
+}
+
+}  // namespace arith
+}  // namespace tvm
@@ -59,6 +59,17 @@ inline bool GetConstInt(Expr e, int* out) {
   return false;
 }
 
+/*!
+ * \brief Prove that lhs equals rhs.
+ *  The rewrite simplifier of a thread local analyzer is tried before
+ *  the full simplifier, which only runs when the difference of the
+ *  two does not fold into a constant.
+ * \param lhs The left operand
+ * \param rhs The right operand
+ * \return Whether the equality is proven.
+ */
+bool ProveEqual(const Expr& lhs, const Expr& rhs);
+
 template<>
 inline Expr ComputeExpr<ir::Add>(Expr a, Expr b) {
   return a + b;
@@ -0,0 +1,361 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file const_int_bound.cc
+ * \brief Constant integer bound analysis.
+ */
+#include <tvm/ir.h>
+#include <tvm/ir_operator.h>
+#include <tvm/arithmetic.h>
+#include <tvm/ir_functor_ext.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace tvm {
+namespace arith {
+
+using namespace ir;
+
+TVM_REGISTER_NODE_TYPE(ConstIntBoundNode);
+
+const constexpr int64_t ConstIntBoundNode::kPosInf;
+const constexpr int64_t ConstIntBoundNode::kNegInf;
+
+ConstIntBound ConstIntBoundNode::make(
+    int64_t min_value, int64_t max_value) {
+  NodePtr<ConstIntBoundNode> node = make_node<ConstIntBoundNode>();
+  node->min_value = min_value;
+  node->max_value = max_value;
+  return ConstIntBound(node);
+}
+
+TVM_STATIC_IR_FUNCTOR(IRPrinter, vtable)
+.set_dispatch<ConstIntBoundNode>([](const ConstIntBoundNode* op, IRPrinter* p) {
+    p->stream << "ConstIntBound"
+              << "[" << op->min_value << ", "
+              << op->max_value << ']';
+  });
+
+// internal entry for const int bound
+struct ConstIntBoundEntry {
+  int64_t min_value;
+  int64_t max_value;
+
+  bool is_const(int64_t value) const {
+    return min_value == max_value && min_value == value;
+  }
+};
+
+class ConstIntBoundAnalyzer::Impl :
+      public ExprFunctor<ConstIntBoundEntry(const Expr&)> {
+ public:
+  typedef ConstIntBoundEntry Entry;
+
+  void Bind(const Var& var, const Range& range) {
+    Entry a = VisitExpr(range->min);
+    Entry b = VisitExpr(range->extent);
+    Entry ret;
+    ret.min_value = a.min_value;
+    ret.max_value = InfAwareAdd(a.max_value, InfAwareAdd(b.max_value, -1));
+    Update(var, ret, false);
+  }
+
+  void Update(const Var& var,
+              const Entry& info,
+              bool override) {
+    if (!override) {
+      auto it = var_map_.find(var.get());
+      if (it != var_map_.end()) {
+        CHECK(it->second.min_value == info.min_value &&
+              it->second.max_value == info.max_value)
+            << " Trying to update var \'" << var << "\'"
+            << " with a different const bound: "
+            << "original=" << ConstIntBoundNode::make(
+                it->second.min_value, it->second.max_value)
+            << ", new=" << ConstIntBoundNode::make(
+                info.min_value, info.max_value);
+      }
+    }
+    var_map_[var.get()] = info;
+  }
+
+  void Update(const Var& var,
+              const ConstIntBound& info,
+              bool override) {
+    Update(var, MakeBound(info->min_value, info->max_value), override);
+  }
+
+  // Override visitor behaviors
+  Entry VisitExprDefault_(const Node* op) final {
+    return Everything(
+        static_cast<const HalideIR::Internal::BaseExprNode*>(op)->type);
+  }
+
+  Entry VisitExpr_(const Cast* op) final {
+    Entry a = VisitExpr(op->value);
+    Entry b = Everything(op->type);
+    return Intersect(a, b);
+  }
+
+  Entry VisitExpr_(const IntImm* op) final {
+    return MakeBound(op->value, op->value);
+  }
+
+  Entry VisitExpr_(const UIntImm* op) final {
+    if (op->value <= static_cast<uint64_t>(kPosInf)) {
+      return MakeBound(op->value, op->value);
+    } else {
+      return Everything(op->type);
+    }
+  }
+
+  Entry VisitExpr_(const Add* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    Entry ret;
+    ret.min_value = InfAwareAdd(a.min_value, b.min_value);
+    ret.max_value = InfAwareAdd(a.max_value, b.max_value);
+    return ret;
+  }
+
+  Entry VisitExpr_(const Sub* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    Entry ret;
+    ret.min_value = InfAwareAdd(a.min_value, -b.max_value);
+    ret.max_value = InfAwareAdd(a.max_value, -b.min_value);
+    return ret;
+  }
+
+  Entry VisitExpr_(const Mul* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    return BinaryOpBoundry(a, b, InfAwareMul);
+  }
+
+  Entry VisitExpr_(const Div* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    // the divisor must not contain zero.
+    if (b.min_value > 0 || b.max_value < 0) {
+      return BinaryOpBoundry(a, b, InfAwareDiv);
+    }
+    return Everything(op->type);
+  }
+
+  Entry VisitExpr_(const Mod* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    if (b.min_value > 0) {
+      int64_t b_max_cap = InfAwareAdd(b.max_value, -1);
+      // the sign of the result follows the dividend.
+      Entry ret;
+      ret.min_value = a.min_value >= 0 ? 0 : std::max(a.min_value, -b_max_cap);
+      ret.max_value = a.max_value <= 0 ? 0 : std::min(a.max_value, b_max_cap);
+      return ret;
+    }
+    return Everything(op->type);
+  }
+
+  Entry VisitExpr_(const Min* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    Entry ret;
+    ret.min_value = std::min(a.min_value, b.min_value);
+    ret.max_value = std::min(a.max_value, b.max_value);
+    return ret;
+  }
+
+  Entry VisitExpr_(const Max* op) final {
+    Entry a = VisitExpr(op->a);
+    Entry b = VisitExpr(op->b);
+    Entry ret;
+    ret.min_value = std::max(a.min_value, b.min_value);
+    ret.max_value = std::max(a.max_value, b.max_value);
+    return ret;
+  }
+
+  Entry VisitExpr_(const Select* op) final {
+    Entry a = VisitExpr(op->true_value);
+    Entry b = VisitExpr(op->false_value);
+    return Union(a, b);
+  }
+
+  Entry VisitExpr_(const Ramp* op) final {
+    // op = {base + i * stride | 0 <= i < lanes}
+    // Entry(op) = Union(Entry(base + i * stride) | 0 <= i < lanes)
+    // Note that `base + i * stride` is linear w.r.t. `i`
+    // Entry(op) = Union(Entry(base + i * stride) | i = 0, i = lanes-1)
+    Entry a = VisitExpr(op->base);
+    Entry b = VisitExpr(op->base + (op->lanes - 1) * op->stride);
+    return Union(a, b);
+  }
+
+  Entry VisitExpr_(const Broadcast* op) final {
+    return VisitExpr(op->value);
+  }
+
+  Entry VisitExpr_(const Variable* op) final {
+    auto it = var_map_.find(op);
+    if (it != var_map_.end()) {
+      return it->second;
+    } else {
+      return Everything(op->type);
+    }
+  }
+
+ private:
+  // internal variable map
+  std::unordered_map<const Variable*, Entry> var_map_;
+  // NOTE: kNegInf/kPosInf are used to represent infinity.
+  static const constexpr int64_t kNegInf = ConstIntBoundNode::kNegInf;
+  static const constexpr int64_t kPosInf = ConstIntBoundNode::kPosInf;
+  static_assert(-kNegInf == kPosInf, "invariant of inf");
+  // internal helper functions
+  /*!
+   * \brief Get boundary of binary op who are monotonic wrt to one argument.
+   * \param a The entry of the left operand.
+   * \param b The entry of the right operand.
+   * \param op The operator.
+   * \tparam F the operator function type.
+   * \return The result.
+   */
+  template<typename F>
+  static Entry BinaryOpBoundry(Entry a, Entry b, const F& op) {
+    Entry ret;
+    // The extreme values are reached at the corners.
+    int64_t v1 = op(a.min_value, b.min_value);
+    int64_t v2 = op(a.max_value, b.max_value);
+    int64_t v3 = op(a.min_value, b.max_value);
+    int64_t v4 = op(a.max_value, b.min_value);
+    ret.min_value = std::min(std::min(std::min(v1, v2), v3), v4);
+    ret.max_value = std::max(std::max(std::max(v1, v2), v3), v4);
+    return ret;
+  }
+  /*!
+   * \brief Compute x + y, aware of inf.
+   * \param x The left operand.
+   * \param y The right operand.
+   * \return the result.
+   */
+  static int64_t InfAwareAdd(int64_t x, int64_t y) {
+    if (x == kPosInf || x == kNegInf) return x;
+    if (y == kPosInf || y == kNegInf) return y;
+    // saturate on overflow.
+    if (y > 0 && x > kPosInf - y) return kPosInf;
+    if (y < 0 && x < kNegInf - y) return kNegInf;
+    return x + y;
+  }
+  /*!
+   * \brief Compute x * y, aware of inf.
+   * \param x The left operand.
+   * \param y The right operand.
+   * \return the result.
+   */
+  static int64_t InfAwareMul(int64_t x, int64_t y) {
+    if (x == 0 || y == 0) return 0;
+    bool neg = (x < 0) != (y < 0);
+    int64_t ax = std::abs(x), ay = std::abs(y);
+    if (ax == kPosInf || ay == kPosInf || ax > kPosInf / ay) {
+      return neg ? kNegInf : kPosInf;
+    }
+    return x * y;
+  }
+  /*!
+   * \brief Compute x / y, aware of inf.
+   * \param x The left operand.
+   * \param y The right operand.
+   * \return the result.
+   */
+  static int64_t InfAwareDiv(int64_t x, int64_t y) {
+    CHECK_NE(y, 0);
+    if (x == kPosInf || x == kNegInf) {
+      return (y > 0) ? x : -x;
+    }
+    if (y == kPosInf || y == kNegInf) return 0;
+    return x / y;
+  }
+  /*!
+   * \brief Create union of two sets.
+   * \param a The left operand.
+   * \param b the right operand.
+   */
+  static Entry Union(Entry a, Entry b) {
+    Entry ret;
+    ret.min_value = std::min(a.min_value, b.min_value);
+    ret.max_value = std::max(a.max_value, b.max_value);
+    return ret;
+  }
+  /*!
+   * \brief Create intersect of two sets.
+   * \param a The left operand.
+   * \param b the right operand.
+   */
+  static Entry Intersect(Entry a, Entry b) {
+    Entry ret;
+    ret.min_value = std::max(a.min_value, b.min_value);
+    ret.max_value = std::min(a.max_value, b.max_value);
+    return ret;
+  }
+  /*!
+   * \brief Make a new bound entry.
+   */
+  static Entry MakeBound(int64_t min_value, int64_t max_value) {
+    Entry e;
+    e.min_value = min_value;
+    e.max_value = max_value;
+    return e;
+  }
+  /*!
+   * \brief Get the value range of the type.
+   * \param type The data type.
+   * \return Bound that represent everything dtype can represent.
+   */
+  static Entry Everything(Type type) {
+    if (!type.is_int() && !type.is_uint()) {
+      return MakeBound(kNegInf, kPosInf);
+    }
+    Entry ret;
+    int64_t vbits = int64_t(type.bits()) - static_cast<int64_t>(type.is_int());
+    if (type.is_uint()) {
+      ret.min_value = 0;
+    } else {
+      if (vbits >= 63) {
+        ret.min_value = kNegInf;
+      } else {
+        ret.min_value = -(static_cast<int64_t>(1) << vbits);
+      }
+    }
+    if (vbits >= 63) {
+      ret.max_value = kPosInf;
+    } else {
+      ret.max_value = (static_cast<int64_t>(1) << vbits) - 1;
+    }
+    return ret;
+  }
+};
+
+ConstIntBound ConstIntBoundAnalyzer::operator()(const Expr& expr) {
+  ConstIntBoundEntry ret = impl_->VisitExpr(expr);
+  return ConstIntBoundNode::make(ret.min_value, ret.max_value);
+}
+
+void ConstIntBoundAnalyzer::Update(const Var& var,
+                                   const ConstIntBound& info,
+                                   bool override) {
+  impl_->Update(var, info, override);
+}
+
+void ConstIntBoundAnalyzer::Bind(const Var& var, const Range& range) {
+  impl_->Bind(var, range);
+}
+
+ConstIntBoundAnalyzer::ConstIntBoundAnalyzer(Analyzer* parent)
+    : impl_(new Impl()) {
+}
+
+ConstIntBoundAnalyzer::~ConstIntBoundAnalyzer() {
+  delete impl_;
+}
+
+}  // namespace arith
+}  // namespace tvm
@@ -76,12 +76,22 @@ bool IntSet::is_single_point() const {
 
 bool IntSet::can_prove_positive() const {
   const IntervalSet* s_int = (*this).as<IntervalSet>();
-  return (s_int && is_positive_const(ir::Simplify(s_int->i.min)));
+  if (!s_int) return false;
+  if (s_int->i.has_lower_bound()) {
+    Analyzer analyzer;
+    if (analyzer.CanProveGreaterEqual(s_int->i.min, 1)) return true;
+  }
+  return is_positive_const(ir::Simplify(s_int->i.min));
 }
 
 bool IntSet::can_prove_negative() const {
   const IntervalSet* s_int = (*this).as<IntervalSet>();
-  return (s_int && is_negative_const(ir::Simplify(s_int->i.max)));
+  if (!s_int) return false;
+  if (s_int->i.has_upper_bound()) {
+    Analyzer analyzer;
+    if (analyzer.const_int_bound(s_int->i.max)->max_value < 0) return true;
+  }
+  return is_negative_const(ir::Simplify(s_int->i.max));
 }
 
 bool IntSet::can_prove_non_positive() const {
@@ -151,18 +161,14 @@ IntSet IntSet::interval(Expr min, Expr max) {
   return IntervalSet::make(min, max);
 }
 
-inline bool prove_equal(Expr lhs, Expr rhs) {
-  return is_zero(ir::Simplify(lhs - rhs));
-}
-
 // Check if a is created from b.
 bool IntSet::match_range(const Range& b) const {
   const IntSet& a = *this;
   const IntervalSet* a_int = a.as<IntervalSet>();
   if (!a_int) return false;
   const Interval& i = a_int->i;
-  return prove_equal(i.min, b->min) &&
-      prove_equal(i.max, ComputeExpr<Sub>(ComputeExpr<Add>(b->extent, b->min), 1));
+  return ProveEqual(i.min, b->min) &&
+      ProveEqual(i.max, ComputeExpr<Sub>(ComputeExpr<Add>(b->extent, b->min), 1));
 }
 
 inline bool MatchPoint(const IntSet& a,
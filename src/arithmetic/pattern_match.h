@@ -38,6 +38,8 @@
 
 #include <tvm/ir_pass.h>
 #include <tuple>
+#include <type_traits>
+#include "const_fold.h"
 
 namespace tvm {
 namespace arith {
@@ -109,6 +111,14 @@ class PEqualChecker<Expr> {
   }
 };
 
+template<>
+class PEqualChecker<Integer> {
+ public:
+  bool operator()(const Integer& lhs, const Integer& rhs) const {
+    return lhs->value == rhs->value;
+  }
+};
+
 /*!
  * \brief Pattern variable container.
  *
@@ -139,6 +149,18 @@ class PVar : public Pattern<PVar<T> > {
     }
   }
 
+  // Match a base class reference, e.g. PVar<Integer> against an Expr.
+  template<typename NodeRefType,
+           typename = typename std::enable_if<
+             std::is_base_of<NodeRefType, T>::value>::type>
+  bool Match_(const NodeRefType& value) const {
+    if (value.template as<typename T::ContainerType>()) {
+      return Match_(T(value.node_));
+    } else {
+      return false;
+    }
+  }
+
   T Eval() const {
     CHECK(filled_);
     return value_;
@@ -175,6 +197,56 @@ class PConst : public Pattern<PConst<T> > {
   const T value_;
 };
 
+/*!
+ * \brief Pattern of an integer constant that takes the type of another pattern.
+ * \tparam TA The pattern type of the operand that provides the type.
+ */
+template<typename TA>
+class PConstWithTypeLike :
+      public Pattern<PConstWithTypeLike<TA> > {
+ public:
+  PConstWithTypeLike(const TA& ref, int64_t value)
+      : ref_(ref), value_(value) {}
+
+  void InitMatch_() const {}
+
+  bool Match_(const NodeRef& node) const {
+    if (const ir::IntImm* ptr = node.as<ir::IntImm>()) {
+      return ptr->value == value_;
+    } else {
+      return false;
+    }
+  }
+
+  Expr Eval() const {
+    return make_const(ref_.Eval().type(), value_);
+  }
+
+ private:
+  typename TA::Nested ref_;
+  int64_t value_;
+};
+
+/*!
+ * \brief Construct a zero constant with the same type as the pattern.
+ * \param pattern The pattern that provides the type.
+ * \return The result pattern.
+ */
+template<typename TA>
+inline PConstWithTypeLike<TA> ZeroWithTypeLike(const Pattern<TA>& pattern) {
+  return PConstWithTypeLike<TA>(pattern.derived(), 0);
+}
+
+/*!
+ * \brief Construct a one constant with the same type as the pattern.
+ * \param pattern The pattern that provides the type.
+ * \return The result pattern.
+ */
+template<typename TA>
+inline PConstWithTypeLike<TA> OneWithTypeLike(const Pattern<TA>& pattern) {
+  return PConstWithTypeLike<TA>(pattern.derived(), 1);
+}
+
 /*!
  * \brief Pattern binary expression.
  * \tparam NodeType The AST node type.
@@ -203,7 +275,11 @@ class PBinaryExpr :
   }
 
   Expr Eval() const {
-    return NodeType::make(a_.Eval(), b_.Eval());
+    Expr lhs = a_.Eval();
+    Expr rhs = b_.Eval();
+    Expr ret = TryConstFold<NodeType>(lhs, rhs);
+    if (ret.defined()) return ret;
+    return NodeType::make(lhs, rhs);
   }
 
  private:
@@ -217,6 +293,18 @@ class PBinaryExpr :
   inline PBinaryExpr<NodeName, TA, TB>                        \
   FuncName(const Pattern<TA>& a, const Pattern<TB>& b) {      \
     return PBinaryExpr<NodeName, TA, TB>(a.derived(), b.derived()); \
+  }                                                           \
+  template<typename TA>                                       \
+  inline PBinaryExpr<NodeName, TA, PConstWithTypeLike<TA> >   \
+  FuncName(const Pattern<TA>& a, int64_t b) {                 \
+    return PBinaryExpr<NodeName, TA, PConstWithTypeLike<TA> >( \
+        a.derived(), PConstWithTypeLike<TA>(a.derived(), b));  \
+  }                                                           \
+  template<typename TA>                                       \
+  inline PBinaryExpr<NodeName, PConstWithTypeLike<TA>, TA>    \
+  FuncName(int64_t b, const Pattern<TA>& a) {                 \
+    return PBinaryExpr<NodeName, PConstWithTypeLike<TA>, TA>( \
+        PConstWithTypeLike<TA>(a.derived(), b), a.derived());  \
   }
 
 // arithmetic expressions
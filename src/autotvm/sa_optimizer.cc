@@ -0,0 +1,256 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file sa_optimizer.cc
+ * \brief Native simulated annealing over a config space,
+ *  scored by a tree ensemble cost model on knob features.
+ */
+
+#include <tvm/api_registry.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "tree_ensemble.h"
+
+namespace tvm {
+namespace autotvm {
+
+/*!
+ * \brief Knob feature of a config space.
+ *  The feature of a config is the concatenation of the feature of
+ *  the chosen entity of each knob, in the order of the knobs.
+ */
+struct KnobFeatureTable {
+  /*! \brief The number of choices of each knob. */
+  std::vector<int64_t> dims;
+  /*! \brief The start of the feature of knob i in the feature vector. */
+  std::vector<int64_t> fea_offset;
+  /*! \brief The feature length of each knob. */
+  std::vector<int64_t> width;
+  /*! \brief The start of the table of knob i in data. */
+  std::vector<int64_t> table_offset;
+  /*! \brief The features of all the choices of all the knobs. */
+  const float* data;
+  /*! \brief The length of the feature vector. */
+  int64_t length{0};
+
+  // write the feature of choice c of knob i into fea
+  void Fill(size_t i, int64_t c, float* fea) const {
+    const float* src = data + table_offset[i] + c * width[i];
+    std::copy(src, src + width[i], fea + fea_offset[i]);
+  }
+};
+
+/*! \brief A candidate point with its score. */
+struct ScoredPoint {
+  float score;
+  int64_t point;
+  bool operator<(const ScoredPoint& other) const {
+    return score > other.score;
+  }
+};
+
+/*!
+ * \brief Run simulated annealing on a group of chains.
+ * \param model The cost model.
+ * \param table The knob feature table.
+ * \param points The current point of each chain, updated in place.
+ * \param num_chain The number of chains.
+ * \param exclusive The points which should not be returned.
+ * \param num The number of returned maximum points.
+ * \param n_iter The number of iterations.
+ * \param early_stop Stop if the top points do not change in early_stop iterations.
+ * \param temp The initial and final temperature.
+ * \param seed The random seed.
+ * \return The top points found by the chains, ordered by descending score.
+ */
+std::vector<ScoredPoint> AnnealChains(const TreeEnsembleNode* model,
+                                      const KnobFeatureTable& table,
+                                      int64_t* points,
+                                      size_t num_chain,
+                                      const std::unordered_set<int64_t>& exclusive,
+                                      size_t num,
+                                      int n_iter,
+                                      int early_stop,
+                                      std::pair<double, double> temp,
+                                      uint64_t seed) {
+  size_t ndim = table.dims.size();
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  // the knobs, feature vector and score of each chain.
+  std::vector<std::vector<int64_t> > knobs(num_chain, std::vector<int64_t>(ndim));
+  std::vector<std::vector<float> > feas(num_chain, std::vector<float>(table.length));
+  std::vector<float> scores(num_chain);
+  std::vector<float> new_fea(table.length);
+
+  // min heap of the top points
+  std::vector<ScoredPoint> heap;
+  std::unordered_set<int64_t> in_heap;
+  auto push = [&](float score, int64_t point) {
+    if (num == 0) return false;
+    if (heap.size() == num && score <= heap.front().score) return false;
+    if (exclusive.count(point) || in_heap.count(point)) return false;
+    if (heap.size() == num) {
+      std::pop_heap(heap.begin(), heap.end());
+      in_heap.erase(heap.back().point);
+      heap.pop_back();
+    }
+    heap.push_back(ScoredPoint{score, point});
+    std::push_heap(heap.begin(), heap.end());
+    in_heap.insert(point);
+    return true;
+  };
+
+  for (size_t c = 0; c < num_chain; ++c) {
+    int64_t p = points[c];
+    for (size_t i = 0; i < ndim; ++i) {
+      knobs[c][i] = p % table.dims[i];
+      p /= table.dims[i];
+      table.Fill(i, knobs[c][i], feas[c].data());
+    }
+    scores[c] = model->Predict(feas[c].data(), static_cast<int>(table.length));
+    push(scores[c], points[c]);
+  }
+
+  // dimensions that can be mutated.
+  std::vector<size_t> mutable_dims;
+  for (size_t i = 0; i < ndim; ++i) {
+    if (table.dims[i] > 1) mutable_dims.push_back(i);
+  }
+  if (mutable_dims.empty()) n_iter = 0;
+
+  double t = temp.first;
+  double cool = (temp.first - temp.second) / (n_iter + 1);
+  int k_last_modify = 0;
+  for (int k = 0; k < n_iter && k < k_last_modify + early_stop; ++k) {
+    for (size_t c = 0; c < num_chain; ++c) {
+      // random walk: change the choice of one knob
+      size_t i = mutable_dims[rng() % mutable_dims.size()];
+      int64_t old_v = knobs[c][i];
+      int64_t new_v = static_cast<int64_t>(rng() % (table.dims[i] - 1));
+      if (new_v >= old_v) ++new_v;
+
+      std::copy(feas[c].begin(), feas[c].end(), new_fea.begin());
+      table.Fill(i, new_v, new_fea.data());
+      float new_score = model->Predict(new_fea.data(), static_cast<int>(table.length));
+
+      int64_t stride = 1;
+      for (size_t j = 0; j < i; ++j) stride *= table.dims[j];
+      int64_t new_point = points[c] + (new_v - old_v) * stride;
+
+      if (push(new_score, new_point)) k_last_modify = k;
+
+      double ac_prob = std::exp(std::min((new_score - scores[c]) / (t + 1e-5), 1.0));
+      if (uniform(rng) < ac_prob) {
+        knobs[c][i] = new_v;
+        feas[c].swap(new_fea);
+        scores[c] = new_score;
+        points[c] = new_point;
+      }
+    }
+    t -= cool;
+  }
+  std::sort(heap.begin(), heap.end());
+  return heap;
+}
+
+TVM_REGISTER_API("autotvm.tuner.SimulatedAnnealing")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+  TreeEnsemble model = args[0];
+  runtime::NDArray dims = args[1];
+  runtime::NDArray width = args[2];
+  runtime::NDArray table_data = args[3];
+  runtime::NDArray points = args[4];
+  runtime::NDArray exclusive = args[5];
+  int num = args[6];
+  int n_iter = args[7];
+  int early_stop = args[8];
+  double temp_begin = args[9];
+  double temp_end = args[10];
+  int num_threads = args[11];
+  int64_t seed = args[12];
+
+  auto check_array = [](const runtime::NDArray& arr, DLDataTypeCode code, int bits) {
+    CHECK_EQ(arr->ndim, 1) << "Expect a one dimensional array";
+    CHECK(arr->dtype.code == code && arr->dtype.bits == bits)
+        << "Unexpected dtype of simulated annealing argument";
+    CHECK_EQ(arr->ctx.device_type, kDLCPU) << "Expect a cpu array";
+  };
+  check_array(dims, kDLInt, 64);
+  check_array(width, kDLInt, 64);
+  check_array(table_data, kDLFloat, 32);
+  check_array(points, kDLInt, 64);
+  check_array(exclusive, kDLInt, 64);
+  CHECK_EQ(dims->shape[0], width->shape[0]);
+
+  KnobFeatureTable table;
+  const int64_t* pdims = static_cast<const int64_t*>(dims->data);
+  const int64_t* pwidth = static_cast<const int64_t*>(width->data);
+  table.dims.assign(pdims, pdims + dims->shape[0]);
+  table.width.assign(pwidth, pwidth + width->shape[0]);
+  int64_t table_size = 0;
+  for (size_t i = 0; i < table.dims.size(); ++i) {
+    CHECK_GE(table.dims[i], 1);
+    table.fea_offset.push_back(table.length);
+    table.table_offset.push_back(table_size);
+    table.length += table.width[i];
+    table_size += table.width[i] * table.dims[i];
+  }
+  CHECK_EQ(table_size, table_data->shape[0]) << "Knob feature table size mismatch";
+  table.data = static_cast<const float*>(table_data->data);
+
+  const int64_t* pexclusive = static_cast<const int64_t*>(exclusive->data);
+  std::unordered_set<int64_t> exclusive_set(pexclusive, pexclusive + exclusive->shape[0]);
+
+  // split the chains among the threads, each thread runs an
+  // independent group of chains and keeps its own top points.
+  size_t num_chain = static_cast<size_t>(points->shape[0]);
+  if (num_threads <= 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  size_t nthread = std::max<size_t>(1, std::min<size_t>(num_threads, num_chain));
+  int64_t* ppoints = static_cast<int64_t*>(points->data);
+  std::vector<std::vector<ScoredPoint> > results(nthread);
+  auto run = [&](size_t tid) {
+    size_t begin = num_chain * tid / nthread;
+    size_t end = num_chain * (tid + 1) / nthread;
+    results[tid] = AnnealChains(model.operator->(), table, ppoints + begin, end - begin,
+                                exclusive_set, num, n_iter, early_stop,
+                                {temp_begin, temp_end}, static_cast<uint64_t>(seed) + tid);
+  };
+  if (nthread == 1) {
+    run(0);
+  } else {
+    std::vector<std::thread> threads;
+    for (size_t tid = 0; tid < nthread; ++tid) {
+      threads.emplace_back(run, tid);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+
+  // merge the top points of all the threads
+  std::vector<ScoredPoint> merged;
+  for (const auto& res : results) {
+    merged.insert(merged.end(), res.begin(), res.end());
+  }
+  std::stable_sort(merged.begin(), merged.end());
+  std::vector<int64_t> top;
+  std::unordered_set<int64_t> added;
+  for (const auto& item : merged) {
+    if (top.size() == static_cast<size_t>(num)) break;
+    if (added.insert(item.point).second) top.push_back(item.point);
+  }
+  runtime::NDArray res = runtime::NDArray::Empty(
+      {static_cast<int64_t>(top.size())}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
+  std::copy(top.begin(), top.end(), static_cast<int64_t*>(res->data));
+  *ret = res;
+});
+
+}  // namespace autotvm
+}  // namespace tvm
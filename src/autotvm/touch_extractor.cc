@@ -6,9 +6,18 @@
 
 #include "touch_extractor.h"
 
+#include <tvm/buffer.h>
+#include <tvm/ir_pass.h>
+#include <tvm/operation.h>
+#include <tvm/schedule_pass.h>
+#include <tvm/runtime/ndarray.h>
 #include <set>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace tvm {
 namespace autotvm {
@@ -463,6 +472,94 @@ void GetCurveSampleFeatureFlatten(Stmt stmt, int sample_n, std::vector<float> *r
 }
 
 
+/*!
+ * \brief Lower a schedule while keeping all axes in IR.
+ *  This is the same as autotvm.feature.ana_lower in python.
+ * \param sch The schedule to be lowered
+ * \param args The buffer args for lower
+ * \return The lowered statement
+ */
+Stmt AnaLower(Schedule sch, const Array<Tensor>& args) {
+  Map<Tensor, Buffer> binds;
+  for (const auto& x : args) {
+    binds.Set(x, decl_buffer(x->shape, x->dtype, x->op->name));
+  }
+  sch = sch.normalize();
+  auto bounds = schedule::InferBound(sch);
+  Stmt stmt = schedule::ScheduleOps(sch, bounds, true);
+  stmt = ir::StorageFlatten(stmt, binds, 64);
+  stmt = ir::CanonicalSimplify(stmt);
+  return stmt;
+}
+
+/*!
+ * \brief Lower a batch of schedules and extract their flatten features
+ *  on a pool of threads.
+ * \param schs The schedules to be extracted
+ * \param args The buffer args for lower, one array for each schedule
+ * \param num_threads The number of threads, 0 means the number of cores
+ * \param fextract The function that extracts features from a lowered statement
+ * \return A float32 matrix, one row for each schedule.
+ *  Shorter rows are padded with zeros.
+ */
+runtime::NDArray GetFeatureFlattenBatch(
+    const Array<Schedule>& schs,
+    const Array<Array<Tensor> >& args,
+    int num_threads,
+    std::function<void(Stmt, std::vector<float>*)> fextract) {
+  CHECK_EQ(schs.size(), args.size())
+      << "Expect one argument list for each schedule";
+  size_t n = schs.size();
+  if (num_threads <= 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  num_threads = static_cast<int>(std::min(static_cast<size_t>(num_threads), n));
+
+  std::vector<std::vector<float> > rows(n);
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    for (size_t i = next++; i < n; i = next++) {
+      try {
+        fextract(AnaLower(schs[i], args[i]), &rows[i]);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+        next = n;
+      }
+    }
+  };
+  if (num_threads <= 1) {
+    worker();
+  } else {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+      threads.emplace_back(worker);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+
+  size_t width = 0;
+  for (const auto& row : rows) {
+    width = std::max(width, row.size());
+  }
+  runtime::NDArray ret = runtime::NDArray::Empty(
+      {static_cast<int64_t>(n), static_cast<int64_t>(width)},
+      DLDataType{kDLFloat, 32, 1}, DLContext{kDLCPU, 0});
+  float* data = static_cast<float*>(ret->data);
+  for (size_t i = 0; i < n; ++i) {
+    float* dst = data + i * width;
+    std::copy(rows[i].begin(), rows[i].end(), dst);
+    std::fill(dst + rows[i].size(), dst + width, 0.0f);
+  }
+  return ret;
+}
+
+
 // register API for front end
 TVM_REGISTER_API("autotvm.feature.GetItervarFeature")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
@@ -494,10 +591,10 @@ TVM_REGISTER_API("autotvm.feature.GetItervarFeatureFlatten")
 TVM_REGISTER_API("autotvm.feature.GetCurveSampleFeatureFlatten")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
   Stmt stmt = args[0];
-  bool take_log = args[1];
+  int sample_n = args[1];
   std::vector<float> ret_feature;
 
-  GetCurveSampleFeatureFlatten(stmt, take_log, &ret_feature);
+  GetCurveSampleFeatureFlatten(stmt, sample_n, &ret_feature);
 
   TVMByteArray arr;
   arr.size = sizeof(float) * ret_feature.size();
@@ -506,5 +603,35 @@ TVM_REGISTER_API("autotvm.feature.GetCurveSampleFeatureFlatten")
 });
 
 
+TVM_REGISTER_API("autotvm.feature.GetItervarFeatureFlattenBatch")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+  Array<Schedule> schs = args[0];
+  Array<Array<Tensor> > sch_args = args[1];
+  bool take_log = args[2];
+  int num_threads = args[3];
+
+  *ret = GetFeatureFlattenBatch(
+      schs, sch_args, num_threads,
+      [take_log](Stmt stmt, std::vector<float> *ret_feature) {
+        GetItervarFeatureFlatten(stmt, take_log, ret_feature);
+      });
+});
+
+
+TVM_REGISTER_API("autotvm.feature.GetCurveSampleFeatureFlattenBatch")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+  Array<Schedule> schs = args[0];
+  Array<Array<Tensor> > sch_args = args[1];
+  int sample_n = args[2];
+  int num_threads = args[3];
+
+  *ret = GetFeatureFlattenBatch(
+      schs, sch_args, num_threads,
+      [sample_n](Stmt stmt, std::vector<float> *ret_feature) {
+        GetCurveSampleFeatureFlatten(stmt, sample_n, ret_feature);
+      });
+});
+
+
 }  // namespace autotvm
 }  // namespace tvm
@@ -0,0 +1,98 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file tree_ensemble.cc
+ * \brief Native inference of tree ensemble cost models
+ */
+
+#include <tvm/api_registry.h>
+#include <algorithm>
+#include "tree_ensemble.h"
+
+namespace tvm {
+namespace autotvm {
+
+TVM_REGISTER_NODE_TYPE(TreeEnsembleNode);
+
+template<typename T>
+std::vector<T> ToVector(const runtime::NDArray& arr, DLDataType dtype) {
+  CHECK_EQ(arr->ndim, 1) << "Expect a one dimensional array";
+  CHECK(arr->dtype.code == dtype.code && arr->dtype.bits == dtype.bits)
+      << "Unexpected dtype of tree ensemble array";
+  CHECK_EQ(arr->ctx.device_type, kDLCPU) << "Expect a cpu array";
+  const T* data = reinterpret_cast<const T*>(
+      static_cast<const char*>(arr->data) + arr->byte_offset);
+  return std::vector<T>(data, data + arr->shape[0]);
+}
+
+TreeEnsemble TreeEnsembleNode::make(runtime::NDArray tree_root,
+                                    runtime::NDArray split_feature,
+                                    runtime::NDArray threshold,
+                                    runtime::NDArray left,
+                                    runtime::NDArray right,
+                                    runtime::NDArray missing,
+                                    runtime::NDArray leaf_value,
+                                    double base_margin) {
+  const DLDataType i32{kDLInt, 32, 1}, f32{kDLFloat, 32, 1};
+  NodePtr<TreeEnsembleNode> node = make_node<TreeEnsembleNode>();
+  node->tree_root = ToVector<int32_t>(tree_root, i32);
+  node->split_feature = ToVector<int32_t>(split_feature, i32);
+  node->threshold = ToVector<float>(threshold, f32);
+  node->left = ToVector<int32_t>(left, i32);
+  node->right = ToVector<int32_t>(right, i32);
+  node->missing = ToVector<int32_t>(missing, i32);
+  node->leaf_value = ToVector<float>(leaf_value, f32);
+  node->num_tree = static_cast<int>(node->tree_root.size());
+  node->num_node = static_cast<int>(node->left.size());
+  node->base_margin = base_margin;
+
+  // validate the trees, so that Predict does not need to check.
+  int n = node->num_node;
+  CHECK(node->split_feature.size() == node->left.size() &&
+        node->threshold.size() == node->left.size() &&
+        node->right.size() == node->left.size() &&
+        node->missing.size() == node->left.size() &&
+        node->leaf_value.size() == node->left.size())
+      << "All node arrays of a tree ensemble must have the same length";
+  for (int32_t root : node->tree_root) {
+    CHECK(root >= 0 && root < n) << "Invalid tree root " << root;
+  }
+  for (int i = 0; i < n; ++i) {
+    if (node->left[i] == -1) continue;
+    // children are stored after their parent, this also rules out cycles.
+    CHECK(node->left[i] > i && node->left[i] < n &&
+          node->right[i] > i && node->right[i] < n &&
+          node->missing[i] > i && node->missing[i] < n)
+        << "Invalid children of tree node " << i;
+    CHECK_GE(node->split_feature[i], 0);
+  }
+  return TreeEnsemble(node);
+}
+
+TVM_REGISTER_API("autotvm.tuner._make_TreeEnsemble")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+  *ret = TreeEnsembleNode::make(args[0], args[1], args[2], args[3],
+                                args[4], args[5], args[6], args[7]);
+});
+
+TVM_REGISTER_API("autotvm.tuner.TreeEnsemblePredict")
+.set_body_typed<runtime::NDArray(TreeEnsemble, runtime::NDArray)>(
+    [](TreeEnsemble model, runtime::NDArray feas) {
+  CHECK_EQ(feas->ndim, 2) << "Expect a two dimensional feature matrix";
+  CHECK(feas->dtype.code == kDLFloat && feas->dtype.bits == 32)
+      << "Expect float32 features";
+  CHECK_EQ(feas->ctx.device_type, kDLCPU) << "Expect a cpu array";
+  int64_t n = feas->shape[0];
+  int len = static_cast<int>(feas->shape[1]);
+  const float* data = reinterpret_cast<const float*>(
+      static_cast<const char*>(feas->data) + feas->byte_offset);
+  runtime::NDArray ret = runtime::NDArray::Empty(
+      {n}, DLDataType{kDLFloat, 32, 1}, DLContext{kDLCPU, 0});
+  float* out = static_cast<float*>(ret->data);
+  for (int64_t i = 0; i < n; ++i) {
+    out[i] = model->Predict(data + i * len, len);
+  }
+  return ret;
+});
+
+}  // namespace autotvm
+}  // namespace tvm
@@ -0,0 +1,110 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file tree_ensemble.h
+ * \brief Native inference of tree ensemble cost models
+ */
+
+#ifndef TVM_AUTOTVM_TREE_ENSEMBLE_H_
+#define TVM_AUTOTVM_TREE_ENSEMBLE_H_
+
+#include <tvm/base.h>
+#include <tvm/runtime/ndarray.h>
+#include <vector>
+
+namespace tvm {
+namespace autotvm {
+
+class TreeEnsemble;
+
+/*!
+ * \brief A trained tree ensemble (e.g. exported from xgboost).
+ *
+ *  All the nodes of all the trees are stored in flat arrays.
+ *  Node i is a leaf if left[i] == -1, otherwise it goes to left[i]
+ *  when feature[split_feature[i]] < threshold[i] and to right[i] otherwise.
+ *  Missing features (index out of range) go to missing[i].
+ */
+class TreeEnsembleNode : public Node {
+ public:
+  /*! \brief The number of trees. */
+  int num_tree;
+  /*! \brief The number of nodes. */
+  int num_node;
+  /*! \brief The constant added to the sum of the leaves. */
+  double base_margin;
+
+  /*! \brief The root node of each tree. */
+  std::vector<int32_t> tree_root;
+  /*! \brief The feature index used to split each node. */
+  std::vector<int32_t> split_feature;
+  /*! \brief The split threshold of each node. */
+  std::vector<float> threshold;
+  /*! \brief The node taken when the feature is less than the threshold. */
+  std::vector<int32_t> left;
+  /*! \brief The node taken when the feature is not less than the threshold. */
+  std::vector<int32_t> right;
+  /*! \brief The node taken when the feature is missing. */
+  std::vector<int32_t> missing;
+  /*! \brief The value of each leaf node. */
+  std::vector<float> leaf_value;
+
+  void VisitAttrs(tvm::AttrVisitor* v) final {
+    v->Visit("num_tree", &num_tree);
+    v->Visit("num_node", &num_node);
+    v->Visit("base_margin", &base_margin);
+  }
+
+  /*!
+   * \brief Predict the margin of one feature vector.
+   * \param fea The feature vector.
+   * \param len The length of the feature vector.
+   * \return The predicted margin.
+   */
+  float Predict(const float* fea, int len) const {
+    double sum = base_margin;
+    for (int32_t root : tree_root) {
+      int32_t nid = root;
+      while (left[nid] != -1) {
+        int32_t f = split_feature[nid];
+        if (f >= len) {
+          nid = missing[nid];
+        } else {
+          nid = fea[f] < threshold[nid] ? left[nid] : right[nid];
+        }
+      }
+      sum += leaf_value[nid];
+    }
+    return static_cast<float>(sum);
+  }
+
+  /*!
+   * \brief Construct a tree ensemble from flat node arrays.
+   * \param tree_root The root node of each tree, int32.
+   * \param split_feature The split feature of each node, int32.
+   * \param threshold The split threshold of each node, float32.
+   * \param left The left child of each node, -1 for leaf, int32.
+   * \param right The right child of each node, int32.
+   * \param missing The child taken on missing feature, int32.
+   * \param leaf_value The value of each leaf, float32.
+   * \param base_margin The constant added to the sum of the leaves.
+   * \return The created tree ensemble.
+   */
+  TVM_DLL static TreeEnsemble make(runtime::NDArray tree_root,
+                                  runtime::NDArray split_feature,
+                                  runtime::NDArray threshold,
+                                  runtime::NDArray left,
+                                  runtime::NDArray right,
+                                  runtime::NDArray missing,
+                                  runtime::NDArray leaf_value,
+                                  double base_margin);
+
+  static constexpr const char* _type_key = "autotvm.TreeEnsemble";
+  TVM_DECLARE_NODE_TYPE_INFO(TreeEnsembleNode, Node);
+};
+
+TVM_DEFINE_NODE_REF(TreeEnsemble, TreeEnsembleNode);
+
+}  // namespace autotvm
+}  // namespace tvm
+
+#endif  // TVM_AUTOTVM_TREE_ENSEMBLE_H_
@@ -8,6 +8,7 @@
 #include <tvm/operation.h>
 #include <tvm/ir_pass.h>
 #include <tvm/codegen.h>
+#include <tvm/pass_profiler.h>
 
 #include <algorithm>
 #include <mutex>
@@ -361,34 +362,68 @@ Stmt BuildStmt(Schedule sch,
   sch = sch.normalize();
 
   // Phase 0
-  auto bounds = schedule::InferBound(sch);
-  auto stmt = schedule::ScheduleOps(sch, bounds, false);
-  stmt = ir::InjectPrefetch(stmt);
+  auto bounds = ProfilePass("InferBound", sch, [&]() {
+      return schedule::InferBound(sch);
+    });
+  auto stmt = ProfilePass("ScheduleOps", sch, [&]() {
+      return schedule::ScheduleOps(sch, bounds, false);
+    });
+  stmt = ProfilePass("InjectPrefetch", stmt, [&]() {
+      return ir::InjectPrefetch(stmt);
+    });
 
   // Phase 1
-  stmt = ir::StorageFlatten(stmt, out_binds, 64,
-                            config->instrument_bound_checkers);
-  stmt = ir::CanonicalSimplify(stmt);
+  stmt = ProfilePass("StorageFlatten", stmt, [&]() {
+      return ir::StorageFlatten(stmt, out_binds, 64,
+                                config->instrument_bound_checkers);
+    });
+  stmt = ProfilePass("CanonicalSimplify", stmt, [&]() {
+      return ir::CanonicalSimplify(stmt);
+    });
   if (loop_partition) {
-    stmt = ir::LoopPartition(stmt, config->partition_const_loop);
-  }
-  stmt = ir::VectorizeLoop(stmt);
-  stmt = ir::InjectVirtualThread(stmt);
-  stmt = ir::InjectDoubleBuffer(stmt, config->double_buffer_split_loop);
-  stmt = ir::StorageRewrite(stmt);
-  stmt = ir::UnrollLoop(stmt, config->auto_unroll_max_step, config->auto_unroll_max_depth,
-    config->auto_unroll_max_extent, config->unroll_explicit);
+    stmt = ProfilePass("LoopPartition", stmt, [&]() {
+        return ir::LoopPartition(stmt, config->partition_const_loop);
+      });
+  }
+  stmt = ProfilePass("VectorizeLoop", stmt, [&]() {
+      return ir::VectorizeLoop(stmt);
+    });
+  stmt = ProfilePass("InjectVirtualThread", stmt, [&]() {
+      return ir::InjectVirtualThread(stmt);
+    });
+  stmt = ProfilePass("InjectDoubleBuffer", stmt, [&]() {
+      return ir::InjectDoubleBuffer(stmt, config->double_buffer_split_loop);
+    });
+  stmt = ProfilePass("StorageRewrite", stmt, [&]() {
+      return ir::StorageRewrite(stmt);
+    });
+  stmt = ProfilePass("UnrollLoop", stmt, [&]() {
+      return ir::UnrollLoop(stmt, config->auto_unroll_max_step, config->auto_unroll_max_depth,
+                            config->auto_unroll_max_extent, config->unroll_explicit);
+    });
 
   // Phase 2
-  stmt = ir::Simplify(stmt);
-  stmt = ir::LowerStorageAccessInfo(stmt);
-  stmt = ir::RemoveNoOp(stmt);
-
-  if (!(config->disable_select_rewriting))
-    stmt = ir::RewriteUnsafeSelect(stmt);
-
-  if (config->instrument_bound_checkers)
-    stmt = ir::InstrumentBoundCheckers(stmt);
+  stmt = ProfilePass("Simplify", stmt, [&]() {
+      return ir::Simplify(stmt);
+    });
+  stmt = ProfilePass("LowerStorageAccessInfo", stmt, [&]() {
+      return ir::LowerStorageAccessInfo(stmt);
+    });
+  stmt = ProfilePass("RemoveNoOp", stmt, [&]() {
+      return ir::RemoveNoOp(stmt);
+    });
+
+  if (!(config->disable_select_rewriting)) {
+    stmt = ProfilePass("RewriteUnsafeSelect", stmt, [&]() {
+        return ir::RewriteUnsafeSelect(stmt);
+      });
+  }
+
+  if (config->instrument_bound_checkers) {
+    stmt = ProfilePass("InstrumentBoundCheckers", stmt, [&]() {
+        return ir::InstrumentBoundCheckers(stmt);
+      });
+  }
 
   return stmt;
 }
@@ -0,0 +1,381 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file kernel_cache.cc
+ * \brief Persistent on-disk cache of lowered kernels.
+ */
+#include <dmlc/json.h>
+#include <tvm/build_module.h>
+#include <tvm/api_registry.h>
+#include <tvm/ir_operator.h>
+#include <tvm/runtime/c_runtime_api.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include "kernel_cache.h"
+#include "../runtime/file_util.h"
+
+#ifndef TVM_GIT_HASH
+#define TVM_GIT_HASH "unknown"
+#endif
+
+namespace tvm {
+namespace codegen {
+
+namespace {
+/*! \brief Version of the entry format, bump when it changes. */
+constexpr const char* kEntryVersion = "0.1";
+/*! \brief Default size limit of the cache. */
+constexpr int64_t kDefaultMaxBytes = 1LL << 30;
+/*! \brief Age in seconds after which a left over temporary file is removed. */
+constexpr int64_t kStaleTempSeconds = 3600;
+
+// FNV-1a hash, stable across processes and platforms.
+uint64_t StableHash(const std::string& data, uint64_t seed) {
+  uint64_t h = seed;
+  for (char c : data) {
+    h ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// 128 bit digest of the key, used as the entry file name.
+std::string Digest(const std::string& key) {
+  char buf[33];
+  snprintf(buf, sizeof(buf), "%016llx%016llx",
+           static_cast<unsigned long long>(StableHash(key, 14695981039346656037ULL)),  // NOLINT(*)
+           static_cast<unsigned long long>(StableHash(key, 7809847782465536322ULL)));  // NOLINT(*)
+  return std::string(buf);
+}
+
+/*! \brief Content of a cache entry. */
+struct CacheEntry {
+  std::string version;
+  std::string key;
+  std::string func_name;
+  std::string funcs;
+
+  void Save(dmlc::JSONWriter* writer) const {
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("version", version);
+    writer->WriteObjectKeyValue("key", key);
+    writer->WriteObjectKeyValue("func_name", func_name);
+    writer->WriteObjectKeyValue("funcs", funcs);
+    writer->EndObject();
+  }
+
+  void Load(dmlc::JSONReader* reader) {
+    dmlc::JSONObjectReadHelper helper;
+    helper.DeclareField("version", &version);
+    helper.DeclareField("key", &key);
+    helper.DeclareField("func_name", &func_name);
+    helper.DeclareField("funcs", &funcs);
+    helper.ReadAllFields(reader);
+  }
+};
+
+#ifndef _WIN32
+// Create directory and its parents.
+bool MakeDirs(const std::string& path) {
+  struct stat sb;
+  if (stat(path.c_str(), &sb) == 0) return S_ISDIR(sb.st_mode);
+  size_t pos = path.find_last_of('/');
+  if (pos != std::string::npos && pos != 0) {
+    if (!MakeDirs(path.substr(0, pos))) return false;
+  }
+  return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+// Returns true if name ends with suffix.
+bool EndsWith(const std::string& name, const std::string& suffix) {
+  return name.length() >= suffix.length() &&
+      name.compare(name.length() - suffix.length(), suffix.length(), suffix) == 0;
+}
+#endif
+}  // namespace
+
+KernelCache::KernelCache() : max_bytes_(kDefaultMaxBytes) {
+  if (const char* size = getenv("TVM_KERNEL_CACHE_SIZE_MB")) {
+    max_bytes_ = static_cast<int64_t>(atoll(size)) << 20;
+  }
+  if (const char* path = getenv("TVM_KERNEL_CACHE_DIR")) {
+    this->Configure(path, max_bytes_);
+  }
+}
+
+void KernelCache::Configure(const std::string& path, int64_t max_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_bytes_ = max_bytes;
+  path_.clear();
+  if (path.empty()) return;
+#ifdef _WIN32
+  LOG(WARNING) << "Kernel cache is not supported on Windows";
+#else
+  if (!MakeDirs(path)) {
+    LOG(WARNING) << "Cannot create kernel cache directory " << path
+                 << ", kernel cache is disabled";
+    return;
+  }
+  path_ = path;
+#endif
+}
+
+bool KernelCache::enabled() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !path_.empty();
+}
+
+std::string KernelCache::MakeKey(const Schedule& sch,
+                                 const Array<Tensor>& args,
+                                 const std::string& target) {
+  BuildConfig config = BuildConfig::Current();
+  // Custom lower passes are opaque functions and cannot be keyed.
+  if (config->add_lower_pass.size() != 0) return "";
+  Array<NodeRef> content{sch, args, config};
+  std::ostringstream os;
+  // the lowering passes change between compiler builds.
+  os << "tvm=" << TVM_VERSION << ' ' << TVM_GIT_HASH << '\n'
+     << "target=" << target << '\n'
+     << SaveJSON(content);
+  return os.str();
+}
+
+std::string KernelCache::EntryPath(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (path_.empty()) return "";
+  return path_ + "/" + Digest(key) + ".json";
+}
+
+bool KernelCache::Lookup(const std::string& key,
+                         const std::string& func_name,
+                         Array<LoweredFunc>* funcs) {
+  std::string path = EntryPath(key);
+  if (path.empty() || key.empty()) return false;
+  CacheEntry entry;
+  Array<LoweredFunc> result;
+  bool hit = false;
+  std::ifstream fs(path.c_str());
+  if (!fs.fail()) {
+    try {
+      dmlc::JSONReader reader(&fs);
+      entry.Load(&reader);
+      if (entry.version == kEntryVersion && entry.key == key) {
+        result = LoadJSON<Array<LoweredFunc> >(entry.funcs);
+        hit = true;
+      }
+    } catch (const std::exception&) {
+      LOG(WARNING) << "Ignore corrupted kernel cache entry " << path;
+    }
+  }
+  if (hit) {
+    if (entry.func_name != func_name) {
+      // The host function of a multi-function kernel refers to its
+      // device functions by name, only rename single functions.
+      if (result.size() == 1 && result[0]->name == entry.func_name) {
+        auto n = make_node<LoweredFuncNode>(*result[0].operator->());
+        n->name = func_name;
+        result = Array<LoweredFunc>({LoweredFunc(n)});
+      } else {
+        hit = false;
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!hit) {
+    ++stats_.misses;
+    return false;
+  }
+#ifndef _WIN32
+  // refresh the access time used by the eviction.
+  utime(path.c_str(), nullptr);
+#endif
+  ++stats_.hits;
+  *funcs = result;
+  return true;
+}
+
+void KernelCache::Insert(const std::string& key,
+                         const std::string& func_name,
+                         const Array<LoweredFunc>& funcs) {
+  std::string path = EntryPath(key);
+  if (path.empty() || key.empty()) return;
+#ifndef _WIN32
+  std::string cache_dir;
+  int64_t max_bytes;
+  std::ostringstream tmp_path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_dir = path_;
+    max_bytes = max_bytes_;
+    tmp_path << path << ".tmp." << getpid() << "." << tmp_counter_++;
+  }
+  CacheEntry entry;
+  entry.version = kEntryVersion;
+  entry.key = key;
+  entry.func_name = func_name;
+  entry.funcs = SaveJSON(funcs);
+  {
+    std::ofstream fs(tmp_path.str().c_str());
+    if (fs.fail()) {
+      LOG(WARNING) << "Cannot write kernel cache entry " << tmp_path.str();
+      return;
+    }
+    dmlc::JSONWriter writer(&fs);
+    entry.Save(&writer);
+  }
+  // rename is atomic, readers either see the old or the new entry.
+  if (std::rename(tmp_path.str().c_str(), path.c_str()) != 0) {
+    runtime::RemoveFile(tmp_path.str());
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.inserts;
+  }
+  this->Evict(cache_dir, max_bytes);
+#endif
+}
+
+void KernelCache::Evict(const std::string& path, int64_t max_bytes) {
+#ifndef _WIN32
+  std::string lock_path = path + "/.lock";
+  int lock_fd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (lock_fd < 0) return;
+  if (flock(lock_fd, LOCK_EX) != 0) {
+    close(lock_fd);
+    return;
+  }
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    flock(lock_fd, LOCK_UN);
+    close(lock_fd);
+    return;
+  }
+  std::vector<std::pair<time_t, std::string> > entries;
+  std::vector<int64_t> sizes;
+  int64_t total_bytes = 0;
+  time_t now = time(nullptr);
+  while (struct dirent* ent = readdir(dir)) {
+    std::string name = ent->d_name;
+    std::string file = path + "/" + name;
+    struct stat sb;
+    if (stat(file.c_str(), &sb) != 0 || !S_ISREG(sb.st_mode)) continue;
+    if (EndsWith(name, ".json")) {
+      entries.emplace_back(sb.st_mtime, file);
+      sizes.push_back(static_cast<int64_t>(sb.st_size));
+      total_bytes += static_cast<int64_t>(sb.st_size);
+    } else if (name.find(".json.tmp.") != std::string::npos &&
+               now - sb.st_mtime > kStaleTempSeconds) {
+      // left over by a process that died while writing.
+      runtime::RemoveFile(file);
+    }
+  }
+  closedir(dir);
+  int64_t num_evicted = 0;
+  if (total_bytes > max_bytes) {
+    std::vector<size_t> order(entries.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&entries](size_t a, size_t b) {
+        return entries[a].first < entries[b].first;
+      });
+    for (size_t i : order) {
+      if (total_bytes <= max_bytes) break;
+      runtime::RemoveFile(entries[i].second);
+      total_bytes -= sizes[i];
+      ++num_evicted;
+    }
+  }
+  flock(lock_fd, LOCK_UN);
+  close(lock_fd);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.evictions += num_evicted;
+#endif
+}
+
+void KernelCache::Clear() {
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    path = path_;
+  }
+  if (path.empty()) return;
+  this->Evict(path, 0);
+}
+
+KernelCache::Stats KernelCache::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+KernelCache* KernelCache::Global() {
+  // intentionally allocate raw pointer to avoid
+  // free during destructuion.
+  static KernelCache* inst = new KernelCache();
+  return inst;
+}
+
+TVM_REGISTER_API("codegen._KernelCacheConfig")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    KernelCache::Global()->Configure(args[0], args[1]);
+  });
+
+TVM_REGISTER_API("codegen._KernelCacheClear")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    KernelCache::Global()->Clear();
+  });
+
+TVM_REGISTER_API("codegen._KernelCacheStats")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    KernelCache::Stats stats = KernelCache::Global()->GetStats();
+    Map<std::string, Expr> res;
+    res.Set("hits", make_const(Int(64), stats.hits));
+    res.Set("misses", make_const(Int(64), stats.misses));
+    res.Set("inserts", make_const(Int(64), stats.inserts));
+    res.Set("evictions", make_const(Int(64), stats.evictions));
+    *ret = res;
+  });
+
+// Key(schedule, args, target), returns empty string if the cache is disabled.
+TVM_REGISTER_API("codegen._KernelCacheKey")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    KernelCache* cache = KernelCache::Global();
+    std::string key;
+    if (cache->enabled()) {
+      key = cache->MakeKey(args[0], args[1], args[2]);
+    }
+    *ret = key;
+  });
+
+// Lookup(key, func_name), returns empty array on miss.
+TVM_REGISTER_API("codegen._KernelCacheLookup")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    Array<LoweredFunc> funcs;
+    KernelCache::Global()->Lookup(args[0], args[1], &funcs);
+    *ret = funcs;
+  });
+
+// Insert(key, func_name, funcs)
+TVM_REGISTER_API("codegen._KernelCacheInsert")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    KernelCache::Global()->Insert(args[0], args[1], args[2]);
+  });
+
+}  // namespace codegen
+}  // namespace tvm
@@ -0,0 +1,126 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file kernel_cache.h
+ * \brief Persistent on-disk cache of lowered kernels.
+ */
+#ifndef TVM_CODEGEN_KERNEL_CACHE_H_
+#define TVM_CODEGEN_KERNEL_CACHE_H_
+
+#include <tvm/schedule.h>
+#include <tvm/lowered_func.h>
+#include <mutex>
+#include <string>
+
+namespace tvm {
+namespace codegen {
+
+/*!
+ * \brief Content addressed disk cache of lowered functions.
+ *
+ *  An entry is keyed by a stable digest of the serialized schedule,
+ *  its arguments, the target string, the current build config and the
+ *  TVM version and git commit of the library, so that a kernel lowered
+ *  in one process can be reused by the next build of the same compiler.
+ *  A corrupted entry counts as a miss.
+ *
+ *  Several processes can share one cache directory. Entries are
+ *  published with an atomic rename, and the least recently used
+ *  entries are evicted under a file lock once the directory grows
+ *  beyond the size limit.
+ *
+ *  The cache is disabled unless TVM_KERNEL_CACHE_DIR is set
+ *  or Configure is called with a non-empty path.
+ *
+ *  \note Only the lowering is cached. The kernels of a graph are
+ *  compiled together into one module by the target code generator,
+ *  which a warm build still runs for every kernel. A compiled kernel
+ *  cannot be cached on its own because host modules cannot be merged
+ *  after code generation and still be exported as one library.
+ */
+class KernelCache {
+ public:
+  /*! \brief Cache statistics of the current process. */
+  struct Stats {
+    /*! \brief Number of successful lookups. */
+    int64_t hits{0};
+    /*! \brief Number of failed lookups. */
+    int64_t misses{0};
+    /*! \brief Number of entries written. */
+    int64_t inserts{0};
+    /*! \brief Number of entries removed by eviction. */
+    int64_t evictions{0};
+  };
+  /*!
+   * \brief Set the location and the size limit of the cache.
+   * \param path The cache directory, empty string disables the cache.
+   * \param max_bytes The maximum total size of the cached entries.
+   */
+  void Configure(const std::string& path, int64_t max_bytes);
+  /*! \return Whether the cache is enabled. */
+  bool enabled();
+  /*!
+   * \brief Create the key of a kernel.
+   * \param sch The schedule to be lowered.
+   * \param args The arguments of the lowered function.
+   * \param target The target string.
+   * \return The key, empty if the kernel cannot be cached.
+   */
+  std::string MakeKey(const Schedule& sch,
+                      const Array<Tensor>& args,
+                      const std::string& target);
+  /*!
+   * \brief Look up a kernel in the cache.
+   * \param key The key created by MakeKey.
+   * \param func_name The name the lowered function should carry.
+   * \param funcs The lowered functions, set on a hit.
+   * \return Whether the lookup is a hit.
+   */
+  bool Lookup(const std::string& key,
+              const std::string& func_name,
+              Array<LoweredFunc>* funcs);
+  /*!
+   * \brief Store a kernel in the cache.
+   * \param key The key created by MakeKey.
+   * \param func_name The name of the lowered function.
+   * \param funcs The lowered functions.
+   */
+  void Insert(const std::string& key,
+              const std::string& func_name,
+              const Array<LoweredFunc>& funcs);
+  /*! \brief Remove all entries from the cache directory. */
+  void Clear();
+  /*! \return The statistics of the cache. */
+  Stats GetStats();
+  /*! \return The global kernel cache. */
+  static KernelCache* Global();
+
+ private:
+  KernelCache();
+  /*!
+   * \brief Get the entry path of a key.
+   * \param key The key of the entry.
+   * \return The path, empty if the cache is disabled.
+   */
+  std::string EntryPath(const std::string& key);
+  /*!
+   * \brief Remove least recently used entries until
+   *  the cache fits into max_bytes_.
+   * \param path The cache directory.
+   * \param max_bytes The size limit.
+   */
+  void Evict(const std::string& path, int64_t max_bytes);
+  /*! \brief The internal lock */
+  std::mutex mutex_;
+  /*! \brief The cache directory */
+  std::string path_;
+  /*! \brief The size limit in bytes */
+  int64_t max_bytes_;
+  /*! \brief The statistics */
+  Stats stats_;
+  /*! \brief Counter used to create unique temporary files */
+  int64_t tmp_counter_{0};
+};
+
+}  // namespace codegen
+}  // namespace tvm
+#endif  // TVM_CODEGEN_KERNEL_CACHE_H_
@@ -6,7 +6,12 @@
 #ifdef TVM_LLVM_VERSION
 #include <tvm/runtime/packed_func.h>
 #include <tvm/codegen.h>
+#include <cstdlib>
+#include <functional>
 #include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 #include "llvm_common.h"
 #include "codegen_llvm.h"
 #include "../../runtime/file_util.h"
@@ -19,9 +24,41 @@ using runtime::TVMArgs;
 using runtime::TVMRetValue;
 using runtime::PackedFunc;
 
+/*!
+ * \brief The JIT strategy of LLVMModuleNode, selected by TVM_LLVM_JIT_MODE.
+ *
+ *  eager: compile the whole module on the first GetFunction.
+ *  lazy: compile each exported function on its first GetFunction.
+ *  lazy_async: same as lazy, and compile the remaining functions
+ *    on a background thread after the first one is ready.
+ */
+enum LLVMJITMode : int {
+  kEagerJIT = 0,
+  kLazyJIT = 1,
+  kLazyAsyncJIT = 2
+};
+
+inline LLVMJITMode GetLLVMJITMode() {
+  const char* val = getenv("TVM_LLVM_JIT_MODE");
+  if (val == nullptr) return kEagerJIT;
+  std::string mode = val;
+  if (mode == "lazy") return kLazyJIT;
+  if (mode == "lazy_async") return kLazyAsyncJIT;
+  LOG_IF(WARNING, mode != "eager" && mode.length() != 0)
+      << "Unknown TVM_LLVM_JIT_MODE " << mode << ", use eager";
+  return kEagerJIT;
+}
+
 class LLVMModuleNode final : public runtime::ModuleNode {
  public:
   ~LLVMModuleNode() {
+    if (async_thread_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        async_stop_ = true;
+      }
+      async_thread_.join();
+    }
     module_.reset();
     if (ee_ != nullptr) {
       ee_->runStaticConstructorsDestructors(true);
@@ -50,6 +87,9 @@ class LLVMModuleNode final : public runtime::ModuleNode {
 
     BackendPackedCFunc faddr =
         reinterpret_cast<BackendPackedCFunc>(GetFunctionAddr(fname));
+    if (async_pending_.size() != 0 && !async_thread_.joinable()) {
+      async_thread_ = std::thread([this]() { this->AsyncCompile(); });
+    }
     if (faddr == nullptr) return PackedFunc();
     return WrapPackedFunc(faddr, sptr_to_self);
   }
@@ -209,7 +249,19 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   void LazyInitJIT() {
     CHECK(ee_ == nullptr);
     std::lock_guard<std::mutex> lock(mutex_);
-    llvm::EngineBuilder builder(std::move(module_));
+    LLVMJITMode mode = GetLLVMJITMode();
+    std::vector<std::unique_ptr<llvm::Module> > parts;
+    std::vector<std::string> roots;
+    if (mode != kEagerJIT) {
+      parts = PartitionModule(&roots);
+    }
+    if (parts.size() == 0) {
+      // The execution engine takes the ownership of the whole module.
+      parts.emplace_back(std::move(module_));
+    } else if (mode == kLazyAsyncJIT) {
+      async_pending_ = roots;
+    }
+    llvm::EngineBuilder builder(std::move(parts[0]));
     std::string triple, mcpu, mattr;
     llvm::TargetOptions opt;
     ParseLLVMTargetOptions(target_, &triple, &mcpu, &mattr, &opt);
@@ -239,6 +291,10 @@ class LLVMModuleNode final : public runtime::ModuleNode {
     ee_ = builder.create(tm.release());
     CHECK(ee_ != nullptr)
         << "Failed to initialize git engine for " << mptr_->getTargetTriple();
+    // MCJIT only generates code for a module when one of its symbols is requested.
+    for (size_t i = 1; i < parts.size(); ++i) {
+      ee_->addModule(std::move(parts[i]));
+    }
     ee_->runStaticConstructorsDestructors(false);
     // setup context address.
     entry_func_ =
@@ -251,6 +307,102 @@ class LLVMModuleNode final : public runtime::ModuleNode {
         return GetGlobalAddr(name);
       });
   }
+  /*!
+   * \brief Split a copy of the module into one module per exported function
+   *  and one module holding the global variables.
+   *
+   *  Local functions and constants are cloned into every partition that
+   *  uses them. Mutable local globals are promoted to external linkage
+   *  so that all the partitions share one copy of their state.
+   *
+   * \param roots The names of the exported functions.
+   * \return The partitions, empty if the module cannot be partitioned.
+   */
+  std::vector<std::unique_ptr<llvm::Module> > PartitionModule(
+      std::vector<std::string>* roots) {
+    std::vector<std::unique_ptr<llvm::Module> > parts;
+    // system library registers its symbols through static constructors,
+    // appending globals such as llvm.global_ctors cannot be split.
+    if (mptr_->getFunction("__tvm_module_startup") != nullptr) return parts;
+    for (const llvm::GlobalVariable& gv : mptr_->globals()) {
+      if (gv.hasAppendingLinkage()) return parts;
+    }
+    std::unique_ptr<llvm::Module> work = CloneLLVMModule(
+        *mptr_, [](const llvm::GlobalValue*) { return true; });
+    for (llvm::GlobalVariable& gv : work->globals()) {
+      if (gv.hasLocalLinkage() && !gv.isConstant()) {
+        gv.setName("__tvm_jit_shared" + gv.getName().str());
+        gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+      }
+    }
+    std::vector<const llvm::Function*> root_funcs;
+    for (const llvm::Function& f : work->functions()) {
+      if (!f.isDeclaration() && !f.hasLocalLinkage() &&
+          !f.hasAvailableExternallyLinkage()) {
+        root_funcs.push_back(&f);
+      }
+    }
+    if (root_funcs.size() <= 1) return parts;
+    parts.emplace_back(CloneLLVMModule(*work, [](const llvm::GlobalValue* gv) {
+          return llvm::isa<llvm::GlobalVariable>(gv) && !gv->hasLocalLinkage();
+        }));
+    for (const llvm::Function* f : root_funcs) {
+      std::unordered_set<const llvm::GlobalValue*> deps = CollectLocalDeps(f);
+      parts.emplace_back(CloneLLVMModule(*work, [f, &deps](const llvm::GlobalValue* gv) {
+            return gv == f || deps.count(gv) != 0;
+          }));
+      roots->push_back(f->getName().str());
+    }
+    return parts;
+  }
+  // Clone the definitions in module selected by pred, the rest become declarations.
+  static std::unique_ptr<llvm::Module> CloneLLVMModule(
+      const llvm::Module& m, std::function<bool(const llvm::GlobalValue*)> pred) {
+    llvm::ValueToValueMapTy vmap;
+#if TVM_LLVM_VERSION <= 60
+    return llvm::CloneModule(&m, vmap, pred);
+#else
+    return llvm::CloneModule(m, vmap, pred);
+#endif
+  }
+  // Collect the local and available externally values used by a function.
+  static std::unordered_set<const llvm::GlobalValue*> CollectLocalDeps(
+      const llvm::Function* func) {
+    std::unordered_set<const llvm::GlobalValue*> deps;
+    std::vector<const llvm::GlobalValue*> stack{func};
+    std::function<void(const llvm::Value*)> fvisit = [&](const llvm::Value* v) {
+      if (const auto* gv = llvm::dyn_cast<llvm::GlobalValue>(v)) {
+        if ((gv->hasLocalLinkage() || gv->hasAvailableExternallyLinkage()) &&
+            deps.insert(gv).second) {
+          stack.push_back(gv);
+        }
+      } else if (const auto* c = llvm::dyn_cast<llvm::Constant>(v)) {
+        for (const llvm::Use& op : c->operands()) fvisit(op.get());
+      }
+    };
+    while (stack.size() != 0) {
+      const llvm::GlobalValue* gv = stack.back();
+      stack.pop_back();
+      if (const auto* f = llvm::dyn_cast<llvm::Function>(gv)) {
+        for (const llvm::BasicBlock& bb : *f) {
+          for (const llvm::Instruction& inst : bb) {
+            for (const llvm::Use& op : inst.operands()) fvisit(op.get());
+          }
+        }
+      } else if (const auto* var = llvm::dyn_cast<llvm::GlobalVariable>(gv)) {
+        if (var->hasInitializer()) fvisit(var->getInitializer());
+      }
+    }
+    return deps;
+  }
+  // Compile the pending functions ahead of their first use.
+  void AsyncCompile() {
+    for (const std::string& name : async_pending_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (async_stop_) return;
+      ee_->getFunctionAddress(name);
+    }
+  }
   // Get global address from execution engine.
   uint64_t GetGlobalAddr(const std::string& name) {
     // first verifies if GV exists.
@@ -285,6 +437,12 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::unique_ptr<llvm::Module> module_;
   // the context.
   std::shared_ptr<llvm::LLVMContext> ctx_;
+  // Exported functions to be compiled in background.
+  std::vector<std::string> async_pending_;
+  // Background compilation thread.
+  std::thread async_thread_;
+  // Whether the background compilation should stop.
+  bool async_stop_{false};
 };
 
 unsigned LookupLLVMIntrinsic(const std::string& name) {
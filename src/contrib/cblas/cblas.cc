@@ -4,7 +4,9 @@
  */
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/util.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <dmlc/logging.h>
+#include <vector>
 #include "gemm_common.h"
 
 
@@ -40,6 +42,17 @@ struct CblasSgemmOp {
                 B, ldb,
                 beta, C, ldc);
   }
+#if USE_MKL_BLAS == 1
+  static void Batch(bool ta, bool tb, int M, int N, int K,
+                    float alpha, const float** A, int lda,
+                    const float** B, int ldb,
+                    float beta, float** C, int ldc, int batch) {
+    CBLAS_TRANSPOSE trans_a = BooleanToTranspose(ta);
+    CBLAS_TRANSPOSE trans_b = BooleanToTranspose(tb);
+    cblas_sgemm_batch(CblasColMajor, &trans_a, &trans_b, &M, &N, &K,
+                      &alpha, A, &lda, B, &ldb, &beta, C, &ldc, 1, &batch);
+  }
+#endif
 };
 
 struct CblasDgemmOp {
@@ -57,6 +70,71 @@ struct CblasDgemmOp {
                 B, ldb,
                 beta, C, ldc);
   }
+#if USE_MKL_BLAS == 1
+  static void Batch(bool ta, bool tb, int M, int N, int K,
+                    double alpha, const double** A, int lda,
+                    const double** B, int ldb,
+                    double beta, double** C, int ldc, int batch) {
+    CBLAS_TRANSPOSE trans_a = BooleanToTranspose(ta);
+    CBLAS_TRANSPOSE trans_b = BooleanToTranspose(tb);
+    cblas_dgemm_batch(CblasColMajor, &trans_a, &trans_b, &M, &N, &K,
+                      &alpha, A, &lda, B, &ldb, &beta, C, &ldc, 1, &batch);
+  }
+#endif
+};
+
+/*!
+ * \brief Batched gemm with a fixed stride between the matrices of the batch.
+ *  MKL provides a batched interface. For other BLAS libraries, the batch is
+ *  split over the TVM thread pool and each thread calls the single gemm.
+ */
+template<typename TGemmOp>
+struct CblasBatchGemmOp {
+  typedef typename TGemmOp::TDatatype TDatatype;
+  void operator()(int batch, bool ta, bool tb,
+                  int M, int N, int K,
+                  TDatatype alpha, TDatatype* A, int64_t a_stride, int lda,
+                  TDatatype* B, int64_t b_stride, int ldb,
+                  TDatatype beta, TDatatype* C, int64_t c_stride, int ldc) {
+#if USE_MKL_BLAS == 1
+    std::vector<const TDatatype*> a_array(batch), b_array(batch);
+    std::vector<TDatatype*> c_array(batch);
+    for (int i = 0; i < batch; ++i) {
+      a_array[i] = A + i * a_stride;
+      b_array[i] = B + i * b_stride;
+      c_array[i] = C + i * c_stride;
+    }
+    TGemmOp::Batch(ta, tb, M, N, K, alpha, a_array.data(), lda,
+                   b_array.data(), ldb, beta, c_array.data(), ldc, batch);
+#else
+    struct Closure {
+      int batch;
+      bool ta, tb;
+      int M, N, K;
+      TDatatype alpha, beta;
+      TDatatype *A, *B, *C;
+      int64_t a_stride, b_stride, c_stride;
+      int lda, ldb, ldc;
+    } closure{batch, ta, tb, M, N, K, alpha, beta, A, B, C,
+              a_stride, b_stride, c_stride, lda, ldb, ldc};
+    auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+      const Closure* c = static_cast<const Closure*>(cdata);
+      for (int i = task_id; i < c->batch; i += penv->num_task) {
+        TGemmOp()(c->ta, c->tb, c->M, c->N, c->K,
+                  c->alpha, c->A + i * c->a_stride, c->lda,
+                  c->B + i * c->b_stride, c->ldb,
+                  c->beta, c->C + i * c->c_stride, c->ldc);
+      }
+      return 0;
+    };
+    if (batch == 1) {
+      TVMParallelGroupEnv env{nullptr, 1};
+      flambda(0, &env, &closure);
+    } else {
+      CHECK_EQ(TVMBackendParallelLaunch(flambda, &closure, 0), 0);
+    }
+#endif
+  }
 };
 
 
@@ -72,5 +150,18 @@ TVM_REGISTER_GLOBAL("tvm.contrib.cblas.matmul")
     else
       CallGemm(args, ret, CblasDgemmOp());
   });
+
+// batched matrix multiplication for row major
+TVM_REGISTER_GLOBAL("tvm.contrib.cblas.batch_matmul")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    DLTensor* A = args[0];
+    CHECK(TypeMatch(A->dtype, kDLFloat, 32) ||
+          TypeMatch(A->dtype, kDLFloat, 64));
+
+    if (TypeMatch(A->dtype, kDLFloat, 32))
+      CallBatchGemm(args, ret, CblasBatchGemmOp<CblasSgemmOp>());
+    else
+      CallBatchGemm(args, ret, CblasBatchGemmOp<CblasDgemmOp>());
+  });
 }  // namespace contrib
 }  // namespace tvm
@@ -95,6 +95,78 @@ inline void CallGemm(TVMArgs args, TVMRetValue *ret, TGemmOp op) {
      ColumnStride(C));
 }
 
+
+inline int BatchCount(DLTensor* tensor) {
+  return tensor->shape[0];
+}
+
+// The stride between the matrices of a batch, 0 if the batch is broadcast.
+inline int64_t BatchStride(DLTensor* tensor, int batch) {
+  if (tensor->shape[0] == 1 && batch > 1) return 0;
+  if (tensor->strides) return tensor->strides[0];
+  return tensor->shape[1] * tensor->shape[2];
+}
+
+inline int BatchColumnStride(DLTensor* tensor) {
+  return tensor->strides ? tensor->strides[1] : tensor->shape[2];
+}
+
+inline int BatchRowCount(DLTensor* tensor, bool trans) {
+  return tensor->shape[trans ? 2 : 1];
+}
+
+inline int BatchColumnCount(DLTensor* tensor, bool trans) {
+  return tensor->shape[trans ? 1 : 2];
+}
+
+// Call a column major batched blas. C[i] = A[i] * B[i] for each i in the
+// batch, where A or B can have a batch of 1 which is broadcast.
+template<typename TBatchGemmOp>
+inline void CallBatchGemm(TVMArgs args, TVMRetValue *ret, TBatchGemmOp op) {
+  typedef typename TBatchGemmOp::TDatatype DType;
+  DLTensor* A = args[0];
+  DLTensor* B = args[1];
+  DLTensor* C = args[2];
+  bool transa = args[3];
+  bool transb = args[4];
+  int bit_depth = sizeof(DType) * 8;
+  CHECK_EQ(A->ndim, 3);
+  CHECK_EQ(B->ndim, 3);
+  CHECK_EQ(C->ndim, 3);
+  int batch = BatchCount(C);
+  CHECK(BatchCount(A) == batch || BatchCount(A) == 1);
+  CHECK(BatchCount(B) == batch || BatchCount(B) == 1);
+  // Only the batch and the row strides can be customized.
+  CHECK(A->strides == nullptr || A->strides[2] == 1);
+  CHECK(B->strides == nullptr || B->strides[2] == 1);
+  CHECK(C->strides == nullptr || C->strides[2] == 1);
+  CHECK_EQ(BatchRowCount(A, transa), BatchRowCount(C, false));
+  CHECK_EQ(BatchColumnCount(B, transb), BatchColumnCount(C, false));
+  CHECK_EQ(BatchColumnCount(A, transa), BatchRowCount(B, transb));
+
+  CHECK(TypeMatch(B->dtype, kDLFloat, bit_depth));
+  CHECK(TypeMatch(C->dtype, kDLFloat, bit_depth));
+  double alpha = args.size() > 5 ? args[5] : 1.0;
+  double beta = args.size() > 6 ? args[6] : 0.0;
+  op(batch,
+     transb,
+     transa,
+     BatchColumnCount(B, transb),
+     BatchRowCount(A, transa),
+     BatchColumnCount(A, transa),
+     static_cast<DType>(alpha),
+     reinterpret_cast<DType*>(static_cast<char*>(B->data) + B->byte_offset),
+     BatchStride(B, batch),
+     BatchColumnStride(B),
+     reinterpret_cast<DType*>(static_cast<char*>(A->data) + A->byte_offset),
+     BatchStride(A, batch),
+     BatchColumnStride(A),
+     static_cast<DType>(beta),
+     reinterpret_cast<DType*>(static_cast<char*>(C->data) + C->byte_offset),
+     BatchStride(C, batch),
+     BatchColumnStride(C));
+}
+
 }  // namespace contrib
 }  // namespace tvm
 
@@ -0,0 +1,183 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file nnpack_threadpool.cc
+ * \brief Implementation of the pthreadpool interface used by NNPACK on top of
+ *  the TVM thread pool, so that NNPACK and TVM kernels share one team of
+ *  worker threads instead of two spinning ones competing for the cores.
+ *
+ *  It replaces the pthreadpool library when NNPACK_USE_TVM_THREADPOOL is set.
+ */
+#if NNPACK_USE_TVM_THREADPOOL
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/threading_backend.h>
+#include <dmlc/logging.h>
+#include <pthreadpool.h>
+#include <algorithm>
+#include <functional>
+
+/*! \brief The pool handle only records the number of tasks to launch. */
+struct pthreadpool {
+  size_t threads_count;
+};
+
+namespace tvm {
+namespace contrib {
+
+/*!
+ * \brief Run fitem(i) for i in [0, range) on the TVM thread pool, in contiguous chunks.
+ *  The job is launched on all the workers of the pool, and the chunks are divided
+ *  among at most threads_count of them.
+ */
+void ThreadPoolFor(pthreadpool_t threadpool, size_t range,
+                   const std::function<void(size_t)>& fitem) {
+  size_t max_task = threadpool == nullptr ? 1 : std::min(threadpool->threads_count, range);
+  if (max_task <= 1) {
+    for (size_t i = 0; i < range; ++i) fitem(i);
+    return;
+  }
+  struct Closure {
+    const std::function<void(size_t)>* fitem;
+    size_t range;
+    size_t max_task;
+  } closure{&fitem, range, max_task};
+  auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+    const Closure* c = static_cast<const Closure*>(cdata);
+    size_t num_task = std::min(static_cast<size_t>(penv->num_task), c->max_task);
+    size_t task = static_cast<size_t>(task_id);
+    if (task >= num_task) return 0;
+    size_t begin = c->range * task / num_task;
+    size_t end = c->range * (task + 1) / num_task;
+    for (size_t i = begin; i < end; ++i) (*c->fitem)(i);
+    return 0;
+  };
+  if (TVMBackendParallelLaunch(flambda, &closure, 0) != 0) {
+    LOG(FATAL) << "NNPACK parallel job failed: " << TVMGetLastError();
+  }
+}
+
+/*! \brief Number of tiles of size tile to cover range. */
+inline size_t TileCount(size_t range, size_t tile) {
+  return (range + tile - 1) / tile;
+}
+
+}  // namespace contrib
+}  // namespace tvm
+
+using tvm::contrib::ThreadPoolFor;
+using tvm::contrib::TileCount;
+
+extern "C" {
+
+pthreadpool_t pthreadpool_create(size_t threads_count) {
+  pthreadpool_t threadpool = new pthreadpool();
+  // 0 means as many threads as the TVM pool can use.
+  threadpool->threads_count = threads_count == 0 ?
+      static_cast<size_t>(tvm::runtime::threading::MaxConcurrency()) : threads_count;
+  return threadpool;
+}
+
+size_t pthreadpool_get_threads_count(pthreadpool_t threadpool) {
+  return threadpool == nullptr ? 1 : threadpool->threads_count;
+}
+
+void pthreadpool_compute_1d(pthreadpool_t threadpool,
+                            pthreadpool_function_1d_t function,
+                            void* argument,
+                            size_t range) {
+  ThreadPoolFor(threadpool, range, [&](size_t i) {
+    function(argument, i);
+  });
+}
+
+void pthreadpool_compute_1d_tiled(pthreadpool_t threadpool,
+                                  pthreadpool_function_1d_tiled_t function,
+                                  void* argument,
+                                  size_t range,
+                                  size_t tile) {
+  ThreadPoolFor(threadpool, TileCount(range, tile), [&](size_t t) {
+    size_t i = t * tile;
+    function(argument, i, std::min(tile, range - i));
+  });
+}
+
+void pthreadpool_compute_2d(pthreadpool_t threadpool,
+                            pthreadpool_function_2d_t function,
+                            void* argument,
+                            size_t range_i,
+                            size_t range_j) {
+  ThreadPoolFor(threadpool, range_i * range_j, [&](size_t t) {
+    function(argument, t / range_j, t % range_j);
+  });
+}
+
+void pthreadpool_compute_2d_tiled(pthreadpool_t threadpool,
+                                  pthreadpool_function_2d_tiled_t function,
+                                  void* argument,
+                                  size_t range_i,
+                                  size_t range_j,
+                                  size_t tile_i,
+                                  size_t tile_j) {
+  size_t tiles_j = TileCount(range_j, tile_j);
+  ThreadPoolFor(threadpool, TileCount(range_i, tile_i) * tiles_j, [&](size_t t) {
+    size_t i = t / tiles_j * tile_i;
+    size_t j = t % tiles_j * tile_j;
+    function(argument, i, j, std::min(tile_i, range_i - i), std::min(tile_j, range_j - j));
+  });
+}
+
+void pthreadpool_compute_3d_tiled(pthreadpool_t threadpool,
+                                  pthreadpool_function_3d_tiled_t function,
+                                  void* argument,
+                                  size_t range_i,
+                                  size_t range_j,
+                                  size_t range_k,
+                                  size_t tile_i,
+                                  size_t tile_j,
+                                  size_t tile_k) {
+  size_t tiles_j = TileCount(range_j, tile_j);
+  size_t tiles_k = TileCount(range_k, tile_k);
+  ThreadPoolFor(threadpool, TileCount(range_i, tile_i) * tiles_j * tiles_k, [&](size_t t) {
+    size_t i = t / (tiles_j * tiles_k) * tile_i;
+    size_t j = t / tiles_k % tiles_j * tile_j;
+    size_t k = t % tiles_k * tile_k;
+    function(argument, i, j, k,
+             std::min(tile_i, range_i - i),
+             std::min(tile_j, range_j - j),
+             std::min(tile_k, range_k - k));
+  });
+}
+
+void pthreadpool_compute_4d_tiled(pthreadpool_t threadpool,
+                                  pthreadpool_function_4d_tiled_t function,
+                                  void* argument,
+                                  size_t range_i,
+                                  size_t range_j,
+                                  size_t range_k,
+                                  size_t range_l,
+                                  size_t tile_i,
+                                  size_t tile_j,
+                                  size_t tile_k,
+                                  size_t tile_l) {
+  size_t tiles_j = TileCount(range_j, tile_j);
+  size_t tiles_k = TileCount(range_k, tile_k);
+  size_t tiles_l = TileCount(range_l, tile_l);
+  size_t tiles = TileCount(range_i, tile_i) * tiles_j * tiles_k * tiles_l;
+  ThreadPoolFor(threadpool, tiles, [&](size_t t) {
+    size_t i = t / (tiles_j * tiles_k * tiles_l) * tile_i;
+    size_t j = t / (tiles_k * tiles_l) % tiles_j * tile_j;
+    size_t k = t / tiles_l % tiles_k * tile_k;
+    size_t l = t % tiles_l * tile_l;
+    function(argument, i, j, k, l,
+             std::min(tile_i, range_i - i),
+             std::min(tile_j, range_j - j),
+             std::min(tile_k, range_k - k),
+             std::min(tile_l, range_l - l));
+  });
+}
+
+void pthreadpool_destroy(pthreadpool_t threadpool) {
+  delete threadpool;
+}
+
+}  // extern "C"
+#endif  // NNPACK_USE_TVM_THREADPOOL
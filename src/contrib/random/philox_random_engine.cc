@@ -0,0 +1,203 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file random/philox_random_engine.cc
+ * \brief Counter based Philox4x32-10 random engine
+ */
+#include <dmlc/logging.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+namespace tvm {
+namespace contrib {
+
+/*!
+ * \brief A counter based random engine which fills tensors in parallel.
+ *
+ *  The i-th element of a tensor is computed from the seed and the counter
+ *  of the tensor offset by i / 4, following Philox4x32-10 of
+ *  "Parallel Random Numbers: As Easy as 1, 2, 3" (Salmon et al., SC'11).
+ *  So the result only depends on the seed and the sequence of calls, not
+ *  on the number of threads or the machine.
+ *
+ *  This holds bitwise for the integers and the uniform floats. The normal
+ *  floats go through std::log, std::cos and std::sin, whose last bits may
+ *  differ between math libraries, they are only bitwise reproducible with
+ *  the same library.
+ */
+class PhiloxRandomEngine {
+ public:
+   /*!
+    * \brief Creates a PhiloxRandomEngine using a default seed.
+    */
+  PhiloxRandomEngine() {
+    this->Seed(time(0));
+  }
+
+   /*!
+    * \brief Creates a PhiloxRandomEngine with a provided seed.
+    */
+  explicit PhiloxRandomEngine(unsigned seed) {
+    this->Seed(seed);
+  }
+
+   /*!
+    * \brief Seeds the engine and resets its counter.
+    */
+  inline void Seed(unsigned seed) {
+    rseed_ = seed;
+    counter_ = 0;
+  }
+
+   /*!
+    * \return the seed of the engine.
+    */
+  inline unsigned GetSeed() const {
+    return rseed_;
+  }
+
+   /*!
+    * \brief Fills a tensor with integers drawn from [low, high)
+    */
+  template<typename DType>
+  void SampleRandInt(DLTensor* data, int64_t low, int64_t high) {
+    uint64_t range = static_cast<uint64_t>(high - low);
+    Fill(data, [low, range](const uint32_t* block, int64_t i) {
+      return static_cast<DType>(low + static_cast<int64_t>(block[i % 4] % range));
+    });
+  }
+
+   /*!
+    * \brief Fills a tensor with values drawn from Unif(low, high)
+    */
+  void SampleUniform(DLTensor* data, float low, float high) {
+    CHECK_GT(high, low) << "high must be bigger than low";
+    CheckFloat32(data);
+    Fill(data, [low, high](const uint32_t* block, int64_t i) {
+      float v = low + (high - low) * ToUnitFloat(block[i % 4]);
+      // (high - low) * u may round up to high
+      return std::min(v, std::nextafter(high, low));
+    });
+  }
+
+   /*!
+    * \brief Fills a tensor with values drawn from Normal(loc, scale**2)
+    */
+  void SampleNormal(DLTensor* data, float loc, float scale) {
+    CHECK_GT(scale, 0) << "standard deviation must be positive";
+    CheckFloat32(data);
+    Fill(data, [loc, scale](const uint32_t* block, int64_t i) {
+      // Box-Muller transform, each pair of uniforms gives two normals.
+      int pair = (i % 4) / 2;
+      float u1 = 1.0f - ToUnitFloat(block[pair * 2]);  // in (0, 1]
+      float u2 = ToUnitFloat(block[pair * 2 + 1]);
+      float r = std::sqrt(-2.0f * std::log(u1));
+      float theta = 6.2831853071795864f * u2;
+      float z = i % 2 == 0 ? r * std::cos(theta) : r * std::sin(theta);
+      return loc + scale * z;
+    });
+  }
+
+ private:
+  /*! \brief Number of elements per task of the thread pool. */
+  static const int64_t kGrainSize = 1 << 16;
+
+  unsigned rseed_;
+  /*! \brief Index of the next block of 4 random numbers. */
+  uint64_t counter_;
+
+  static void CheckFloat32(const DLTensor* data) {
+    DLDataType dtype = data->dtype;
+    CHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
+  }
+
+  /*! \brief Map the upper 24 bits to a float in [0, 1). */
+  static float ToUnitFloat(uint32_t x) {
+    return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+  }
+
+  static inline uint32_t MulHiLo(uint32_t a, uint32_t b, uint32_t* hi) {
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    *hi = static_cast<uint32_t>(product >> 32);
+    return static_cast<uint32_t>(product);
+  }
+
+  /*! \brief Compute the block of 4 random numbers at a counter. */
+  static void Philox4x32(uint64_t counter, unsigned seed, uint32_t out[4]) {
+    const uint32_t kMul0 = 0xD2511F53, kMul1 = 0xCD9E8D57;
+    const uint32_t kWeyl0 = 0x9E3779B9, kWeyl1 = 0xBB67AE85;
+    uint32_t ctr[4] = {static_cast<uint32_t>(counter),
+                       static_cast<uint32_t>(counter >> 32), 0, 0};
+    uint32_t key[2] = {static_cast<uint32_t>(seed), 0};
+    for (int round = 0; round < 10; ++round) {
+      uint32_t hi0, hi1;
+      uint32_t lo0 = MulHiLo(kMul0, ctr[0], &hi0);
+      uint32_t lo1 = MulHiLo(kMul1, ctr[2], &hi1);
+      uint32_t next[4] = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+      std::copy(next, next + 4, ctr);
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+    std::copy(ctr, ctr + 4, out);
+  }
+
+  /*!
+   * \brief Fill data[i] = fvalue(block, i) in parallel, where block is the
+   *  4 random numbers at counter_ + i / 4. The counter is advanced past data.
+   */
+  template<typename FValue>
+  void Fill(DLTensor* data, FValue fvalue) {
+    CHECK(data->strides == nullptr);
+    CHECK_EQ(data->ctx.device_type, kDLCPU)
+        << "Do not support philox random engine on this device yet";
+    int64_t size = 1;
+    for (int i = 0; i < data->ndim; ++i) {
+      size *= data->shape[i];
+    }
+    using DType = decltype(fvalue(nullptr, 0));
+    struct Closure {
+      FValue* fvalue;
+      DType* out;
+      int64_t size;
+      uint64_t counter;
+      unsigned seed;
+    } closure{&fvalue, static_cast<DType*>(data->data), size, counter_, rseed_};
+
+    // the grains, rather than the tasks, decide the counters of the elements.
+    auto fgrain = [](const Closure* c, int64_t grain) {
+      int64_t begin = grain * kGrainSize;
+      int64_t end = begin + kGrainSize;
+      if (end > c->size) end = c->size;
+      uint32_t block[4];
+      for (int64_t i = begin; i < end; ++i) {
+        if (i == begin || i % 4 == 0) {
+          Philox4x32(c->counter + i / 4, c->seed, block);
+        }
+        c->out[i] = (*c->fvalue)(block, i);
+      }
+    };
+    int64_t num_grains = (size + kGrainSize - 1) / kGrainSize;
+    if (num_grains <= 1) {
+      if (num_grains == 1) fgrain(&closure, 0);
+    } else {
+      struct ParallelClosure {
+        const Closure* closure;
+        decltype(fgrain)* fgrain;
+        int64_t num_grains;
+      } pclosure{&closure, &fgrain, num_grains};
+      auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+        const ParallelClosure* pc = static_cast<const ParallelClosure*>(cdata);
+        for (int64_t g = task_id; g < pc->num_grains; g += penv->num_task) {
+          (*pc->fgrain)(pc->closure, g);
+        }
+        return 0;
+      };
+      CHECK_EQ(TVMBackendParallelLaunch(flambda, &pclosure, 0), 0);
+    }
+    counter_ += static_cast<uint64_t>((size + 3) / 4);
+  }
+};
+
+}  // namespace contrib
+}  // namespace tvm
@@ -7,11 +7,13 @@
 #include <dmlc/logging.h>
 #include <dmlc/thread_local.h>
 #include <algorithm>
+#include <string>
 #ifndef _LIBCPP_SGX_CONFIG
 #include "mt_random_engine.cc"
 #else
 #include "sgx_random_engine.cc"
 #endif
+#include "philox_random_engine.cc"
 
 #define DLPACK_INTEGER_TYPE_SWITCH(type, DType, ...)    \
   if (type.code == kDLInt && type.bits == 32) {         \
@@ -43,6 +45,8 @@ using namespace runtime;
 
 struct RandomThreadLocalEntry {
   RandomEngine random_engine;
+  /*! \brief counter based engine, deterministic regardless of the number of threads. */
+  PhiloxRandomEngine philox_engine;
   static RandomThreadLocalEntry* ThreadLocal();
 };
 
@@ -52,6 +56,26 @@ RandomThreadLocalEntry* RandomThreadLocalEntry::ThreadLocal() {
   return RandomThreadLocalStore::Get();
 }
 
+/*!
+ * \brief Whether to use the philox engine, from the optional engine argument at index.
+ *  The engine is "mt19937" (the default) or "philox".
+ */
+inline bool UsePhilox(const TVMArgs& args, int index) {
+  if (args.size() <= index) return false;
+  std::string engine = args[index];
+  CHECK(engine == "mt19937" || engine == "philox") << "Unknown random engine " << engine;
+  return engine == "philox";
+}
+
+
+TVM_REGISTER_GLOBAL("tvm.contrib.random.seed")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    RandomThreadLocalEntry *entry = RandomThreadLocalEntry::ThreadLocal();
+    unsigned seed = static_cast<unsigned>(args[0].operator int64_t());
+    entry->random_engine.Seed(seed);
+    entry->philox_engine.Seed(seed);
+  });
+
 
 TVM_REGISTER_GLOBAL("tvm.contrib.random.randint")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
@@ -59,6 +83,7 @@ TVM_REGISTER_GLOBAL("tvm.contrib.random.randint")
     int64_t low = args[0];
     int64_t high = args[1];
     DLTensor* out = args[2];
+    bool use_philox = UsePhilox(args, 3);
     CHECK_GT(high, low) << "high must be bigger than low";
     CHECK(out->strides == nullptr);
 
@@ -75,7 +100,9 @@ TVM_REGISTER_GLOBAL("tvm.contrib.random.randint")
       low = std::max(low, numeric_low);
       high = std::min(high, numeric_high);
 
-      if (out->ctx.device_type == kDLCPU) {
+      if (use_philox) {
+        entry->philox_engine.SampleRandInt<DType>(out, low, high);
+      } else if (out->ctx.device_type == kDLCPU) {
           // file the data with random byte
           std::generate_n(static_cast<DType*>(out->data), size, [&] () {
             unsigned rint = entry->random_engine.GetRandInt();
@@ -94,7 +121,11 @@ TVM_REGISTER_GLOBAL("tvm.contrib.random.uniform")
     double low = args[0];
     double high = args[1];
     DLTensor* out = args[2];
-    entry->random_engine.SampleUniform(out, low, high);
+    if (UsePhilox(args, 3)) {
+      entry->philox_engine.SampleUniform(out, low, high);
+    } else {
+      entry->random_engine.SampleUniform(out, low, high);
+    }
   });
 
 
@@ -104,7 +135,11 @@ TVM_REGISTER_GLOBAL("tvm.contrib.random.normal")
     double loc = args[0];
     double scale = args[1];
     DLTensor* out = args[2];
-    entry->random_engine.SampleNormal(out, loc, scale);
+    if (UsePhilox(args, 3)) {
+      entry->philox_engine.SampleNormal(out, loc, scale);
+    } else {
+      entry->random_engine.SampleNormal(out, loc, scale);
+    }
   });
 
 
@@ -5,8 +5,11 @@
 
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/util.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <dlpack/dlpack.h>
+#include <builtin_fp16.h>
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -14,18 +17,219 @@ namespace contrib {
 
 using namespace runtime;
 
+/*! \brief Storage type of float16, converted to float for comparison. */
+struct Half {
+  uint16_t bits;
+};
+
 template<typename DType>
-bool CompareAscend(const std::pair<int32_t, DType>& lhs,
-                   const std::pair<int32_t, DType>& rhs) {
-  return lhs.second < rhs.second;
+inline DType ToKey(DType value) {
+  return value;
+}
+
+inline float ToKey(Half value) {
+  return __extendXfYf2__<uint16_t, uint16_t, 10, float, uint32_t, 23>(value.bits);
+}
+
+// Always false for integers.
+template<typename KType>
+inline bool IsNaN(KType value) {
+  return value != value;
+}
+
+// Compare by value, and by index for equal values so that the order is stable.
+// NaNs are placed last in both orders, which keeps the comparison a strict weak ordering.
+template<typename KType>
+bool CompareAscend(const std::pair<int32_t, KType>& lhs,
+                   const std::pair<int32_t, KType>& rhs) {
+  bool lhs_nan = IsNaN(lhs.second), rhs_nan = IsNaN(rhs.second);
+  if (lhs_nan || rhs_nan) {
+    return lhs_nan == rhs_nan ? lhs.first < rhs.first : rhs_nan;
+  }
+  return lhs.second < rhs.second ||
+      (!(rhs.second < lhs.second) && lhs.first < rhs.first);
+}
+
+template<typename KType>
+bool CompareDescend(const std::pair<int32_t, KType>& lhs,
+                    const std::pair<int32_t, KType>& rhs) {
+  bool lhs_nan = IsNaN(lhs.second), rhs_nan = IsNaN(rhs.second);
+  if (lhs_nan || rhs_nan) {
+    return lhs_nan == rhs_nan ? lhs.first < rhs.first : rhs_nan;
+  }
+  return lhs.second > rhs.second ||
+      (!(rhs.second > lhs.second) && lhs.first < rhs.first);
+}
+
+/*!
+ * \brief The slices of a tensor along an axis, which are sorted independently.
+ *  Slice (i, j) starts at i * axis_len * axis_mul_after + j with stride axis_mul_after.
+ */
+struct SortSlices {
+  int64_t axis_mul_before{1};
+  int64_t axis_mul_after{1};
+  int64_t axis_len{0};
+
+  SortSlices(const DLTensor* input, int axis) {
+    axis_len = input->shape[axis];
+    for (int i = 0; i < input->ndim; ++i) {
+      if (i < axis) {
+        axis_mul_before *= input->shape[i];
+      } else if (i > axis) {
+        axis_mul_after *= input->shape[i];
+      }
+    }
+  }
+
+  int64_t size() const {
+    return axis_mul_before * axis_mul_after;
+  }
+};
+
+/*!
+ * \brief Run fslice(begin, end) on ranges of the slices with the thread pool.
+ *  Small inputs are processed in the calling thread.
+ */
+template<typename FSlice>
+void ParallelForSlices(int64_t num_slices, int64_t slice_len, FSlice fslice) {
+  // Below this number of elements, launching the thread pool costs more than the sort.
+  const int64_t kMinParallelElems = 1 << 14;
+  if (num_slices < 2 || num_slices * slice_len < kMinParallelElems) {
+    fslice(0, num_slices);
+    return;
+  }
+  struct Closure {
+    FSlice* fslice;
+    int64_t num_slices;
+  } closure{&fslice, num_slices};
+  auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+    const Closure* c = static_cast<const Closure*>(cdata);
+    int64_t step = (c->num_slices + penv->num_task - 1) / penv->num_task;
+    int64_t begin = std::min(task_id * step, c->num_slices);
+    int64_t end = std::min(begin + step, c->num_slices);
+    (*c->fslice)(begin, end);
+    return 0;
+  };
+  CHECK_EQ(TVMBackendParallelLaunch(flambda, &closure, 0), 0);
+}
+
+template<typename DType>
+void ArgSort(const DLTensor* input, const DLTensor* sort_num, DLTensor* output,
+             int axis, bool is_descend) {
+  using KType = decltype(ToKey(DType()));
+  const DType* data_ptr = static_cast<const DType*>(input->data);
+  const int32_t* sort_num_ptr = static_cast<const int32_t*>(sort_num->data);
+  int32_t* out_ptr = static_cast<int32_t*>(output->data);
+  SortSlices slices(input, axis);
+
+  ParallelForSlices(slices.size(), slices.axis_len, [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int32_t, KType> > sorter;
+    sorter.reserve(slices.axis_len);
+    for (int64_t s = begin; s < end; ++s) {
+      int64_t i = s / slices.axis_mul_after;
+      int64_t j = s % slices.axis_mul_after;
+      sorter.clear();
+      int32_t current_sort_num = sort_num_ptr[s];
+      int64_t base_idx = i * slices.axis_len * slices.axis_mul_after + j;
+      for (int64_t k = 0; k < current_sort_num; ++k) {
+        int64_t full_idx = base_idx + k * slices.axis_mul_after;
+        sorter.emplace_back(static_cast<int32_t>(k), ToKey(data_ptr[full_idx]));
+      }
+      if (is_descend) {
+        std::sort(sorter.begin(), sorter.end(), CompareDescend<KType>);
+      } else {
+        std::sort(sorter.begin(), sorter.end(), CompareAscend<KType>);
+      }
+      for (int32_t k = 0; k < slices.axis_len; ++k) {
+        out_ptr[base_idx + k * slices.axis_mul_after]
+            = k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
+      }
+    }
+  });
 }
 
 template<typename DType>
-bool CompareDescend(const std::pair<int32_t, DType>& lhs,
-                    const std::pair<int32_t, DType>& rhs) {
-  return lhs.second > rhs.second;
+void TopK(const DLTensor* input, DLTensor* out_values, DLTensor* out_indices,
+          int axis, int k, bool is_descend) {
+  using KType = decltype(ToKey(DType()));
+  const DType* data_ptr = static_cast<const DType*>(input->data);
+  DType* values_ptr = static_cast<DType*>(out_values->data);
+  int32_t* indices_ptr = static_cast<int32_t*>(out_indices->data);
+  SortSlices slices(input, axis);
+
+  ParallelForSlices(slices.size(), slices.axis_len, [&](int64_t begin, int64_t end) {
+    std::vector<std::pair<int32_t, KType> > sorter;
+    sorter.reserve(slices.axis_len);
+    for (int64_t s = begin; s < end; ++s) {
+      int64_t i = s / slices.axis_mul_after;
+      int64_t j = s % slices.axis_mul_after;
+      sorter.clear();
+      int64_t base_idx = i * slices.axis_len * slices.axis_mul_after + j;
+      for (int64_t l = 0; l < slices.axis_len; ++l) {
+        sorter.emplace_back(static_cast<int32_t>(l),
+                            ToKey(data_ptr[base_idx + l * slices.axis_mul_after]));
+      }
+      // only the first k elements are ordered
+      if (is_descend) {
+        std::partial_sort(sorter.begin(), sorter.begin() + k, sorter.end(),
+                          CompareDescend<KType>);
+      } else {
+        std::partial_sort(sorter.begin(), sorter.begin() + k, sorter.end(),
+                          CompareAscend<KType>);
+      }
+      int64_t out_base_idx = i * k * slices.axis_mul_after + j;
+      for (int l = 0; l < k; ++l) {
+        int64_t out_idx = out_base_idx + l * slices.axis_mul_after;
+        indices_ptr[out_idx] = sorter[l].first;
+        values_ptr[out_idx] = data_ptr[base_idx + sorter[l].first * slices.axis_mul_after];
+      }
+    }
+  });
 }
 
+// Supports float16/32/64 and signed/unsigned integers of 8 to 64 bits.
+#define SORT_DTYPE_SWITCH(type, DType, ...)                         \
+  CHECK_EQ(type.lanes, 1) << "Sort does not support vector types"; \
+  if (type.code == kDLFloat && type.bits == 32) {                  \
+    typedef float DType;                                           \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLFloat && type.bits == 64) {           \
+    typedef double DType;                                          \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLFloat && type.bits == 16) {           \
+    typedef Half DType;                                            \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLInt && type.bits == 32) {             \
+    typedef int32_t DType;                                         \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLInt && type.bits == 64) {             \
+    typedef int64_t DType;                                         \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLInt && type.bits == 16) {             \
+    typedef int16_t DType;                                         \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLInt && type.bits == 8) {              \
+    typedef int8_t DType;                                          \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLUInt && type.bits == 32) {            \
+    typedef uint32_t DType;                                        \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLUInt && type.bits == 64) {            \
+    typedef uint64_t DType;                                        \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLUInt && type.bits == 16) {            \
+    typedef uint16_t DType;                                        \
+    {__VA_ARGS__}                                                  \
+  } else if (type.code == kDLUInt && type.bits == 8) {             \
+    typedef uint8_t DType;                                         \
+    {__VA_ARGS__}                                                  \
+  } else {                                                         \
+    LOG(FATAL) << "Unsupported input dtype for sort";              \
+  }
+
+inline void CheckIndexType(const DLTensor* tensor, const char* name) {
+  CHECK(TypeMatch(tensor->dtype, kDLInt, 32)) << name << " should be int32";
+}
 
 // Argsort implemented C library sort.
 // Return indices of sorted tensor.
@@ -34,6 +238,7 @@ bool CompareDescend(const std::pair<int32_t, DType>& lhs,
 // If input tensor has dimension (d0, d1, ..., d(k-1), dk, d(k+1), ..., d(n-1))
 // and sort axis is dk. sort_num should have dimension of
 // (d1, d2, ..., d(k-1), d(k+1), ..., dn).
+// The independent slices are sorted in parallel.
 TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
   DLTensor *input = args[0];
@@ -42,53 +247,47 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort")
   int32_t axis = args[3];
   bool is_descend = args[4];
 
-  auto dtype = input->dtype;
-  auto data_ptr = static_cast<float *>(input->data);
-  auto sort_num_ptr = static_cast<int32_t *>(sort_num->data);
-  std::vector<std::pair<int32_t, float>> sorter;
-  int64_t axis_mul_before = 1;
-  int64_t axis_mul_after = 1;
-
   if (axis < 0) {
     axis = input->ndim + axis;
   }
-
-  // Currently only supports input dtype to be float32.
-  CHECK_EQ(dtype.code, 2) << "Currently only supports input dtype "
-      "to be float32.";
-  CHECK_EQ(dtype.bits, 32) << "Currently only supports input dtype "
-      "to be float32.";
-  CHECK_LT(axis, input->ndim) << "Axis out of boundary for "
+  CHECK(axis >= 0 && axis < input->ndim) << "Axis out of boundary for "
       "input ndim " << input->ndim;
+  CheckIndexType(sort_num, "sort_num");
+  CheckIndexType(output, "Output of argsort");
 
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
+  SORT_DTYPE_SWITCH(input->dtype, DType, {
+    ArgSort<DType>(input, sort_num, output, axis, is_descend);
+  });
+});
 
-  for (int64_t i = 0 ; i < axis_mul_before; ++i) {
-    for (int64_t j = 0 ; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int32_t current_sort_num = *(sort_num_ptr + i * axis_mul_after + j);
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < current_sort_num; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, *(data_ptr + full_idx)));
-      }
-      if (is_descend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<float>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<float>);
-      }
-      for (int32_t k = 0; k < input->shape[axis]; ++k) {
-        *(static_cast<int32_t *>(output->data) + base_idx + k * axis_mul_after)
-            = k < static_cast<int32_t>(sorter.size()) ? sorter[k].first : k;
-      }
-    }
+// Top k elements along an axis.
+// out_values and out_indices have the shape of input, except that the
+// dimension of axis is k. The elements are ordered in each slice, and
+// only the k selected elements are sorted.
+TVM_REGISTER_GLOBAL("tvm.contrib.sort.topk")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+  DLTensor *input = args[0];
+  DLTensor *out_values = args[1];
+  DLTensor *out_indices = args[2];
+  int32_t k = args[3];
+  int32_t axis = args[4];
+  bool is_descend = args[5];
+
+  if (axis < 0) {
+    axis = input->ndim + axis;
   }
+  CHECK(axis >= 0 && axis < input->ndim) << "Axis out of boundary for "
+      "input ndim " << input->ndim;
+  CHECK(k > 0 && k <= input->shape[axis])
+      << "k should be in (0, " << input->shape[axis] << "], but got " << k;
+  CHECK_EQ(out_values->shape[axis], k);
+  CHECK(TypeMatch(out_values->dtype, input->dtype.code, input->dtype.bits))
+      << "Values of topk should have the input dtype";
+  CheckIndexType(out_indices, "Indices of topk");
+
+  SORT_DTYPE_SWITCH(input->dtype, DType, {
+    TopK<DType>(input, out_values, out_indices, axis, k, is_descend);
+  });
 });
 
 }  // namespace contrib
@@ -4,10 +4,12 @@
  * \file scan_op.cc
  */
 #include <tvm/operation.h>
+#include <tvm/arithmetic.h>
 #include <tvm/ir.h>
 #include <tvm/ir_pass.h>
 #include "op_util.h"
 #include "../schedule/graph.h"
+#include "../arithmetic/compute_expr.h"
 
 namespace tvm {
 
@@ -19,10 +21,6 @@ TVM_STATIC_IR_FUNCTOR(IRPrinter, vtable)
 });
 TVM_REGISTER_NODE_TYPE(ScanOpNode);
 
-inline bool prove_equal(Expr lhs, Expr rhs) {
-  return is_zero(ir::Simplify(lhs - rhs));
-}
-
 int ScanOpNode::num_outputs() const {
   return static_cast<int>(update.size());
 }
@@ -63,7 +61,7 @@ Operation ScanOpNode::make(std::string name,
     CHECK_EQ(init[i]->dtype, update[i]->dtype);
     CHECK(can_prove(init[i]->shape[0] == axis->dom->min))
         << "init.shape[0] need to match scan_axis.dom.min";
-    CHECK(prove_equal(
+    CHECK(arith::ProveEqual(
         state_placeholder[i]->shape[0], axis->dom->min + axis->dom->extent))
         << "shate_placeholder.shape[0] need to match"
         << " scan_axis.dom.min + scan_axis.dom.extent";
@@ -72,7 +70,7 @@ Operation ScanOpNode::make(std::string name,
     CHECK_EQ(update[i].ndim(), state_placeholder[i].ndim())
         << "The update.ndim need to be state_placeholder.ndim - 1";
     for (size_t k = 0;  k < update[i].ndim(); ++k) {
-      CHECK(prove_equal(
+      CHECK(arith::ProveEqual(
           update[i]->shape[k], state_placeholder[i]->shape[k]));
       if (k != 0) {
         // setup spatial axis
@@ -86,7 +84,7 @@ Operation ScanOpNode::make(std::string name,
     }
 
     for (size_t k = 1;  k < init[i].ndim(); ++k) {
-      CHECK(prove_equal(
+      CHECK(arith::ProveEqual(
           init[i]->shape[k], state_placeholder[i]->shape[k]));
     }
   }
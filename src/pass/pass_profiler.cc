@@ -0,0 +1,282 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file pass_profiler.cc
+ * \brief Instrumentation of pass invocations.
+ */
+#include <dmlc/json.h>
+#include <dmlc/thread_local.h>
+#include <tvm/pass_profiler.h>
+#include <tvm/api_registry.h>
+#include <tvm/node/container.h>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace tvm {
+
+namespace {
+// Visitor that collects all the nodes reachable from a root.
+class NodeCounter : public AttrVisitor {
+ public:
+  std::unordered_set<const Node*> visited;
+
+  void Visit(const char* key, double* value) final {}
+  void Visit(const char* key, int64_t* value) final {}
+  void Visit(const char* key, uint64_t* value) final {}
+  void Visit(const char* key, int* value) final {}
+  void Visit(const char* key, bool* value) final {}
+  void Visit(const char* key, std::string* value) final {}
+  void Visit(const char* key, void** value) final {}
+  void Visit(const char* key, Type* value) final {}
+  void Visit(const char* key, runtime::NDArray* value) final {}
+  void Visit(const char* key, NodeRef* value) final {
+    stack_.push_back(value->node_.get());
+  }
+
+  void Run(Node* root) {
+    stack_.push_back(root);
+    while (stack_.size() != 0) {
+      Node* node = stack_.back();
+      stack_.pop_back();
+      if (node == nullptr || !visited.insert(node).second) continue;
+      if (node->is_type<ArrayNode>()) {
+        for (const auto& sp : static_cast<ArrayNode*>(node)->data) {
+          stack_.push_back(sp.get());
+        }
+      } else if (node->is_type<MapNode>()) {
+        for (const auto& kv : static_cast<MapNode*>(node)->data) {
+          stack_.push_back(kv.first.get());
+          stack_.push_back(kv.second.get());
+        }
+      } else if (node->is_type<StrMapNode>()) {
+        for (const auto& kv : static_cast<StrMapNode*>(node)->data) {
+          stack_.push_back(kv.second.get());
+        }
+      } else {
+        node->VisitAttrs(this);
+      }
+    }
+  }
+
+ private:
+  // explicit stack, IR trees can be deeper than the native stack.
+  std::vector<Node*> stack_;
+};
+
+// Resident memory of the process in bytes.
+int64_t CurrentRSSBytes() {
+#if defined(__linux__)
+  long pages = 0;  // NOLINT(*)
+  FILE* fp = fopen("/proc/self/statm", "r");
+  if (fp == nullptr) return 0;
+  if (fscanf(fp, "%*s%ld", &pages) != 1) pages = 0;
+  fclose(fp);
+  return static_cast<int64_t>(pages) * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 0;
+#endif
+}
+
+// Peak resident memory of the process in bytes.
+int64_t PeakRSSBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return static_cast<int64_t>(usage.ru_maxrss);
+#else
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+typedef std::chrono::steady_clock Clock;
+
+// The time origin of the records.
+const Clock::time_point& ProfileEpoch() {
+  static Clock::time_point epoch = Clock::now();
+  return epoch;
+}
+
+int64_t NowMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - ProfileEpoch()).count();
+}
+
+// Map std::thread::id to small integers.
+int ThreadIndex() {
+  static std::mutex mutex;
+  static std::unordered_map<std::thread::id, int> index;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(std::this_thread::get_id());
+  if (it != index.end()) return it->second;
+  int idx = static_cast<int>(index.size());
+  index[std::this_thread::get_id()] = idx;
+  return idx;
+}
+
+/*! \brief Stack of the running passes on a thread. */
+struct PassProfilerThreadEntry {
+  std::vector<PassProfileRecord> stack;
+};
+
+typedef dmlc::ThreadLocalStore<PassProfilerThreadEntry> PassProfilerThreadLocalStore;
+
+void SaveRecordArgs(const PassProfileRecord& r, dmlc::JSONWriter* writer) {
+  writer->WriteObjectKeyValue("nodes_before", r.nodes_before);
+  writer->WriteObjectKeyValue("nodes_after", r.nodes_after);
+  writer->WriteObjectKeyValue("rss_before_bytes", r.rss_before_bytes);
+  writer->WriteObjectKeyValue("rss_after_bytes", r.rss_after_bytes);
+  writer->WriteObjectKeyValue("peak_rss_bytes", r.peak_rss_bytes);
+  writer->WriteObjectKeyValue("depth", r.depth);
+}
+}  // namespace
+
+PassProfiler::PassProfiler() {
+  ProfileEpoch();
+}
+
+PassProfiler* PassProfiler::Global() {
+  static PassProfiler inst;
+  return &inst;
+}
+
+int64_t PassProfiler::CountNodes(const NodeRef& node) {
+  if (!node.defined()) return 0;
+  NodeCounter counter;
+  counter.Run(const_cast<Node*>(node.get()));
+  return static_cast<int64_t>(counter.visited.size());
+}
+
+void PassProfiler::SetEnabled(bool enabled) {
+  enabled_.store(enabled);
+}
+
+void PassProfiler::Begin(const std::string& name, const NodeRef& input) {
+  PassProfileRecord r;
+  r.name = name;
+  r.nodes_before = CountNodes(input);
+  r.rss_before_bytes = CurrentRSSBytes();
+  r.thread_index = ThreadIndex();
+  // start the clock after the node counting.
+  r.start_us = NowMicroseconds();
+  PassProfilerThreadLocalStore::Get()->stack.push_back(r);
+}
+
+void PassProfiler::End(const NodeRef& output) {
+  int64_t end_us = NowMicroseconds();
+  std::vector<PassProfileRecord>* stack = &(PassProfilerThreadLocalStore::Get()->stack);
+  CHECK(stack->size() != 0) << "PassProfiler::End without Begin";
+  PassProfileRecord r = stack->back();
+  stack->pop_back();
+  r.duration_us = end_us - r.start_us;
+  r.depth = static_cast<int>(stack->size());
+  r.nodes_after = CountNodes(output);
+  r.rss_after_bytes = CurrentRSSBytes();
+  r.peak_rss_bytes = PeakRSSBytes();
+  std::lock_guard<std::mutex> lock(mutex_);
+  records_.push_back(r);
+}
+
+std::vector<PassProfileRecord> PassProfiler::GetRecords() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return records_;
+}
+
+void PassProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  records_.clear();
+}
+
+std::string PassProfiler::ToJSON() {
+  std::vector<PassProfileRecord> records = GetRecords();
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginArray();
+  for (const PassProfileRecord& r : records) {
+    writer.WriteArraySeperator();
+    writer.BeginObject();
+    writer.WriteObjectKeyValue("name", r.name);
+    writer.WriteObjectKeyValue("start_us", r.start_us);
+    writer.WriteObjectKeyValue("duration_us", r.duration_us);
+    writer.WriteObjectKeyValue("thread_index", r.thread_index);
+    SaveRecordArgs(r, &writer);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  return os.str();
+}
+
+std::string PassProfiler::ToChromeTrace() {
+  std::vector<PassProfileRecord> records = GetRecords();
+  std::ostringstream events;
+  events << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < records.size(); ++i) {
+    const PassProfileRecord& r = records[i];
+    if (i != 0) events << ",";
+    events << "\n  ";
+    std::ostringstream args;
+    dmlc::JSONWriter args_writer(&args);
+    args_writer.BeginObject(false);
+    SaveRecordArgs(r, &args_writer);
+    args_writer.EndObject();
+    std::ostringstream name;
+    dmlc::JSONWriter name_writer(&name);
+    name_writer.WriteString(r.name);
+    events << "{\"name\": " << name.str()
+           << ", \"cat\": \"pass\", \"ph\": \"X\""
+           << ", \"ts\": " << r.start_us
+           << ", \"dur\": " << r.duration_us
+           << ", \"pid\": 0, \"tid\": " << r.thread_index
+           << ", \"args\": " << args.str() << "}";
+  }
+  events << "\n]}\n";
+  return events.str();
+}
+
+TVM_REGISTER_API("_PassProfilerSetEnabled")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    PassProfiler::Global()->SetEnabled(args[0]);
+  });
+
+TVM_REGISTER_API("_PassProfilerEnabled")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    *ret = PassProfiler::Global()->enabled();
+  });
+
+TVM_REGISTER_API("_PassProfilerClear")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    PassProfiler::Global()->Clear();
+  });
+
+TVM_REGISTER_API("_PassProfilerBegin")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    PassProfiler::Global()->Begin(args[0], ProfiledNode(args[1]));
+  });
+
+TVM_REGISTER_API("_PassProfilerEnd")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    PassProfiler::Global()->End(ProfiledNode(args[0]));
+  });
+
+TVM_REGISTER_API("_PassProfilerToJSON")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    *ret = PassProfiler::Global()->ToJSON();
+  });
+
+TVM_REGISTER_API("_PassProfilerToChromeTrace")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    *ret = PassProfiler::Global()->ToChromeTrace();
+  });
+
+}  // namespace tvm
@@ -16,6 +16,7 @@
 #include <mutex>
 #include <functional>
 #include "compile_engine.h"
+#include "../../codegen/kernel_cache.h"
 
 namespace tvm {
 namespace relay {
@@ -335,6 +336,16 @@ class CompileEngineImpl : public CompileEngineNode {
     for (Tensor arg : cache_node->outputs) {
       all_args.push_back(arg);
     }
+    // reuse the lowered function from the persistent kernel cache.
+    codegen::KernelCache* disk_cache = codegen::KernelCache::Global();
+    std::string disk_key;
+    if (disk_cache->enabled()) {
+      disk_key = disk_cache->MakeKey(spair.first, all_args, key->target->str());
+      if (disk_cache->Lookup(disk_key, cache_node->func_name, &(cache_node->funcs))) {
+        value->cached_func = CachedFunc(cache_node);
+        return value;
+      }
+    }
     // lower the function
     if (const auto* f = runtime::Registry::Get("relay.backend.lower")) {
       cache_node->funcs = (*f)(
@@ -342,6 +353,9 @@ class CompileEngineImpl : public CompileEngineNode {
     } else {
       LOG(FATAL) << "relay.backend.lower is not registred";
     }
+    if (!disk_key.empty()) {
+      disk_cache->Insert(disk_key, cache_node->func_name, cache_node->funcs);
+    }
     value->cached_func = CachedFunc(cache_node);
     return value;
   }
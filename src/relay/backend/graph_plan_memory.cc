@@ -7,6 +7,12 @@
 #include <tvm/relay/expr.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/pass.h>
+#include <tvm/runtime/device_api.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
 #include "../../common/arena.h"
 
 namespace tvm {
@@ -367,12 +373,306 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   std::unordered_map<const ExprNode*, std::vector<StorageToken*> > prototype_;
 };
 
+/*!
+ * \brief Plan memory by packing the lifetime intervals of the tensors
+ *  into one arena per device with explicit byte offsets.
+ *
+ *  Every intermediate tensor is a block that lives from the call which
+ *  creates it to the last call which uses it. Blocks whose lifetimes
+ *  overlap must not overlap in the arena, the rest may be reused freely,
+ *  which lets the planner recover the fragmentation that token reuse
+ *  cannot. Parameters and constants keep their own storage.
+ */
+class StorageArenaPlanner : public StorageAllocaBaseVisitor {
+ public:
+  /*!
+   * \param heuristic The packing order of the blocks,
+   *  can be "greedy_by_size", "best_fit_by_lifetime" or "auto".
+   */
+  explicit StorageArenaPlanner(std::string heuristic)
+      : heuristic_(heuristic) {
+    CHECK(heuristic_ == "greedy_by_size" ||
+          heuristic_ == "best_fit_by_lifetime" ||
+          heuristic_ == "auto")
+        << "Unknown arena planning heuristic " << heuristic_;
+  }
+  /*! \return The total number of bytes of all the arenas. */
+  size_t PlannedBytes() const {
+    size_t total = 0;
+    for (const auto& kv : arena_bytes_) {
+      total += kv.second;
+    }
+    return total;
+  }
+  /*!
+   * \return The sum over devices of the maximum bytes alive at a time,
+   *  which is a lower bound of the arena size of any planner.
+   */
+  size_t LowerBoundBytes() const {
+    return lower_bound_bytes_;
+  }
+
+  // Run arena planning for a function.
+  Map<Expr, Array<IntegerArray> > Plan(const Function& func) {
+    prototype_ = StorageAllocaInit(&arena_).GetInitTokenMap(func);
+    this->Run(func);
+    for (Block& b : blocks_) {
+      if (b.death < 0) b.death = step_;
+    }
+    // group blocks by device
+    std::map<int, std::vector<Block*> > device_blocks;
+    for (Block& b : blocks_) {
+      device_blocks[b.token->device_type].push_back(&b);
+    }
+    int64_t storage_id = num_fixed_tokens_;
+    for (auto& kv : device_blocks) {
+      lower_bound_bytes_ += MaxLiveBytes(kv.second);
+      size_t arena_size;
+      if (heuristic_ == "auto") {
+        // keep the offsets of the smaller plan.
+        size_t by_size = Pack(kv.second, false);
+        size_t by_lifetime = Pack(kv.second, true);
+        arena_size = by_size <= by_lifetime ? Pack(kv.second, false) : by_lifetime;
+      } else {
+        arena_size = Pack(kv.second, heuristic_ == "best_fit_by_lifetime");
+      }
+      arena_bytes_[kv.first] = arena_size;
+      for (Block* b : kv.second) {
+        b->token->storage_id = storage_id;
+      }
+      ++storage_id;
+    }
+
+    // The value of smap contains three integer arrays: the planned storage
+    // ids, the device types and the byte offsets in the storage.
+    Map<Expr, Array<IntegerArray> > smap;
+    for (const auto& kv : token_map_) {
+      std::vector<Integer> storage_ids;
+      std::vector<Integer> device_types;
+      std::vector<Integer> offsets;
+      for (StorageToken* tok : kv.second) {
+        size_t offset = 0;
+        auto it = block_index_.find(tok);
+        if (it != block_index_.end()) {
+          offset = blocks_[it->second].offset;
+        }
+        CHECK_LE(offset, static_cast<size_t>(std::numeric_limits<int>::max()))
+            << "The arena offset exceeds the range of the storage offset.";
+        storage_ids.push_back(tok->storage_id);
+        device_types.push_back(tok->device_type);
+        offsets.push_back(static_cast<int>(offset));
+      }
+      smap.Set(GetRef<Expr>(kv.first),
+               Array<IntegerArray>({storage_ids, device_types, offsets}));
+    }
+    return smap;
+  }
+
+ protected:
+  using StorageAllocaBaseVisitor::VisitExpr_;
+  /*! \brief A tensor living in [birth, death] of the execution order. */
+  struct Block {
+    StorageToken* token;
+    size_t size;
+    int birth;
+    int death;
+    size_t offset;
+  };
+
+  void CreateToken(const ExprNode* op, bool can_realloc) final {
+    CHECK(!token_map_.count(op));
+    auto it = prototype_.find(op);
+    CHECK(it != prototype_.end());
+    std::vector<StorageToken*> tokens;
+    for (StorageToken* tok : it->second) {
+      if (can_realloc) {
+        block_index_[tok] = blocks_.size();
+        blocks_.push_back({tok, AlignedSize(tok), step_, -1, 0});
+      } else {
+        tok->storage_id = num_fixed_tokens_++;
+        // ensure it never get de-allocated.
+        tok->ref_counter += 1;
+      }
+      tokens.push_back(tok);
+    }
+    token_map_[op] = tokens;
+  }
+  // The call map
+  void VisitExpr_(const CallNode* op) final {
+    std::vector<StorageToken*> args;
+    // for each input, visit argument token.
+    for (Expr arg : op->args) {
+      for (StorageToken* tok : GetToken(arg)) {
+        args.push_back(tok);
+      }
+    }
+    // create token for the call node.
+    CreateToken(op, true);
+    // check if there is orphaned output that can be released immediately.
+    for (StorageToken* tok : token_map_.at(op)) {
+      CheckForRelease(tok);
+    }
+    for (StorageToken* tok : args) {
+      tok->ref_counter -= 1;
+      CheckForRelease(tok);
+    }
+    ++step_;
+  }
+  /*!
+   * \brief Get the memory requirement aligned to the allocation alignment.
+   * \param prototype The prototype token.
+   * \return The required memory size.
+   */
+  static size_t AlignedSize(StorageToken* prototype) {
+    const TensorTypeNode* ttype = prototype->ttype;
+    CHECK(ttype != nullptr);
+    size_t size = 1;
+    for (IndexExpr dim : ttype->shape) {
+      const int64_t* pval = as_const_int(dim);
+      CHECK(pval != nullptr)
+          << "Cannot allocate memory symbolic tensor shape "
+          << ttype->shape;
+      CHECK_GE(*pval, 0)
+          << "Cannot allocate memory for tensor with negative shape"
+          << *pval;
+      size *= static_cast<size_t>(pval[0]);
+    }
+    size *= (ttype->dtype.bits() * ttype->dtype.lanes() + 7) / 8;
+    const size_t align = runtime::kAllocAlignment;
+    return (size + align - 1) / align * align;
+  }
+  /*!
+   * \brief Mark the end of the lifetime of a token.
+   * \param tok The token to be released.
+   */
+  void CheckForRelease(StorageToken* tok) {
+    CHECK_GE(tok->ref_counter, 0);
+    if (tok->ref_counter != 0) return;
+    auto it = block_index_.find(tok);
+    if (it != block_index_.end() && blocks_[it->second].death < 0) {
+      blocks_[it->second].death = step_;
+    }
+  }
+  /*!
+   * \brief Maximum total size of the blocks alive at the same step.
+   * \param blocks The blocks of one device.
+   */
+  static size_t MaxLiveBytes(const std::vector<Block*>& blocks) {
+    // +size at birth, -size after death
+    std::vector<std::pair<int, int64_t> > events;
+    for (const Block* b : blocks) {
+      events.emplace_back(b->birth, static_cast<int64_t>(b->size));
+      events.emplace_back(b->death + 1, -static_cast<int64_t>(b->size));
+    }
+    // release before allocate on the same step.
+    std::sort(events.begin(), events.end());
+    int64_t live = 0, max_live = 0;
+    for (const auto& e : events) {
+      live += e.second;
+      max_live = std::max(max_live, live);
+    }
+    return static_cast<size_t>(max_live);
+  }
+  /*!
+   * \brief Assign offsets to the blocks of one device.
+   *
+   *  Blocks are placed one at a time at the smallest gap between the
+   *  already placed blocks that are alive at the same time.
+   *
+   * \param blocks The blocks of one device.
+   * \param by_lifetime Place blocks in the order of their birth
+   *  instead of the decreasing order of their size.
+   * \return The size of the arena.
+   */
+  static size_t Pack(const std::vector<Block*>& blocks, bool by_lifetime) {
+    std::vector<Block*> order = blocks;
+    if (by_lifetime) {
+      std::stable_sort(order.begin(), order.end(), [](const Block* a, const Block* b) {
+          return a->birth != b->birth ? a->birth < b->birth : a->size > b->size;
+        });
+    } else {
+      std::stable_sort(order.begin(), order.end(), [](const Block* a, const Block* b) {
+          return a->size != b->size ? a->size > b->size : a->birth < b->birth;
+        });
+    }
+    std::vector<Block*> placed;
+    size_t arena_size = 0;
+    for (Block* b : order) {
+      std::vector<const Block*> conflicts;
+      for (const Block* p : placed) {
+        if (p->birth <= b->death && b->birth <= p->death) {
+          conflicts.push_back(p);
+        }
+      }
+      std::sort(conflicts.begin(), conflicts.end(), [](const Block* x, const Block* y) {
+          return x->offset < y->offset;
+        });
+      size_t best_offset = 0, best_gap = 0;
+      bool found = false;
+      size_t prev_end = 0;
+      for (const Block* p : conflicts) {
+        if (p->offset >= prev_end) {
+          size_t gap = p->offset - prev_end;
+          if (gap >= b->size && (!found || gap < best_gap)) {
+            best_offset = prev_end;
+            best_gap = gap;
+            found = true;
+          }
+        }
+        prev_end = std::max(prev_end, p->offset + p->size);
+      }
+      b->offset = found ? best_offset : prev_end;
+      arena_size = std::max(arena_size, b->offset + b->size);
+      placed.push_back(b);
+    }
+    return arena_size;
+  }
+
+ private:
+  // allocator
+  common::Arena arena_;
+  // packing heuristic
+  std::string heuristic_;
+  // the current step in the execution order
+  int step_{0};
+  // number of tokens that have their own storage
+  int64_t num_fixed_tokens_{0};
+  // the re-allocatable blocks
+  std::vector<Block> blocks_;
+  // map from token to its block
+  std::unordered_map<const StorageToken*, size_t> block_index_;
+  // planned arena size of each device
+  std::map<int, size_t> arena_bytes_;
+  // lower bound of the total arena size
+  size_t lower_bound_bytes_{0};
+  /*! \brief internal prototype token map */
+  std::unordered_map<const ExprNode*, std::vector<StorageToken*> > prototype_;
+};
+
 Map<Expr, Array<IntegerArray> > GraphPlanMemory(const Function& func) {
   return StorageAllocator().Plan(func);
 }
 
+Map<Expr, Array<IntegerArray> > GraphPlanMemoryArena(const Function& func,
+                                                      std::string heuristic) {
+  return StorageArenaPlanner(heuristic).Plan(func);
+}
+
 TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemory")
 .set_body_typed<Map<Expr, Array<IntegerArray> >(const Function&)>(GraphPlanMemory);
 
+TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemoryArena")
+.set_body_typed<Map<Expr, Array<IntegerArray> >(const Function&, std::string)>(
+    GraphPlanMemoryArena);
+
+TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemoryArenaStat")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+    StorageArenaPlanner planner(args[1]);
+    planner.Plan(args[0]);
+    // bytes can exceed int32, return them as int64 constants.
+    *ret = Array<Expr>({make_const(Int(64), planner.PlannedBytes()),
+                        make_const(Int(64), planner.LowerBoundBytes())});
+  });
+
 }  // namespace relay
 }  // namespace tvm
@@ -0,0 +1,80 @@
+/*!
+ *  Copyright (c) 2019 by Contributors
+ * \file sparse.cc
+ * \brief Property def of nn.sparse_dense operator.
+ */
+
+#include <tvm/relay/op.h>
+#include <vector>
+#include "../op_common.h"
+
+namespace tvm {
+namespace relay {
+
+// relay.nn.sparse_dense
+bool SparseDenseRel(const Array<Type>& types,
+                    int num_inputs,
+                    const Attrs& attrs,
+                    const TypeReporter& reporter) {
+  CHECK_EQ(types.size(), 5);
+  const auto* data = types[0].as<TensorTypeNode>();
+  const auto* weight_data = types[1].as<TensorTypeNode>();
+  const auto* weight_indptr = types[3].as<TensorTypeNode>();
+  if (data == nullptr || weight_data == nullptr || weight_indptr == nullptr) return false;
+  CHECK_EQ(data->shape.size(), 2)
+      << "SparseDense: only 2-D data is supported";
+  CHECK(weight_data->shape.size() == 1 || weight_data->shape.size() == 3)
+      << "SparseDense: weight_data must be 1-D (CSR) or 3-D (BSR)";
+  CHECK_EQ(weight_indptr->shape.size(), 1)
+      << "SparseDense: weight_indptr must be 1-D";
+
+  // CSR rows or BSR block rows of bs_r rows each
+  IndexExpr num_rows = weight_indptr->shape[0] - 1;
+  if (weight_data->shape.size() == 3) {
+    num_rows = num_rows * weight_data->shape[1];
+  }
+  Array<IndexExpr> oshape({data->shape[0], num_rows});
+
+  // assign output type
+  reporter->Assign(types[4], TensorTypeNode::make(oshape, data->dtype));
+  return true;
+}
+
+
+// Positional relay function to create sparse_dense operator used by frontend FFI.
+Expr MakeSparseDense(Expr data,
+                     Expr weight_data,
+                     Expr weight_indices,
+                     Expr weight_indptr) {
+  static const Op& op = Op::Get("nn.sparse_dense");
+  return CallNode::make(op, {data, weight_data, weight_indices, weight_indptr}, Attrs(), {});
+}
+
+
+TVM_REGISTER_API("relay.op.nn._make.sparse_dense")
+.set_body([](const TVMArgs& args, TVMRetValue* rv) {
+    runtime::detail::unpack_call<Expr, 4>(MakeSparseDense, args, rv);
+  });
+
+
+RELAY_REGISTER_OP("nn.sparse_dense")
+.describe(R"code(Applies a sparse linear transformation: :math:`Y = XW^T`
+with W sparse in CSR or BSR format.
+
+- **data**: `(m, k)`
+- **weight_data**: `(nnz,)` (CSR) or `(num_blocks, bs_r, bs_c)` (BSR)
+- **weight_indices**: `(nnz,)` (CSR) or `(num_blocks,)` (BSR)
+- **weight_indptr**: `(n + 1,)` (CSR) or `(n / bs_r + 1,)` (BSR)
+- **out**: `(m, n)`.
+
+)code" TVM_ADD_FILELINE)
+.set_num_inputs(4)
+.add_argument("data", "2D Tensor", "Input data.")
+.add_argument("weight_data", "1D or 3D Tensor", "Weight data matrix.")
+.add_argument("weight_indices", "1D Tensor", "Weight indices matrix.")
+.add_argument("weight_indptr", "1D Tensor", "Weight indptr matrix.")
+.set_support_level(10)
+.add_type_rel("SparseDense", SparseDenseRel);
+
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,91 @@
+/*!
+ * Copyright (c) 2019 by Contributors
+ *
+ * \file combine_parallel_dense.cc
+ * \brief Combine parallel dense ops into a single dense.
+ *
+ * This pass replaces dense ops that share the same input node with a single
+ * dense, whose weight is the concatenation of the original weights along the
+ * units axis. Elemwise and broadcast ops following dense, such as bias add,
+ * are also combined if possible. The output is sliced back into the branches.
+ *
+ * This turns the small GEMMs of parallel projections, such as the query, key
+ * and value projections of attention layers, into one larger GEMM.
+ */
+
+#include <tvm/relay/pass.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/op_attr_types.h>
+#include "./pattern_util.h"
+#include "./combine_parallel_op.h"
+
+
+namespace tvm {
+namespace relay {
+
+class ParallelDenseCombiner : public ParallelOpCombiner {
+ public:
+  explicit ParallelDenseCombiner(uint64_t min_num_branches)
+    : ParallelOpCombiner("nn.dense", min_num_branches) {
+  }
+
+ protected:
+  bool IsSupportedOp(const CallNode* n) final {
+    const auto* tweight = n->args[1]->type_as<TensorTypeNode>();
+    return as_const_int(tweight->shape[0]) != nullptr;
+  }
+
+  // Two dense ops can be combined if their weights only differ in the number of units.
+  bool CanOpsBeCombined(const CallNode* a, const CallNode* b) final {
+    AttrsEqual eq;
+    const auto* tweight_a = a->args[1]->type_as<TensorTypeNode>();
+    const auto* tweight_b = b->args[1]->type_as<TensorTypeNode>();
+    const auto* toutput_a = a->type_as<TensorTypeNode>();
+    const auto* toutput_b = b->type_as<TensorTypeNode>();
+    return eq(tweight_a->dtype, tweight_b->dtype) &&
+           eq(toutput_a->dtype, toutput_b->dtype) &&
+           eq(tweight_a->shape[1], tweight_b->shape[1]);
+  }
+
+  Call MakeCombinedOp(const Group& branches) final {
+    static const Op& dense = Op::Get("nn.dense");
+    Expr data = branches[0][0]->args[0];
+    int64_t num_units = 0;  // number of units of the combined weight
+    Array<Expr> weights;
+    for (const auto& branch : branches) {
+      weights.push_back(branch[0]->args[1]);
+      num_units += GetNumChannels(branch[0]);
+    }
+    Expr new_weight = MakeConcatenate(TupleNode::make(weights), 0);
+
+    const auto new_attrs = make_node<DenseAttrs>();
+    new_attrs->units = MakeConstScalar(Int(32), num_units);
+    return CallNode::make(dense, {data, new_weight}, Attrs{new_attrs}, {});
+  }
+
+  size_t GetChannelPos(const Call& combined) final {
+    // the units are the last axis of the output, which has the rank of the data.
+    const auto* tdata = combined->args[0]->type_as<TensorTypeNode>();
+    return tdata->shape.size() - 1;
+  }
+
+  int64_t GetNumChannels(const CallNode* root) final {
+    const auto* tweight = root->args[1]->type_as<TensorTypeNode>();
+    return *as_const_int(tweight->shape[0]);
+  }
+};
+
+Expr CombineParallelDense(const Expr& expr, uint64_t min_num_branches) {
+  return ParallelDenseCombiner(min_num_branches).Combine(expr);
+}
+
+TVM_REGISTER_API("relay._ir_pass.CombineParallelDense")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+  uint64_t min_num_branches = args.size() > 1 ? static_cast<int>(args[1]) : 3;
+  *ret = CombineParallelDense(args[0], min_num_branches);
+});
+
+}  // namespace relay
+}  // namespace tvm
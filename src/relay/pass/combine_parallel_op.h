@@ -0,0 +1,154 @@
+/*!
+ * Copyright (c) 2019 by Contributors
+ *
+ * \file combine_parallel_op.h
+ * \brief Abstract class to combine parallel ops and their successive element-wise ops.
+ */
+#ifndef TVM_RELAY_PASS_COMBINE_PARALLEL_OP_H_
+#define TVM_RELAY_PASS_COMBINE_PARALLEL_OP_H_
+
+#include <tvm/relay/expr_functor.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relay {
+
+using Branch = std::vector<const CallNode*>;
+using Group = std::vector<Branch>;
+using FIsSupportedOp = std::function<bool (const CallNode* n)>;
+using FAreCompatibleOps = std::function<bool (const CallNode* a, const CallNode* b)>;
+
+/*
+  Find parallel branches starting with the given op as shown below and then group branches by
+  the compatibility of the root ops. The op can be followed by zero or more elemwise or
+  broadcast ops. Intermediate nodes have exactly one successor. It is possible that branches
+  meet at a point, which should be handled in ParallelOpCombiner.
+
+         data
+        /    \
+      op      op
+      |        |
+      op       op
+      |        |
+*/
+class BranchGroupFinder : private ExprVisitor {
+ public:
+  /*!
+   * \brief Constructor
+   * \param op The op that indicates the start of each group.
+   * \param fis_supported_op Function that returns true if the op can be combined.
+   * \param fare_compatible_ops Function that returns true if two ops are compatible.
+   */
+  BranchGroupFinder(const Op& op,
+                    FIsSupportedOp fis_supported_op,
+                    FAreCompatibleOps fare_compatible_ops);
+
+  /*!
+   * \brief Find the groups of branches that can be combined.
+   * \param expr The expression.
+   * \return The groups, each branch starts with the op.
+   */
+  std::vector<Group> Find(const Expr& expr);
+
+ private:
+  /*! \brief The op that starts the branches. */
+  const Op& cached_op_;
+  /*! \brief Whether an op call can start a branch. */
+  FIsSupportedOp fis_supported_op_;
+  /*! \brief Whether two op calls can be combined. */
+  FAreCompatibleOps fare_compatible_ops_;
+  /*! \brief The inputs of the op calls that start branches. */
+  std::unordered_set<Expr, NodeHash, NodeEqual> op_roots_;
+  /*! \brief The consumers of each expression. */
+  std::unordered_map<Expr, std::vector<const CallNode*>, NodeHash, NodeEqual> children_map_;
+
+  // Create a branch starting from op.
+  Branch CreateBranch(const CallNode* op);
+
+  void VisitExpr_(const CallNode* n) final;
+};
+
+/*
+  Combine the branches found by BranchGroupFinder into a single op call, whose output is
+  sliced back into the branches. The root ops are concatenated along the channel axis of
+  the output, and the following elemwise or broadcast ops are combined level by level
+  as long as they are compatible in all the branches.
+*/
+class ParallelOpCombiner {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param op_name The name of the op to combine.
+   * \param min_num_branches The minimum number of branches for which the op is combined.
+   */
+  ParallelOpCombiner(const std::string& op_name, uint64_t min_num_branches);
+
+  /*!
+   * \brief Combine the parallel branches of the op in expr.
+   * \param expr The expression.
+   * \return The transformed expression.
+   */
+  Expr Combine(const Expr& expr);
+
+ protected:
+  /*!
+   * \brief Whether an op call can start a branch.
+   * \param n The op call.
+   */
+  virtual bool IsSupportedOp(const CallNode* n) = 0;
+
+  /*!
+   * \brief Whether two op calls can be combined.
+   * \param a The first op call.
+   * \param b The second op call.
+   */
+  virtual bool CanOpsBeCombined(const CallNode* a, const CallNode* b) = 0;
+
+  /*!
+   * \brief Make the op call that replaces the roots of the branches.
+   * \param branches The branches of a group.
+   * \return The combined op call.
+   */
+  virtual Call MakeCombinedOp(const Group& branches) = 0;
+
+  /*!
+   * \brief Get the position of the channel axis in the output of the combined op.
+   * \param combined The combined op call.
+   */
+  virtual size_t GetChannelPos(const Call& combined) = 0;
+
+  /*!
+   * \brief Get the number of output channels of the root of a branch.
+   * \param root The root op call.
+   */
+  virtual int64_t GetNumChannels(const CallNode* root) = 0;
+
+ private:
+  /*! \brief The op to combine. */
+  const Op& cached_op_;
+  /*! \brief The minimum number of branches for which the op is combined. */
+  uint64_t min_num_branches_;
+  /*! \brief The substitution of the outputs of the combined branches. */
+  std::unordered_map<Expr, Expr, NodeHash, NodeEqual> subst_map_;
+
+  // Check whether the argument of the combined call at index can be concatenated.
+  bool IsArgCompatible(const CallNode* a, const CallNode* b, size_t index, size_t channel_pos);
+  // Check if ops in depth-th level can be combined.
+  bool CheckLevel(const Group& branches, size_t depth, size_t channel_pos, size_t parent_index);
+  // Combine args and make the combined CallNode.
+  Call MakeCombinedCall(const Expr& data, const Group& branches, size_t depth,
+                        size_t channel_pos, size_t parent_index);
+  // Replace output of each branch with slices of the combined output.
+  void UpdateGroupOutput(const Expr& data, const Group& branches, size_t depth,
+                         size_t channel_pos);
+  // Combine the branches of a group.
+  void CombineBranches(const Group& branches);
+};
+
+}  // namespace relay
+}  // namespace tvm
+#endif  // TVM_RELAY_PASS_COMBINE_PARALLEL_OP_H_
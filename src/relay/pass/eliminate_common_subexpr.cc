@@ -0,0 +1,163 @@
+/*!
+ * Copyright (c) 2019 by Contributors
+ *
+ * \file eliminate_common_subexpr.cc
+ * \brief Combine common subexpressions.
+ *
+ * This pass replaces the calls, tuples and tuple projections which are equal
+ * to an earlier one with the earlier one. Frontends often emit duplicated
+ * reshapes, transposes, casts or even whole convolutions on the same input.
+ *
+ * The expression is visited in post-DFS order, so the arguments of a node are
+ * already deduplicated when the node is visited, and two nodes are equal if
+ * they have the same operator, the same arguments by reference, and alpha
+ * equal attributes and type arguments.
+ */
+#include <tvm/ir_operator.h>
+#include <tvm/relay/pass.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace relay {
+
+class CommonSubexprEliminator : public ExprMutator {
+ public:
+  /*!
+   * \param count_macs Whether to count the MACs of the removed calls,
+   *  which is only needed for the report.
+   */
+  explicit CommonSubexprEliminator(bool count_macs = false)
+      : count_macs_(count_macs) {}
+
+  /*! \brief The number of removed nodes. */
+  int64_t num_removed{0};
+  /*! \brief The number of MACs of the removed calls. */
+  int64_t num_removed_macs{0};
+
+  Expr VisitExpr_(const CallNode* call) final {
+    static auto op_stateful = Op::GetAttr<TOpIsStateful>("TOpIsStateful");
+    static auto fmac_count = Op::GetAttr<FMacCount>("FMacCount");
+    Expr new_expr = ExprMutator::VisitExpr_(call);
+    const CallNode* new_call = new_expr.as<CallNode>();
+    CHECK(new_call);
+    const OpNode* op = new_call->op.as<OpNode>();
+    // only combine calls to primitive operators without side effects.
+    if (op == nullptr || op_stateful.get(GetRef<Op>(op), false)) return new_expr;
+
+    size_t key = std::hash<const Node*>()(op);
+    for (const Expr& arg : new_call->args) {
+      key = HashCombine(key, arg.get());
+    }
+    Expr existing = Lookup(key, new_expr, [new_call](const Expr& e) {
+      const CallNode* other = e.as<CallNode>();
+      if (other == nullptr || !other->op.same_as(new_call->op) ||
+          other->args.size() != new_call->args.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < new_call->args.size(); ++i) {
+        if (!other->args[i].same_as(new_call->args[i])) return false;
+      }
+      return AlphaEqual(e, GetRef<Expr>(new_call));
+    });
+    if (count_macs_ && !existing.same_as(new_expr)) {
+      auto fmac = fmac_count.get(call->op, nullptr);
+      if (fmac != nullptr) num_removed_macs += fmac(GetRef<Call>(call));
+    }
+    return existing;
+  }
+
+  Expr VisitExpr_(const TupleNode* tuple) final {
+    Expr new_expr = ExprMutator::VisitExpr_(tuple);
+    const TupleNode* new_tuple = new_expr.as<TupleNode>();
+    CHECK(new_tuple);
+    size_t key = std::hash<size_t>()(new_tuple->fields.size());
+    for (const Expr& field : new_tuple->fields) {
+      key = HashCombine(key, field.get());
+    }
+    return Lookup(key, new_expr, [new_tuple](const Expr& e) {
+      const TupleNode* other = e.as<TupleNode>();
+      if (other == nullptr || other->fields.size() != new_tuple->fields.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < new_tuple->fields.size(); ++i) {
+        if (!other->fields[i].same_as(new_tuple->fields[i])) return false;
+      }
+      return true;
+    });
+  }
+
+  Expr VisitExpr_(const TupleGetItemNode* op) final {
+    Expr new_expr = ExprMutator::VisitExpr_(op);
+    const TupleGetItemNode* new_op = new_expr.as<TupleGetItemNode>();
+    CHECK(new_op);
+    size_t key = HashCombine(std::hash<int>()(new_op->index), new_op->tuple.get());
+    return Lookup(key, new_expr, [new_op](const Expr& e) {
+      const TupleGetItemNode* other = e.as<TupleGetItemNode>();
+      return other != nullptr && other->index == new_op->index &&
+          other->tuple.same_as(new_op->tuple);
+    });
+  }
+
+  Expr VisitExpr_(const FunctionNode* op) final {
+    // Do not share nodes between a function and the enclosing scope.
+    std::unordered_map<size_t, std::vector<Expr> > saved;
+    std::swap(saved, expr_map_);
+    Expr ret = ExprMutator::VisitExpr_(op);
+    std::swap(saved, expr_map_);
+    return ret;
+  }
+
+ private:
+  /*! \brief Whether to count the MACs of the removed calls. */
+  bool count_macs_;
+  /*! \brief The visited nodes, indexed by their hash. */
+  std::unordered_map<size_t, std::vector<Expr> > expr_map_;
+
+  static size_t HashCombine(size_t key, const Node* node) {
+    return key ^ (std::hash<const Node*>()(node) + 0x9e3779b9 + (key << 6) + (key >> 2));
+  }
+  /*!
+   * \brief Find an earlier node equal to expr, or remember expr.
+   * \param key The hash of expr.
+   * \param expr The expression.
+   * \param fequal Whether an earlier node is equal to expr.
+   * \return The earlier node if found, otherwise expr.
+   */
+  template<typename F>
+  Expr Lookup(size_t key, const Expr& expr, F fequal) {
+    std::vector<Expr>& candidates = expr_map_[key];
+    for (const Expr& candidate : candidates) {
+      if (fequal(candidate)) {
+        ++num_removed;
+        return candidate;
+      }
+    }
+    candidates.push_back(expr);
+    return expr;
+  }
+};
+
+Expr EliminateCommonSubexpr(const Expr& expr) {
+  return CommonSubexprEliminator().Mutate(expr);
+}
+
+TVM_REGISTER_API("relay._ir_pass.EliminateCommonSubexpr")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+  *ret = EliminateCommonSubexpr(args[0]);
+});
+
+TVM_REGISTER_API("relay._ir_pass.EliminateCommonSubexprReport")
+.set_body([](TVMArgs args, TVMRetValue* ret) {
+  CommonSubexprEliminator eliminator(true);
+  Expr expr = eliminator.Mutate(args[0]);
+  *ret = Array<NodeRef>({expr,
+                         make_const(Int(64), eliminator.num_removed),
+                         make_const(Int(64), eliminator.num_removed_macs)});
+});
+
+}  // namespace relay
+}  // namespace tvm
@@ -10,6 +10,8 @@
 #include <tvm/relay/pass.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op_attr_types.h>
+#include <algorithm>
+#include <limits>
 #include "./pattern_util.h"
 #include "../../common/arena.h"
 
@@ -53,6 +55,11 @@ namespace relay {
       will still run correctly.
   - CommitFuse: mark all the nodes between source and post-dominator as the same group.
   - We use an Union-Find data structure to manage the groups.
+
+  Optionally, a fusion that passes CheckPath is only committed if a cost function
+  finds it profitable. The default cost function estimates the memory traffic saved
+  by not materializing the intermediate results, minus the traffic added by
+  recomputing inlined nodes that have several consumers in the group.
 */
 using common::LinkNode;
 using common::LinkedList;
@@ -444,6 +451,17 @@ class GraphPartitioner {
  public:
   explicit GraphPartitioner(common::Arena* arena, int opt_level)
       : arena_(arena), opt_level_(opt_level) {}
+  /*!
+   * \brief Create a partitioner which only commits profitable fusions.
+   * \param arena The arena used for data allocation.
+   * \param opt_level The optimization level.
+   * \param fcost The cost function, see FuseOps. Use the default estimate if it is null.
+   * \param log If not nullptr, the accepted and rejected fusions are dumped into it.
+   */
+  GraphPartitioner(common::Arena* arena, int opt_level,
+                   bool cost_mode, runtime::PackedFunc fcost, std::ostream* log)
+      : arena_(arena), opt_level_(opt_level),
+        cost_mode_(cost_mode), fcost_(fcost), log_(log) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -459,6 +477,8 @@ class GraphPartitioner {
      * this field is not nullptr only if pattern is kOutEWiseFusable.
      */
     const tvm::Node* master_ref{nullptr};
+    /*! \brief The number of graph nodes in the group, valid at the root. */
+    int num_nodes{1};
     /*!
      * \brief Find the group root, perform path compression
      * \return The root type node.
@@ -490,6 +510,14 @@ class GraphPartitioner {
   common::Arena* arena_;
   /*! \brief optimization level for fuse operation. */
   int opt_level_;
+  /*! \brief Whether only commit the profitable fusions. */
+  bool cost_mode_{false};
+  /*! \brief The cost function, use the default estimate if it is null. */
+  runtime::PackedFunc fcost_;
+  /*! \brief The stream to dump the fusion decisions. */
+  std::ostream* log_{nullptr};
+  /*! \brief The number of nodes above which a fused group is charged for its locality. */
+  static constexpr int kMaxLocalNodes = 16;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -554,6 +582,7 @@ class GraphPartitioner {
     parent = parent->FindRoot();
     if (child == parent) return;
     child->parent = parent;
+    parent->num_nodes += child->num_nodes;
     // update master ref and pattern
     if (child->master_ref != nullptr) {
       CHECK(parent->master_ref == nullptr);
@@ -591,6 +620,178 @@ class GraphPartitioner {
     CommitFuse_(src, sink, target);
   }
 
+  // Collect the nodes between src and sink which are not in the group of sink yet.
+  void CollectPath_(IndexedForwardGraph::Node* src,
+                    IndexedForwardGraph::Node* sink,
+                    std::vector<IndexedForwardGraph::Node*>* path) {
+    if (src == sink) return;
+    if (visited_.count(src)) return;
+    visited_.insert(src);
+    if (groups_[src->index]->FindRoot() != groups_[sink->index]->FindRoot()) {
+      path->push_back(src);
+    }
+    for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+      CollectPath_(link->value.node, sink, path);
+    }
+  }
+  /*!
+   * \brief Get the number of bytes of the value of an expression.
+   * \return The number of bytes, -1 if unknown.
+   */
+  static int64_t ValueBytes(const Type& type) {
+    if (const auto* ttype = type.as<TensorTypeNode>()) {
+      int64_t bytes = ttype->dtype.bytes() * ttype->dtype.lanes();
+      for (const auto& dim : ttype->shape) {
+        const auto* value = dim.as<IntImm>();
+        if (value == nullptr) return -1;
+        bytes *= value->value;
+      }
+      return bytes;
+    } else if (const auto* tuple = type.as<TupleTypeNode>()) {
+      int64_t bytes = 0;
+      for (const auto& field : tuple->fields) {
+        int64_t field_bytes = ValueBytes(field);
+        if (field_bytes < 0) return -1;
+        bytes += field_bytes;
+      }
+      return bytes;
+    }
+    return -1;
+  }
+  static int64_t ValueBytes(const tvm::Node* ref) {
+    const auto* expr = static_cast<const ExprNode*>(ref);
+    if (!expr->checked_type_.defined()) return -1;
+    return ValueBytes(expr->checked_type_);
+  }
+  /*!
+   * \brief Get the number of bytes of a producer read by a consumer.
+   *  An injective consumer reads at most one element of each input per output element.
+   * \param bytes The number of bytes of the producer.
+   * \param consumer The consumer node.
+   */
+  static int64_t ReadBytes(int64_t bytes, const IndexedForwardGraph::Node* consumer) {
+    if (consumer->pattern > kInjective) return bytes;
+    int64_t consumer_bytes = ValueBytes(consumer->ref);
+    if (consumer_bytes < 0) return bytes;
+    return std::min(bytes, consumer_bytes);
+  }
+  /*!
+   * \brief Estimate the memory traffic saved by fusing the path into sink.
+   *
+   *  Each intermediate result is neither written nor read back by its consumers.
+   *  An injective node with several consumers is recomputed by each of them,
+   *  which reads again the part of its external inputs that the consumer needs.
+   *  A fused group of more than kMaxLocalNodes nodes loses locality: its loop body
+   *  spills, which is charged as a write and a read of the output per extra node.
+   *
+   * \param path The nodes that become internal to the fused group.
+   * \param sink The post-dominator the path is fused into.
+   * \return The estimated number of bytes saved, +inf if it cannot be estimated.
+   */
+  double EstimateFuseGain(const std::vector<IndexedForwardGraph::Node*>& path,
+                          IndexedForwardGraph::Node* sink) {
+    const double kInf = std::numeric_limits<double>::infinity();
+    std::unordered_set<const tvm::Node*> internal;
+    for (auto* node : path) {
+      internal.insert(node->ref);
+    }
+    double gain = 0;
+    for (auto* node : path) {
+      int64_t bytes = ValueBytes(node->ref);
+      if (bytes < 0) return kInf;
+      std::vector<int64_t> reads;
+      for (auto link = node->outputs.head; link != nullptr; link = link->next) {
+        reads.push_back(ReadBytes(bytes, link->value.node));
+      }
+      gain += bytes;
+      for (int64_t read : reads) {
+        gain += read;
+      }
+      if (!node->ref->is_type<CallNode>() || reads.size() <= 1 ||
+          node->pattern > kInjective) {
+        continue;
+      }
+      // The inputs are read once to compute the node, and by each consumer once fused.
+      for (const Expr& arg : static_cast<const CallNode*>(node->ref)->args) {
+        if (internal.count(arg.get())) continue;
+        int64_t arg_bytes = ValueBytes(arg.get());
+        if (arg_bytes < 0) return kInf;
+        gain += std::min(arg_bytes, bytes);
+        for (int64_t read : reads) {
+          gain -= std::min(arg_bytes, read);
+        }
+      }
+    }
+    std::unordered_set<Group*> roots;
+    int num_nodes = 0;
+    for (auto* node : path) {
+      Group* root = groups_[node->index]->FindRoot();
+      if (roots.insert(root).second) num_nodes += root->num_nodes;
+    }
+    Group* sink_root = groups_[sink->index]->FindRoot();
+    if (roots.insert(sink_root).second) num_nodes += sink_root->num_nodes;
+    if (num_nodes > kMaxLocalNodes) {
+      int64_t sink_bytes = ValueBytes(sink->ref);
+      if (sink_bytes < 0) return kInf;
+      gain -= 2.0 * sink_bytes * (num_nodes - kMaxLocalNodes);
+    }
+    return gain;
+  }
+  // Name of a node in the fusion dump.
+  static std::string NodeName(const IndexedForwardGraph::Node* node) {
+    std::ostringstream os;
+    const CallNode* call = node->ref->is_type<CallNode>() ?
+        static_cast<const CallNode*>(node->ref) : nullptr;
+    if (call != nullptr && call->op.as<OpNode>()) {
+      os << call->op.as<OpNode>()->name;
+    } else {
+      os << node->ref->type_key();
+    }
+    os << "#" << node->index;
+    return os.str();
+  }
+  /*!
+   * \brief Try to fuse src into its post-dominator sink.
+   * \param src The source node.
+   * \param sink The post-dominator.
+   * \param fcond The condition of the nodes on the path, see CheckPath.
+   */
+  template<typename F>
+  void TryFuse(IndexedForwardGraph::Node* src,
+               IndexedForwardGraph::Node* sink,
+               F fcond) {
+    if (!CheckPath(src, sink, fcond)) {
+      if (log_ != nullptr) {
+        *log_ << "reject " << NodeName(src) << " -> " << NodeName(sink)
+              << ": pattern\n";
+      }
+      return;
+    }
+    if (cost_mode_ || log_ != nullptr) {
+      std::vector<IndexedForwardGraph::Node*> path;
+      visited_.clear();
+      CollectPath_(src, sink, &path);
+      double gain = EstimateFuseGain(path, sink);
+      if (fcost_ != nullptr) {
+        Array<Expr> nodes;
+        for (auto* node : path) {
+          nodes.push_back(GetRef<Expr>(static_cast<const ExprNode*>(node->ref)));
+        }
+        gain = fcost_(GetRef<Expr>(static_cast<const ExprNode*>(src->ref)),
+                      GetRef<Expr>(static_cast<const ExprNode*>(sink->ref)),
+                      nodes, gain);
+      }
+      bool accept = !cost_mode_ || gain > 0;
+      if (log_ != nullptr) {
+        *log_ << (accept ? "accept " : "reject ")
+              << NodeName(src) << " -> " << NodeName(sink)
+              << ": fused_nodes=" << path.size() << " gain=" << gain << "\n";
+      }
+      if (!accept) return;
+    }
+    CommitFuse(src, sink);
+  }
+
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph) {
     groups_.resize(graph.post_dfs_order.size());
@@ -639,9 +840,7 @@ class GraphPartitioner {
           auto fcond = [](OpPatternKind kind, bool is_sink) {
             return kind <= kBroadcast;
           };
-          if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
-            CommitFuse(graph_node, dom_node->parent->gnode);
-          }
+          TryFuse(graph_node, dom_node->parent->gnode, fcond);
         }
       } else if (group_node->pattern <= kBroadcast) {
         // Pre-condition: can only be fused to parent which is injective or reduction.
@@ -659,9 +858,7 @@ class GraphPartitioner {
                       kind == kOutEWiseFusable);
             }
           };
-          if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
-            CommitFuse(graph_node, dom_node->parent->gnode);
-          }
+          TryFuse(graph_node, dom_node->parent->gnode, fcond);
         }
       } else if (group_node->pattern == kInjective) {
         // defer injective fusion to second phase.
@@ -671,9 +868,7 @@ class GraphPartitioner {
         auto fcond = [](OpPatternKind kind, bool is_sink) {
           return kind <= kInjective;
         };
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
-          CommitFuse(graph_node, dom_node->parent->gnode);
-        }
+        TryFuse(graph_node, dom_node->parent->gnode, fcond);
       } else {
         // do nothing.
         CHECK(group_node->pattern == kCommReduce);
@@ -698,10 +893,13 @@ GraphPartitioner::Partition(const IndexedForwardGraph& graph) {
 class FuseMutator : private ExprMutator {
  public:
   // Run the transform
-  Expr Transform(const Expr& body, int fuse_opt_level) {
+  Expr Transform(const Expr& body, int fuse_opt_level,
+                 bool cost_mode = false,
+                 runtime::PackedFunc fcost = nullptr,
+                 std::ostream* log = nullptr) {
     // setup the group map.
     auto graph = IndexedForwardGraph::Create(&arena_, body);
-    auto groups = GraphPartitioner(&arena_, fuse_opt_level).Partition(
+    auto groups = GraphPartitioner(&arena_, fuse_opt_level, cost_mode, fcost, log).Partition(
         graph);
     for (size_t nid = 0; nid < graph.post_dfs_order.size(); ++nid) {
       CHECK(graph.post_dfs_order[nid]->ref != nullptr);
@@ -855,9 +1053,41 @@ Expr FuseOps(const Expr& expr, int fuse_opt_level) {
   return FuseMutator().Transform(expr, fuse_opt_level);
 }
 
+Expr FuseOps(const Expr& expr, int fuse_opt_level,
+             runtime::PackedFunc fcost, std::ostream* log) {
+  return FuseMutator().Transform(expr, fuse_opt_level, true, fcost, log);
+}
+
+// Get the optional cost function argument.
+// None means fusing by pattern only, "memory" means the default estimate.
+bool GetFuseCostArg(const TVMArgs& args, int index, runtime::PackedFunc* fcost) {
+  if (args.size() <= index || args[index].type_code() == kNull) return false;
+  if (args[index].type_code() == kStr) {
+    std::string name = args[index];
+    CHECK_EQ(name, "memory") << "Unknown fusion cost model " << name;
+    return true;
+  }
+  *fcost = args[index];
+  return true;
+}
+
 TVM_REGISTER_API("relay._ir_pass.FuseOps")
 .set_body([](TVMArgs args, TVMRetValue *ret) {
-    *ret = FuseOps(args[0], args[1]);
+    runtime::PackedFunc fcost;
+    if (GetFuseCostArg(args, 2, &fcost)) {
+      *ret = FuseOps(args[0], args[1], fcost, nullptr);
+    } else {
+      *ret = FuseOps(args[0], args[1]);
+    }
+});
+
+TVM_REGISTER_API("relay._ir_pass.FuseOpsDump")
+.set_body([](TVMArgs args, TVMRetValue *ret) {
+    runtime::PackedFunc fcost;
+    bool cost_mode = GetFuseCostArg(args, 2, &fcost);
+    std::ostringstream os;
+    FuseMutator().Transform(args[0], args[1], cost_mode, fcost, &os);
+    *ret = os.str();
 });
 }  // namespace relay
 }  // namespace tvm
@@ -49,6 +49,16 @@ Type WithGradientType(const Type&);
  */
 Expr FirstOrderGradient(const Expr& e, const Module& mod);
 
+/*! \brief Same as FirstOrderGradient, but only keep some forward intermediates
+ *  (the checkpoints) alive for the backward pass, and recompute the others there.
+ *
+ *  The checkpoints are the inputs, the constants, the expressions annotated with
+ *  annotation.checkpoint, and, if checkpoint_budget > 0, an intermediate whenever the
+ *  intermediates computed since the last checkpoint take more than checkpoint_budget bytes.
+ *  The backward pass of the intermediates between two checkpoints recompute them once.
+ */
+Expr FirstOrderGradient(const Expr& e, const Module& mod, int64_t checkpoint_budget);
+
 Type WithGradientType(const Type& t) {
   // TODO(M.K.): stricter checking
   auto ty = t.as<FuncTypeNode>();
@@ -86,11 +96,42 @@ using ADValue = std::shared_ptr<ADValueNode>;
 /*! \brief AD over a program which generates a tensor output. */
 struct ADTensor : ADValueNode {
   Expr foward;
-  mutable Expr reverse;  // must be a variable to avoid duplication
+  // must be a variable to avoid duplication.
+  // undefined until the first contribution in the backward pass,
+  // so no zero adjoint is allocated during the forward pass.
+  mutable Expr reverse;
+  // the call computing foward and its arguments, used to rematerialize foward.
+  Call call;
+  std::vector<ADValue> inputs;
+  // whether foward is kept alive for the backward pass.
+  bool checkpoint{true};
+  // the number of checkpoints created before foward.
+  int segment{0};
   ADTensor(LetList* ll, const Expr& foward) :
-    foward(ll->Push(foward)), reverse(ll->Push(ZeroLike(this->foward))) { }
+    foward(ll->Push(foward)) { }
+  // accumulate a contribution to the adjoint.
+  void AddReverse(LetList* ll, const Expr& grad) const {
+    reverse = ll->Push(reverse.defined() ? Add(reverse, grad) : grad);
+  }
+  // the adjoint, zero if nothing was contributed.
+  Expr GetReverse(LetList* ll) const {
+    return reverse.defined() ? reverse : ll->Push(ZeroLike(foward));
+  }
 };
 
+//! \brief the number of bytes of a tensor type, 0 if unknown.
+int64_t TensorBytes(const Type& t) {
+  const auto* tt = t.as<TensorTypeNode>();
+  if (tt == nullptr) return 0;
+  int64_t bytes = tt->dtype.bytes() * tt->dtype.lanes();
+  for (const auto& dim : tt->shape) {
+    const int64_t* value = as_const_int(dim);
+    if (value == nullptr) return 0;
+    bytes *= *value;
+  }
+  return bytes;
+}
+
 /*! \brief A staged representation of the program, we reflect
  * Relay functions into a function over fragments of AD. We
  * can compute away this function to obtain a reverse mode program.
@@ -111,9 +152,41 @@ struct ReverseAD : ExprFunctor<ADValue(const Expr &)> {
   // we assume no closure so no need for lexical scoping
   std::unordered_map<Var, ADValue, NodeHash, NodeEqual> env;
   LetList* ll;
+  // whether intermediates which are not checkpoints are recomputed in the backward pass.
+  bool remat{false};
+  // automatically create a checkpoint when a segment exceeds this number of bytes.
+  int64_t checkpoint_budget{0};
+  // the current segment and its size in bytes.
+  int segment{0};
+  int64_t segment_bytes{0};
+  // the rematerialized intermediates, valid for the backward pass of remat_segment.
+  int remat_segment{-1};
+  std::unordered_map<const ADTensor*, Expr> remat_memo;
 
   ReverseAD(LetList* ll) : ll(ll) { }
 
+  // make t a checkpoint, and start a new segment.
+  void MarkCheckpoint(ADTensor* t) {
+    t->checkpoint = true;
+    ++segment;
+    segment_bytes = 0;
+  }
+
+  // get the forward value of an argument in the backward pass.
+  Expr Rematerialize(LetList* ll, const ADValue& v) {
+    const ADTensor& t = v->get<ADTensor>();
+    if (t.checkpoint) return t.foward;
+    auto it = remat_memo.find(&t);
+    if (it != remat_memo.end()) return it->second;
+    tvm::Array<Expr> call_args;
+    for (const ADValue& input : t.inputs) {
+      call_args.push_back(Rematerialize(ll, input));
+    }
+    Expr e = ll->Push(CallNode::make(t.call->op, call_args, t.call->attrs, t.call->type_args));
+    remat_memo[&t] = e;
+    return e;
+  }
+
   ADValue VisitExpr_(const OpNode* op) final {
     Op op_ref = GetRef<Op>(op);
     CHECK(rev_map.count(op_ref))
@@ -127,11 +200,31 @@ struct ReverseAD : ExprFunctor<ADValue(const Expr &)> {
         }
         auto orig = CallNode::make(op_ref, call_args, attrs, type_args);
         auto ret = std::make_shared<ADTensor>(ll, orig);
+        if (remat) {
+          ret->call = orig;
+          ret->inputs = args;
+          ret->checkpoint = false;
+          ret->segment = segment;
+        }
         backprop_actions.push_back([this, args, orig, ret, op_ref](LetList* ll) {
-            tvm::Array<Expr> rev = rev_map[op_ref](orig, ret->reverse);
+            // the result does not depend on ret, so neither do args through it.
+            if (!ret->reverse.defined()) return;
+            Call call = orig;
+            if (remat) {
+              // the rematerialized values of a segment are only reused in its backward pass.
+              if (ret->segment != remat_segment) {
+                remat_memo.clear();
+                remat_segment = ret->segment;
+              }
+              tvm::Array<Expr> call_args;
+              for (const ADValue& arg : args) {
+                call_args.push_back(Rematerialize(ll, arg));
+              }
+              call = CallNode::make(op_ref, call_args, orig->attrs, orig->type_args);
+            }
+            tvm::Array<Expr> rev = rev_map[op_ref](call, ret->reverse);
             for (size_t i = 0; i < args.size(); ++i) {
-              args[i]->get<ADTensor>().reverse =
-                ll->Push(Add(args[i]->get<ADTensor>().reverse, rev[i]));
+              args[i]->get<ADTensor>().AddReverse(ll, rev[i]);
             }
           });
         return ret;
@@ -144,12 +237,27 @@ struct ReverseAD : ExprFunctor<ADValue(const Expr &)> {
   }
 
   ADValue VisitExpr_(const CallNode* op) final {
+    static const Op& checkpoint_op = Op::Get("annotation.checkpoint");
+    if (remat && op->op.same_as(checkpoint_op)) {
+      ADValue ret = VisitExpr(op->args[0]);
+      ADTensor& t = ret->get<ADTensor>();
+      if (!t.checkpoint) MarkCheckpoint(&t);
+      return ret;
+    }
     ADValue f = VisitExpr(op->op);
     std::vector<ADValue> args;
     for (const auto& arg : op->args) {
       args.push_back(VisitExpr(arg));
     }
-    return f->get<ADFunction>().func(args, op->attrs, op->type_args);
+    ADValue ret = f->get<ADFunction>().func(args, op->attrs, op->type_args);
+    if (remat && checkpoint_budget > 0 && op->checked_type_.defined()) {
+      ADTensor& t = ret->get<ADTensor>();
+      if (!t.checkpoint) {
+        segment_bytes += TensorBytes(op->checked_type_);
+        if (segment_bytes > checkpoint_budget) MarkCheckpoint(&t);
+      }
+    }
+    return ret;
   }
 
   ADValue VisitExpr_(const FunctionNode* op) final {
@@ -173,6 +281,10 @@ struct ReverseAD : ExprFunctor<ADValue(const Expr &)> {
 };
 
 Expr FirstOrderGradient(const Expr& re, const Module& mod) {
+  return FirstOrderGradient(re, mod, -1);
+}
+
+Expr FirstOrderGradient(const Expr& re, const Module& mod, int64_t checkpoint_budget) {
   // Currently we first remove any global functions for the first
   // order case.
   auto e = DeGlobal(mod, re);
@@ -183,6 +295,10 @@ Expr FirstOrderGradient(const Expr& re, const Module& mod) {
   // We will then build a sequence of lets which implement reverse mode.
   Expr body = LetList::With([&](LetList* ll) {
     ReverseAD reverse_ad(ll);
+    if (checkpoint_budget >= 0) {
+      reverse_ad.remat = true;
+      reverse_ad.checkpoint_budget = checkpoint_budget;
+    }
     ADValue rev = reverse_ad(e);
     std::vector<ADValue> args;
     for (const auto& p : f->params) {
@@ -199,7 +315,7 @@ Expr FirstOrderGradient(const Expr& re, const Module& mod) {
         }
         std::vector<Expr> grad_res;
         for (const auto& a : args) {
-          grad_res.push_back(a->get<ADTensor>().reverse);
+          grad_res.push_back(a->get<ADTensor>().GetReverse(ll));
         }
         return TupleNode::make(grad_res);
       });
@@ -228,8 +344,12 @@ Expr FirstOrderGradient(const Expr& re, const Module& mod) {
 
 TVM_REGISTER_API("relay._ir_pass.first_order_gradient")
   .set_body([](TVMArgs args, TVMRetValue* ret) {
-      CHECK_EQ(args.size(), 2);
-      *ret = FirstOrderGradient(args[0], args[1]);
+      CHECK(args.size() == 2 || args.size() == 3);
+      if (args.size() == 2) {
+        *ret = FirstOrderGradient(args[0], args[1]);
+      } else {
+        *ret = FirstOrderGradient(args[0], args[1], args[2].operator int64_t());
+      }
     });
 
 }  // namespace relay
@@ -3,12 +3,13 @@
  *
  * \file mac_count.cc
  * \brief Pass to roughly count the number of MACs (Multiply-Accumulate) 
- * operations of a model. Only MACs in CONV and Dense ops are counted.
+ * operations of a model. Only MACs in CONV, Dense and BatchMatmul ops are counted.
  * This pass is valid after the type infer pass is called,
  * otherwise the count is 0.
  */
 
 #include <tvm/relay/op.h>
+#include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/attrs/nn.h>
 #include <tvm/relay/expr_functor.h>
 #include "../op/layout.h"
@@ -27,14 +28,6 @@ inline int64_t GetCartesianProd(Array<IndexExpr> arr) {
   return ret;
 }
 
-/*
- * \brief Preparation function for MAC count.
- * \param call_node The call node.
- * \return The number of MACs.
- */
-using FMacCount = runtime::TypedPackedFunc<
-  int64_t(const Call& call_node)>;
-
 //----------------------------------------------
 // Per operator defs for MAC count
 //----------------------------------------------
@@ -93,19 +86,38 @@ int64_t DenseMacCount(const Call& call_node) {
   return count;
 }
 
+int64_t BatchMatmulMacCount(const Call& call_node) {
+  if (!call_node->checked_type_.defined()) {
+    LOG(WARNING) << "The infer type pass should be called before the mac count pass";
+    return 0;
+  }
+  Array<Expr> args = call_node->args;
+  CHECK(args.size() == 2)
+      << "The number of input arguments of a BatchMatmul node should be 2.";
+  const auto* x_type = args[0]->checked_type().as<TensorTypeNode>();
+  const auto* out_type = call_node->checked_type().as<TensorTypeNode>();
+  CHECK(x_type->shape.size() == 3 && out_type->shape.size() == 3)
+      << "The dimension of an input tensor to BatchMatmul node should be 3.";
+  int64_t k = static_cast<int64_t>(x_type->shape[2].as<IntImm>()->value);
+  return GetCartesianProd(out_type->shape) * k;
+}
+
 RELAY_REGISTER_OP("nn.conv2d")
 .set_attr<FMacCount>("FMacCount", ConvMacCount);
 
 RELAY_REGISTER_OP("nn.dense")
 .set_attr<FMacCount>("FMacCount", DenseMacCount);
 
+RELAY_REGISTER_OP("nn.batch_matmul")
+.set_attr<FMacCount>("FMacCount", BatchMatmulMacCount);
+
 class MacCounter : private ExprVisitor {
  public:
   MacCounter() {
     count_ = 0;
   }
   static int64_t GetTotalMacNumber(const Expr& expr) {
-    LOG(INFO) << "This pass only counts MACs in direct CONV 2D and Dense ops";
+    LOG(INFO) << "This pass only counts MACs in direct CONV 2D, Dense and BatchMatmul ops";
     MacCounter counter;
     counter(expr);
     return counter.count_;
@@ -14,6 +14,7 @@
 #include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/attrs/nn.h>
 #include <string>
+#include <vector>
 #include "../op/layout.h"
 
 
@@ -192,6 +193,30 @@ inline Constant MakeConstantScalar(DataType dtype, T value) {
   return ConstantNode::make(arr);
 }
 
+/*!
+ * \brief Create a Constant with a tensor.
+ *
+ * \param dtype The data type.
+ * \param shape The shape of the tensor.
+ * \param value The values of the tensor in row major order.
+ * \return A Constant.
+ */
+template<typename T>
+inline Constant MakeConstantTensor(DataType dtype,
+                                   std::vector<int64_t> shape,
+                                   const std::vector<T>& value) {
+  runtime::NDArray arr = runtime::NDArray::Empty(shape, Type2TVMType(dtype), {kDLCPU, 0});
+  int64_t size = 1;
+  for (int64_t dim : shape) size *= dim;
+  CHECK_EQ(static_cast<int64_t>(value.size()), size);
+  TVM_DTYPE_DISPATCH(dtype, DType, {
+    for (int64_t i = 0; i < size; ++i) {
+      static_cast<DType*>(arr->data)[i] = value[i];
+    }
+  })
+  return ConstantNode::make(arr);
+}
+
 inline Expr GetField(Expr t, size_t i) {
   return TupleGetItemNode::make(t, i);
 }
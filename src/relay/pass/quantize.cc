@@ -11,6 +11,7 @@
 #include <tvm/relay/pass.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op_attr_types.h>
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -28,6 +29,7 @@ struct SimulatedQuantizeAttrs : public tvm::AttrsNode<SimulatedQuantizeAttrs> {
   int kind;
   bool sign;
   std::string rounding;
+  int axis;
 
   TVM_DECLARE_ATTRS(SimulatedQuantizeAttrs, "relay.attrs.SimulatedQuantizeAttrs") {
     TVM_ATTR_FIELD(kind)
@@ -36,6 +38,9 @@ struct SimulatedQuantizeAttrs : public tvm::AttrsNode<SimulatedQuantizeAttrs> {
         .describe("whether to use signed data type.");
     TVM_ATTR_FIELD(rounding).set_default("round")
         .describe("rounding mode. Can be 'floor', 'ceil', 'round'");
+    TVM_ATTR_FIELD(axis).set_default(-1)
+        .describe("The output channel axis of the weight, used for per channel scale. "
+                  "-1 if the field has no channel axis.");
   }
 };
 
@@ -53,7 +58,10 @@ bool SimulatedQuantizeRel(const Array<Type>& types,
   CHECK(data != nullptr);
   CHECK_NE(data->shape.size(), 0) << "Input shape cannot be empty";
 
-  reporter->Assign(types[1], TensorTypeNode::make({}, Float(32)));    // dom_scale
+  // dom_scale, a per channel dom_scale can be bound to the weight field after calibration
+  if (types[1].as<TensorTypeNode>() == nullptr) {
+    reporter->Assign(types[1], TensorTypeNode::make({}, Float(32)));
+  }
   reporter->Assign(types[2], TensorTypeNode::make({}, Float(32)));    // clip_min
   reporter->Assign(types[3], TensorTypeNode::make({}, Float(32)));    // clip_max
   reporter->Assign(types[4], types[0]);                               // output
@@ -64,7 +72,8 @@ RELAY_REGISTER_OP("relay.op.annotation.simulated_quantize")
 .describe(R"code(simulated quantize op)code" TVM_ADD_FILELINE)
 .set_num_inputs(4)
 .add_argument("data", "Tensor", "The input data.")
-.add_argument("dom_scale", "Tensor", "The domain scale of input data. It should be a scalar")
+.add_argument("dom_scale", "Tensor", "The domain scale of input data. "
+              "It should be a scalar, or broadcastable to the weight if it is per channel")
 .add_argument("clip_min", "Tensor", "lower bound. It should be a scalar")
 .add_argument("clip_max", "Tensor", "upper bound. It should be a scalar")
 .set_attrs_type_key("relay.attrs.SimulatedQuantizeAttrs")
@@ -72,13 +81,14 @@ RELAY_REGISTER_OP("relay.op.annotation.simulated_quantize")
 .add_type_rel("SimulatedQuantize", SimulatedQuantizeRel);
 
 TVM_REGISTER_API("relay._quantize.simulated_quantize")
-.set_body_typed<Expr(Expr, Expr, Expr, Expr, int, bool, std::string)>(
+.set_body_typed<Expr(Expr, Expr, Expr, Expr, int, bool, std::string, int)>(
   [](Expr data, Expr dom_scale, Expr clip_min, Expr clip_max,
-     int kind, bool sign, std::string rounding) {
+     int kind, bool sign, std::string rounding, int axis) {
     auto attrs = make_node<SimulatedQuantizeAttrs>();
     attrs->kind = kind;
     attrs->sign = sign;
     attrs->rounding = rounding;
+    attrs->axis = axis;
     static const Op& op = Op::Get("relay.op.annotation.simulated_quantize");
     return CallNode::make(op, {data, dom_scale, clip_min, clip_max}, Attrs(attrs), {});
   });
@@ -158,25 +168,111 @@ inline Expr ForwardOp(const Call& ref_call, const Array<Expr>& args) {
 }
 
 
+/*! \brief Get the values of a dom scale, which is a scalar or a per channel constant. */
+std::vector<float> GetDomScales(const Expr& dom_scale) {
+  const auto* n = dom_scale.as<ConstantNode>();
+  CHECK(n) << "dom_scale is expected to be a constant after calibration";
+  CHECK(n->data->dtype.code == kDLFloat && n->data->dtype.bits == 32);
+  int64_t size = 1;
+  for (int i = 0; i < n->data->ndim; ++i) size *= n->data->shape[i];
+  const float* data = static_cast<const float*>(n->data->data);
+  return std::vector<float>(data, data + size);
+}
+
+/*! \brief Get the shape of a dom scale. */
+std::vector<int64_t> GetDomScaleShape(const Expr& dom_scale) {
+  const auto* n = dom_scale.as<ConstantNode>();
+  CHECK(n);
+  return std::vector<int64_t>(n->data->shape, n->data->shape + n->data->ndim);
+}
+
+/*!
+ * \brief Make the per channel dom scale of an output, which is the product of the
+ *  scalar dom scale of the input and the per channel dom scale of the weight.
+ * \param input_scale The scalar dom scale of the input.
+ * \param weight_scale The per channel dom scale of the weight.
+ * \param ndim The number of dimensions of the output.
+ * \param axis The channel axis of the output.
+ * \return The dom scale which can be broadcast to the output.
+ */
+Expr MakeChannelDomScale(const Expr& input_scale, const Expr& weight_scale,
+                         size_t ndim, size_t axis) {
+  float s = GetScalarFromConstant<float>(input_scale);
+  std::vector<float> values = GetDomScales(weight_scale);
+  for (float& v : values) v *= s;
+  std::vector<int64_t> shape(ndim - axis, 1);
+  shape[0] = static_cast<int64_t>(values.size());
+  return MakeConstantTensor(Float(32), shape, values);
+}
+
+/*!
+ * \brief Calculate round(data * factor) with integer arithmetic only.
+ *  Each factor is represented as multiplier * 2^-shift with a 31 bit multiplier,
+ *  and the product is computed in int64. The result saturates to the range of
+ *  the activation data type instead of wrapping around.
+ * \param data The data in activation data type.
+ * \param factors The factors, a scalar or a per channel tensor.
+ * \param shape The shape of factors, broadcastable to data.
+ * \return The scaled data in activation data type.
+ */
+Expr FixedPointMultiply(Expr data, const std::vector<float>& factors,
+                        const std::vector<int64_t>& shape) {
+  const QConfig& cfg = QConfig::Current();
+  std::vector<int64_t> multipliers, round_bias, shifts;
+  for (float factor : factors) {
+    CHECK_GT(factor, 0);
+    int exponent;
+    // factor = significand * 2^exponent, significand in [0.5, 1)
+    double significand = std::frexp(static_cast<double>(factor), &exponent);
+    int64_t multiplier = static_cast<int64_t>(std::round(significand * (1LL << 31)));
+    if (multiplier == (1LL << 31)) {
+      multiplier /= 2;
+      ++exponent;
+    }
+    int64_t shift = 31 - exponent;
+    CHECK(shift > 0 && shift < 63) << "Cannot represent factor " << factor << " in fixed point";
+    multipliers.push_back(multiplier);
+    round_bias.push_back(1LL << (shift - 1));
+    shifts.push_back(shift);
+  }
+  data = Cast(data, Int(64));
+  data = Multiply(data, MakeConstantTensor(Int(64), shape, multipliers));
+  data = Add(data, MakeConstantTensor(Int(64), shape, round_bias));
+  data = RightShift(data, MakeConstantTensor(Int(64), shape, shifts));
+  double bound = std::pow(2.0, cfg->dtype_activation.bits() - 1);
+  data = Clip(data, -bound, bound - 1);
+  return Cast(data, cfg->dtype_activation);
+}
+
 /* calculate `data * s1 / s2`, use shift if possible */
-inline Expr MulAndDiv(Expr data, float s1, float s2) {
+inline Expr MulAndDiv(Expr data, const Expr& s1, float s2) {
   // here we assume the dtype of data is dtype activation
   const QConfig& cfg = QConfig::Current();
-  if (s1 == s2) return data;
-
-  float factor = s1 / s2;
-  float shift_factor = std::log2(factor);
-  CHECK_GT(shift_factor, 0);
-  if (static_cast<int>(shift_factor) == shift_factor) {
-    return LeftShift(data, MakeConstantScalar(cfg->dtype_activation,
-                                              static_cast<int>(shift_factor)));
-  } else if (static_cast<int>(factor) == factor) {
-    return Multiply(data, MakeConstantScalar(cfg->dtype_activation, factor));
-  } else {
-    LOG(FATAL) << "fall back to float computation";
-    data = Cast(data, Float(32));
-    return Multiply(data, MakeConstantScalar(Float(32), factor));
+  std::vector<float> scales = GetDomScales(s1);
+  if (std::all_of(scales.begin(), scales.end(), [s2](float s) { return s == s2; })) {
+    return data;
+  }
+
+  if (scales.size() == 1) {
+    float factor = scales[0] / s2;
+    float shift_factor = std::log2(factor);
+    CHECK_GT(shift_factor, 0);
+    if (static_cast<int>(shift_factor) == shift_factor) {
+      return LeftShift(data, MakeConstantScalar(cfg->dtype_activation,
+                                                static_cast<int>(shift_factor)));
+    } else if (static_cast<int>(factor) == factor) {
+      return Multiply(data, MakeConstantScalar(cfg->dtype_activation, factor));
+    }
+  }
+  if (cfg->fixed_point_requantize) {
+    std::vector<float> factors;
+    for (float s : scales) factors.push_back(s / s2);
+    return FixedPointMultiply(data, factors, GetDomScaleShape(s1));
   }
+  LOG(FATAL) << "fall back to float computation, "
+             << "use fixed_point_requantize to rescale with integers";
+  data = Cast(data, Float(32));
+  return Multiply(data, Divide(s1, MakeConstantScalar(Float(32), s2)));
 }
 
 Expr QuantizeRealize(const Call& ref_call,
@@ -191,7 +287,6 @@ Expr QuantizeRealize(const Call& ref_call,
   Expr clip_min = new_args[2];
   Expr clip_max = new_args[3];
 
-  float dom_scale_imm = GetScalarFromConstant<float>(dom_scale);
   float clip_min_imm = GetScalarFromConstant<float>(clip_min);
   float clip_max_imm = GetScalarFromConstant<float>(clip_max);
 
@@ -200,26 +295,41 @@ Expr QuantizeRealize(const Call& ref_call,
   if (const auto* n = new_args[0].as<QRealizeIntExprNode>()) {
     // int32->int8
     Expr data = n->data;
-    float idom_scale_imm = GetScalarFromConstant<float>(n->dom_scale);
+    std::vector<float> idom_scales = GetDomScales(n->dom_scale);
     float odom_scale_imm = GetScalarFromConstant<float>(dom_scale);
-    if (idom_scale_imm == odom_scale_imm) {
-      // same domain scale, only clip
-      data = Clip(data, clip_min_imm, clip_max_imm);
-      return QRealizeIntExprNode::make(data, dom_scale, n->dtype);
-    }
+    if (idom_scales.size() == 1) {
+      float idom_scale_imm = idom_scales[0];
+      if (idom_scale_imm == odom_scale_imm) {
+        // same domain scale, only clip
+        data = Clip(data, clip_min_imm, clip_max_imm);
+        return QRealizeIntExprNode::make(data, dom_scale, n->dtype);
+      }
 
-    float shift_nbit = std::log2(odom_scale_imm / idom_scale_imm);
-    CHECK_GT(shift_nbit, 0);
-    if (static_cast<int>(shift_nbit) == shift_nbit) {
-      // use right shift
-      if (cfg->round_for_shift) {
-        float round_bias = std::pow(2.0, shift_nbit - 1);
-        data = Add(data, MakeConstantScalar(cfg->dtype_activation, static_cast<int>(round_bias)));
+      float shift_nbit = std::log2(odom_scale_imm / idom_scale_imm);
+      CHECK_GT(shift_nbit, 0);
+      if (static_cast<int>(shift_nbit) == shift_nbit) {
+        // use right shift
+        if (cfg->round_for_shift) {
+          float round_bias = std::pow(2.0, shift_nbit - 1);
+          data = Add(data, MakeConstantScalar(cfg->dtype_activation,
+                                              static_cast<int>(round_bias)));
+        }
+        data = RightShift(data, MakeConstantScalar(cfg->dtype_activation,
+                                                   static_cast<int>(shift_nbit)));
+        data = Clip(data, clip_min_imm, clip_max_imm);
+        return QRealizeIntExprNode::make(data, dom_scale, n->dtype);
+      }
+    }
+    if (cfg->fixed_point_requantize) {
+      // integer multiplier and shift
+      if (n->dtype != cfg->dtype_activation) {
+        data = Cast(data, cfg->dtype_activation);
       }
-      data = RightShift(data, MakeConstantScalar(cfg->dtype_activation,
-                                                 static_cast<int>(shift_nbit)));
+      std::vector<float> factors;
+      for (float s : idom_scales) factors.push_back(s / odom_scale_imm);
+      data = FixedPointMultiply(data, factors, GetDomScaleShape(n->dom_scale));
       data = Clip(data, clip_min_imm, clip_max_imm);
-      return QRealizeIntExprNode::make(data, dom_scale, n->dtype);
+      return QRealizeIntExprNode::make(data, dom_scale, cfg->dtype_activation);
     } else {
       // float computation
       data = Cast(data, Float(32));
@@ -232,7 +342,14 @@ Expr QuantizeRealize(const Call& ref_call,
   // quantize from real
   CHECK(!new_args[0]->derived_from<TempExprNode>());
   Expr data = new_args[0];
-  Expr scaled_data = Multiply(data, MakeConstantScalar(Float(32), 1 / dom_scale_imm));
+  Expr scaled_data;
+  if (dom_scale.as<ConstantNode>()->is_scalar()) {
+    float dom_scale_imm = GetScalarFromConstant<float>(dom_scale);
+    scaled_data = Multiply(data, MakeConstantScalar(Float(32), 1 / dom_scale_imm));
+  } else {
+    // per channel weight
+    scaled_data = Divide(data, dom_scale);
+  }
   Expr round_data = Clip(Round(scaled_data), clip_min_imm, clip_max_imm);
   return QRealizeIntExprNode::make(round_data, dom_scale, Float(32));
 }
@@ -268,7 +385,18 @@ Expr Conv2dRealize(const Call& ref_call,
 
   Expr ret = CallNode::make(ref_call->op,
     {ldata, rdata}, Attrs(attrs), ref_call->type_args);
-  Expr dom_scale = FoldConstant(Multiply(lhs->dom_scale, rhs->dom_scale));
+  Expr dom_scale;
+  if (rhs->dom_scale.as<ConstantNode>()->is_scalar()) {
+    dom_scale = FoldConstant(Multiply(lhs->dom_scale, rhs->dom_scale));
+  } else {
+    // per output channel scale, aligned with the channel axis of the output
+    const std::string& layout =
+        attrs->out_layout == "" ? attrs->data_layout : attrs->out_layout;
+    size_t channel_pos = layout.find('C');
+    CHECK(channel_pos != std::string::npos && layout.find('c') == std::string::npos)
+        << "Per channel quantization does not support layout " << layout;
+    dom_scale = MakeChannelDomScale(lhs->dom_scale, rhs->dom_scale, layout.size(), channel_pos);
+  }
   return QRealizeIntExprNode::make(ret, dom_scale, out_dtype);
 }
 
@@ -276,6 +404,42 @@ RELAY_REGISTER_OP("nn.conv2d")
 .set_attr<FForwardRewrite>("FQRealizeRewrite", Conv2dRealize);
 
 
+Expr DenseRealize(const Call& ref_call,
+                  const Array<Expr>& new_args,
+                  const NodeRef& ctx) {
+  const QConfig& cfg = QConfig::Current();
+  CHECK_EQ(new_args.size(), 2);
+  const auto* lhs = new_args[0].as<QRealizeIntExprNode>();
+  const auto* rhs = new_args[1].as<QRealizeIntExprNode>();
+  // dense is only annotated with per channel weights, otherwise it stays in float.
+  if (lhs == nullptr || rhs == nullptr) {
+    return Expr(nullptr);
+  }
+
+  Expr ldata = lhs->data;
+  if (lhs->dtype != cfg->dtype_input) {
+    ldata = Cast(ldata, cfg->dtype_input);
+  }
+  Expr rdata = Cast(rhs->data, cfg->dtype_weight);
+  // dense has no output data type, accumulate in the activation data type.
+  ldata = Cast(ldata, cfg->dtype_activation);
+  rdata = Cast(rdata, cfg->dtype_activation);
+
+  Expr ret = ForwardOp(ref_call, {ldata, rdata});
+  Expr dom_scale;
+  if (rhs->dom_scale.as<ConstantNode>()->is_scalar()) {
+    dom_scale = FoldConstant(Multiply(lhs->dom_scale, rhs->dom_scale));
+  } else {
+    // the units are the last axis of the output
+    dom_scale = MakeChannelDomScale(lhs->dom_scale, rhs->dom_scale, 1, 0);
+  }
+  return QRealizeIntExprNode::make(ret, dom_scale, cfg->dtype_activation);
+}
+
+RELAY_REGISTER_OP("nn.dense")
+.set_attr<FForwardRewrite>("FQRealizeRewrite", DenseRealize);
+
+
 Expr MulRealize(const Call& ref_call,
                 const Array<Expr>& new_args,
                 const NodeRef& ctx) {
@@ -312,13 +476,13 @@ RELAY_REGISTER_OP("multiply")
 .set_attr<FForwardRewrite>("FQRealizeRewrite", MulRealize);
 
 
-float ChooseDomScale(const std::vector<const QRealizeIntExprNode*>& nptrs) {
-  if (nptrs.size() == 2) {
+float ChooseDomScale(const std::vector<float>& scales) {
+  if (scales.size() == 2) {
     // x = a * s1, y = b * s2
     // x + y = (a * s1 / s2 + b) * s2, if s1 > s2
     //       = (a + b * s2 / s1) * s1, if s2 > s1
-    float s1 = GetScalarFromConstant<float>(nptrs[0]->dom_scale);
-    float s2 = GetScalarFromConstant<float>(nptrs[1]->dom_scale);
+    float s1 = scales[0];
+    float s2 = scales[1];
     return s1 > s2 ? s2 : s1;
   } else {
     const QConfig& cfg = QConfig::Current();
@@ -351,12 +515,24 @@ Array<Expr> UnifyDTypeScale(const Array<Expr>& args,
     }
   }
 
+  // requantize the per channel arguments to the largest scale of their channels.
+  // the factors are at most 1, so the channels with a small scale cannot blow
+  // up the factor of the others when the scales are unified below.
+  std::vector<float> scales;
+  for (size_t i = 0; i < ret.size(); ++i) {
+    std::vector<float> cur_scales = GetDomScales(nptrs[i]->dom_scale);
+    float cur_s = *std::max_element(cur_scales.begin(), cur_scales.end());
+    if (cur_scales.size() != 1) {
+      ret.Set(i, MulAndDiv(ret[i], nptrs[i]->dom_scale, cur_s));
+    }
+    scales.push_back(cur_s);
+  }
+
   // unify the dom_scale
-  float s = ChooseDomScale(nptrs);
+  float s = ChooseDomScale(scales);
   Expr dom_scale = MakeConstantScalar(Float(32), s);
   for (size_t i = 0; i < ret.size(); ++i) {
-    float cur_s = GetScalarFromConstant<float>(nptrs[i]->dom_scale);
-    ret.Set(i, MulAndDiv(ret[i], cur_s, s));
+    ret.Set(i, MulAndDiv(ret[i], MakeConstantScalar(Float(32), scales[i]), s));
   }
 
   *dtype_ptr = dtype;
@@ -414,8 +590,13 @@ RELAY_REGISTER_OP("concatenate")
 Expr IdentityRealize(const Call& ref_call,
                      const Array<Expr>& new_args,
                      const NodeRef& ctx) {
+  static const Op& strided_slice = Op::Get("strided_slice");
   CHECK_EQ(new_args.size(), 1);
   if (const auto* n = new_args[0].as<QRealizeIntExprNode>()) {
+    if (ref_call->op.same_as(strided_slice) && !n->dom_scale.as<ConstantNode>()->is_scalar()) {
+      // the slice may not keep the channels of a per channel scale, dequantize.
+      return Expr(nullptr);
+    }
     Expr ret = ForwardOp(ref_call, {n->data});
     return QRealizeIntExprNode::make(ret, n->dom_scale, n->dtype);
   }
@@ -530,6 +711,8 @@ TVM_STATIC_IR_FUNCTOR(IRPrinter, vtable)
   p->stream << "skip_k_conv==" << op->skip_k_conv << ", ";
   p->stream << "round_for_shift==" << op->round_for_shift << ", ";
   p->stream << "store_lowbit_output==" << op->store_lowbit_output << ", ";
+  p->stream << "per_channel_weight==" << op->per_channel_weight << ", ";
+  p->stream << "fixed_point_requantize==" << op->fixed_point_requantize << ", ";
   p->stream << "debug_enabled_ops==" << op->debug_enabled_ops;
   p->stream << ")";
 });
@@ -71,6 +71,10 @@ RELAY_DEFINE_NODE_REF(QRealizeExpr, QRealizeExprNode, TempExpr);
 
 class QRealizeIntExprNode : public QRealizeExprNode {
  public:
+  /*!
+   * \brief The domain scale, a scalar or a per channel constant
+   *  which can be broadcast to data.
+   */
   Expr dom_scale;
   /*! \brief current data type */
   DataType dtype;
@@ -109,6 +113,8 @@ class QConfigNode : public Node {
   int skip_k_conv = 1;
   bool round_for_shift = true;
   bool store_lowbit_output = true;
+  bool per_channel_weight = false;
+  bool fixed_point_requantize = false;
   Array<Expr> debug_enabled_ops = Array<Expr>(NodePtr<Node>(nullptr));
 
   void VisitAttrs(AttrVisitor* v) final {
@@ -122,6 +128,8 @@ class QConfigNode : public Node {
     v->Visit("skip_k_conv", &skip_k_conv);
     v->Visit("round_for_shift", &round_for_shift);
     v->Visit("store_lowbit_output", &store_lowbit_output);
+    v->Visit("per_channel_weight", &per_channel_weight);
+    v->Visit("fixed_point_requantize", &fixed_point_requantize);
     v->Visit("debug_enabled_ops", &debug_enabled_ops);
   }
 
@@ -11,9 +11,11 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <numeric>
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace tvm {
 namespace runtime {
@@ -163,15 +165,70 @@ void GraphRuntime::LoadParams(dmlc::Stream* strm) {
   }
 }
 
+/*!
+ * \brief Whether the data pointer of a device can be offset on the host,
+ *  which is required to place several tensors in one arena buffer.
+ */
+static bool SupportPointerOffset(int device_type) {
+  return device_type == kDLCPU ||
+      device_type == kDLCPUPinned ||
+      device_type == kDLGPU ||
+      device_type == kDLROCM;
+}
+
+/*!
+ * \brief Create a view of the pool at the byte offset.
+ *  The view keeps the pool alive.
+ */
+static NDArray CreateOffsetView(const NDArray& pool,
+                                size_t offset,
+                                const std::vector<int64_t>& shape,
+                                DLDataType dtype) {
+  struct OffsetView {
+    NDArray pool;
+    std::vector<int64_t> shape;
+    DLManagedTensor tensor;
+  };
+  OffsetView* view = new OffsetView();
+  view->pool = pool;
+  view->shape = shape;
+  DLTensor& t = view->tensor.dl_tensor;
+  t.data = static_cast<char*>(pool->data) + pool->byte_offset + offset;
+  t.ctx = pool->ctx;
+  t.ndim = static_cast<int>(view->shape.size());
+  t.dtype = dtype;
+  t.shape = view->shape.data();
+  t.strides = nullptr;
+  t.byte_offset = 0;
+  view->tensor.manager_ctx = view;
+  view->tensor.deleter = [](DLManagedTensor* self) {
+    delete static_cast<OffsetView*>(self->manager_ctx);
+  };
+  return NDArray::FromDLPack(&view->tensor);
+}
+
 void GraphRuntime::SetupStorage() {
   // Grab saved optimization plan from graph.
   std::vector<TVMType> vtype;
   for (const std::string& s_type : attrs_.dltype) {
     vtype.push_back(tvm::runtime::String2TVMType(s_type));
   }
+  if (!attrs_.storage_offset.empty()) {
+    CHECK_EQ(attrs_.storage_offset.size(), attrs_.storage_id.size())
+        << "storage_offset must be given for every entry";
+  }
+  int max_storage_id = -1;
+  for (int sid : attrs_.storage_id) {
+    max_storage_id = std::max(max_storage_id, sid);
+  }
 
   // Size and device type of each storage pool entry.
   std::vector<PoolEntry> pool_entry;
+  // The pool entry and the byte offset in it of each node entry.
+  std::vector<int> entry_storage_id(attrs_.shape.size());
+  std::vector<size_t> entry_offset(attrs_.shape.size(), 0);
+  // Arena regions that are split into their own pool entry.
+  std::map<std::pair<int, int64_t>, int> split_storage_id;
   // Find the maximum space size.
   for (size_t i = 0; i < attrs_.shape.size(); ++i) {
     int storage_id = attrs_.storage_id[i];
@@ -190,6 +247,25 @@ void GraphRuntime::SetupStorage() {
     CHECK(bits % 8U ==  0U || bits ==1U);
     size_t bytes = ((bits + 7U) / 8U) * size;
 
+    int64_t offset = 0;
+    if (!attrs_.storage_offset.empty()) {
+      offset = attrs_.storage_offset[i];
+      CHECK_GE(offset, 0);
+    }
+    if (offset != 0 && !SupportPointerOffset(device_type)) {
+      // Each region of the arena becomes a pool entry, tensors that
+      // share an offset share the region.
+      auto key = std::make_pair(storage_id, offset);
+      auto it = split_storage_id.find(key);
+      if (it == split_storage_id.end()) {
+        it = split_storage_id.emplace(key, ++max_storage_id).first;
+      }
+      storage_id = it->second;
+      offset = 0;
+    }
+    entry_storage_id[i] = storage_id;
+    entry_offset[i] = static_cast<size_t>(offset);
+
     uint32_t sid = static_cast<uint32_t>(storage_id);
     if (sid >= pool_entry.size()) {
       pool_entry.resize(sid + 1, {0, -1});
@@ -198,7 +274,7 @@ void GraphRuntime::SetupStorage() {
             pool_entry[sid].device_type == device_type)
           << "The same pool entry cannot be assigned to multiple devices";
     }
-    pool_entry[sid].size = std::max(pool_entry[sid].size, bytes);
+    pool_entry[sid].size = std::max(pool_entry[sid].size, entry_offset[i] + bytes);
     pool_entry[sid].device_type = device_type;
   }
 
@@ -222,10 +298,15 @@ void GraphRuntime::SetupStorage() {
   // is mapped to this pool.
   data_entry_.resize(num_node_entries());
   for (size_t i = 0; i < data_entry_.size(); ++i) {
-    int storage_id = attrs_.storage_id[i];
+    int storage_id = entry_storage_id[i];
     CHECK_LT(static_cast<size_t>(storage_id), storage_pool_.size());
-    data_entry_[i] =
-        storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i]);
+    if (entry_offset[i] == 0) {
+      data_entry_[i] =
+          storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i]);
+    } else {
+      data_entry_[i] = CreateOffsetView(
+          storage_pool_[storage_id], entry_offset[i], attrs_.shape[i], vtype[i]);
+    }
   }
 }
 
@@ -349,6 +349,20 @@ TVM_REGISTER_GLOBAL("runtime.config_threadpool")
     ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(mode, nthreads);
 });
 
+TVM_REGISTER_GLOBAL("runtime.SetCPUAffinity")
+.set_body([](TVMArgs args, TVMRetValue* rv) {
+    // comma separated core ids, e.g. "2,3"
+    std::string cores_str = args[0];
+    std::vector<unsigned int> cores;
+    std::istringstream is(cores_str);
+    std::string item;
+    while (std::getline(is, item, ',')) {
+      if (!item.empty()) cores.push_back(static_cast<unsigned int>(std::stoi(item)));
+    }
+    CHECK(!cores.empty()) << "No core is given";
+    *rv = threading::SetCPUAffinity(cores);
+});
+
 
 }  // namespace runtime
 }  // namespace tvm
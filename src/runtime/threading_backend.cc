@@ -20,6 +20,27 @@ namespace tvm {
 namespace runtime {
 namespace threading {
 
+// the cores this process is allowed to run on
+static std::vector<unsigned int> AllowedCores() {
+  std::vector<unsigned int> cores;
+#if defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuset) == 0) {
+    for (unsigned int i = 0; i < CPU_SETSIZE; ++i) {
+      if (CPU_ISSET(i, &cpuset)) cores.push_back(i);
+    }
+  }
+#endif
+  if (cores.empty()) {
+    unsigned int threads = std::thread::hardware_concurrency();
+    for (unsigned int i = 0; i < threads; ++i) {
+      cores.push_back(i);
+    }
+  }
+  return cores;
+}
+
 class ThreadGroup::Impl {
  public:
   Impl(int num_workers,
@@ -134,10 +155,11 @@ class ThreadGroup::Impl {
   }
 
   void InitSortedOrder() {
-    unsigned int threads = std::thread::hardware_concurrency();
     std::vector<std::pair <unsigned int, int64_t> > max_freqs;
 
-    for (unsigned int i = 0; i < threads; ++i) {
+    // only use the cores in the affinity mask of the process,
+    // so that a process pinned to a few cores stays on them.
+    for (unsigned int i : AllowedCores()) {
       int64_t cur_freq = 0;
       #if defined(__linux__) || defined(__ANDROID__)
         std::ostringstream filepath;
@@ -209,10 +231,27 @@ int MaxConcurrency() {
 #if defined(_M_X64) || defined(__x86_64__)
     max_concurrency /= 2;  // ignore hyper-threading
 #endif
+    // a process pinned to a subset of the cores cannot use more of them
+    max_concurrency = std::min(max_concurrency,
+                               static_cast<int>(AllowedCores().size()));
   }
   return std::max(max_concurrency, 1);
 }
 
+bool SetCPUAffinity(const std::vector<unsigned int>& cores) {
+#if defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (unsigned int core : cores) {
+    CHECK_LT(core, CPU_SETSIZE) << "Invalid core id " << core;
+    CPU_SET(core, &cpuset);
+  }
+  return sched_setaffinity(0, sizeof(cpu_set_t), &cpuset) == 0;
+#else
+  return false;
+#endif
+}
+
 
 }  // namespace threading
 }  // namespace runtime
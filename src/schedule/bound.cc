@@ -9,8 +9,11 @@
 #include <tvm/ir_pass.h>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 #include "graph.h"
 #include "message_passing.h"
+#include "../arithmetic/int_set_internal.h"
 #include "../runtime/thread_storage_scope.h"
 
 namespace tvm {
@@ -20,6 +23,87 @@ using runtime::StorageRank;
 using runtime::StorageScope;
 using runtime::ThreadScope;
 
+/*!
+ * \brief Memo of the input tensor domains requested by a consumer.
+ *
+ *  Every producer of a consumer asks for the same bound propagation,
+ *  which evaluates the IntSet of each index in the consumer body.
+ *  The memo is keyed by the consumer and the domain of its root
+ *  iter vars, so producers under the same domain share the IntSets
+ *  of the consumer. Each request only propagates the bounds of the
+ *  tensors missing from the entry, and merges them into it, so a
+ *  producer attached at its own level costs one propagation of its
+ *  own tensors. It only lives within one InferBound call.
+ */
+class PropBoundCache {
+ public:
+  using DomMap = std::unordered_map<const Variable*, IntSet>;
+  using TensorDomMap = std::unordered_map<Tensor, TensorDom>;
+  /*!
+   * \brief Get the domains the consumer requests from its inputs.
+   * \param op The consumer operation.
+   * \param dom_map The domain of the root iter vars of op.
+   * \param tensors The input tensors whose domains are requested.
+   * \return The domain of the input tensors, including tensors
+   *  requested before under the same domain.
+   */
+  const TensorDomMap& Get(const Operation& op,
+                          const DomMap& dom_map,
+                          const std::vector<Tensor>& tensors) {
+    std::vector<Entry>& entries = cache_[op.get()];
+    Entry* entry = nullptr;
+    for (Entry& e : entries) {
+      if (SameDomain(e.dom_map, dom_map)) {
+        entry = &e;
+        break;
+      }
+    }
+    if (entry == nullptr) {
+      entries.emplace_back();
+      entry = &entries.back();
+      entry->dom_map = dom_map;
+    }
+    TensorDomMap missing;
+    for (const Tensor& t : tensors) {
+      if (!entry->tmap.count(t)) {
+        missing.emplace(t, TensorDom(static_cast<int>(t.ndim())));
+      }
+    }
+    if (missing.size() != 0) {
+      op->PropBoundToInputs(op, dom_map, &missing);
+      for (auto& kv : missing) {
+        entry->tmap.emplace(kv.first, std::move(kv.second));
+      }
+    }
+    return entry->tmap;
+  }
+
+ private:
+  struct Entry {
+    DomMap dom_map;
+    TensorDomMap tmap;
+  };
+  // structurally compare two domain maps.
+  static bool SameDomain(const DomMap& lhs, const DomMap& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (const auto& kv : lhs) {
+      auto it = rhs.find(kv.first);
+      if (it == rhs.end()) return false;
+      if (kv.second.same_as(it->second)) continue;
+      const arith::IntervalSet* a = kv.second.as<arith::IntervalSet>();
+      const arith::IntervalSet* b = it->second.as<arith::IntervalSet>();
+      if (a == nullptr || b == nullptr) return false;
+      if (!ir::Equal(a->i.min, b->i.min) ||
+          !ir::Equal(a->i.max, b->i.max)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // The memo entries of each consumer.
+  std::unordered_map<const Node*, std::vector<Entry> > cache_;
+};
+
 /*! \brief The graph context used during bound inference. */
 struct GraphContext {
   /*! \brief The feed graph */
@@ -30,6 +114,8 @@ struct GraphContext {
   std::unordered_map<IterVar, IterVar> bind_map;
   /*! \brief map from op to stage */
   std::unordered_map<const Node*, Stage> op2stage_;
+  /*! \brief memo of the bound propagation of each consumer */
+  PropBoundCache prop_bound_cache;
 };
 
 bool NeedRelax(const IterVar& iv,
@@ -76,8 +162,9 @@ StorageScope InferStorageScope(
 
 
 void InferRootBound(const Stage& stage,
-                    const GraphContext& ctx,
+                    GraphContext* p_ctx,
                     std::unordered_map<IterVar, Range>* rmap) {
+  const GraphContext& ctx = *p_ctx;
   CHECK_NE(stage->attach_type, kInline)
       << "call schedule.normalize before scheduleops";
   if (stage->attach_type == kInlinedAlready) return;
@@ -98,8 +185,11 @@ void InferRootBound(const Stage& stage,
   std::unordered_map<Tensor, TensorDom> tmap;
   // The consumers of the op.
   std::unordered_set<Operation> consumers;
+  // The outputs of the op, whose domains are requested from the consumers.
+  std::vector<Tensor> outputs;
   for (int i = 0; i < stage->op->num_outputs(); ++i) {
     Tensor t = stage->op.output(i);
+    outputs.push_back(t);
     tmap.emplace(t, TensorDom(static_cast<int>(t.ndim())));
     auto it = ctx.feed_graph.find(t);
     if (it != ctx.feed_graph.end()) {
@@ -185,7 +275,16 @@ void InferRootBound(const Stage& stage,
         dom_map[iv->var.get()] = IntSet::range(r);
       }
     }
-    op->PropBoundToInputs(op, dom_map, &tmap);
+    const auto& consumer_tmap = p_ctx->prop_bound_cache.Get(op, dom_map, outputs);
+    for (auto& kv : tmap) {
+      auto it = consumer_tmap.find(kv.first);
+      if (it == consumer_tmap.end()) continue;
+      for (size_t i = 0; i < kv.second.data.size(); ++i) {
+        kv.second.data[i].insert(kv.second.data[i].end(),
+                                 it->second.data[i].begin(),
+                                 it->second.data[i].end());
+      }
+    }
   }
   stage->op->GatherBound(stage->op, tmap, rmap);
 }
@@ -213,7 +312,7 @@ Map<IterVar, Range> InferBound(const Schedule& sch) {
   std::unordered_map<IterVar, Range> ret;
   for (size_t i = sch->stages.size(); i != 0; --i) {
     const Stage& stage = sch->stages[i - 1];
-    InferRootBound(stage, ctx, &ret);
+    InferRootBound(stage, &ctx, &ret);
     // pass down to get bound of all iter vars.
     PassDownDomain(stage, &ret);
     for (IterVar iv : stage->env_threads) {
@@ -20,10 +20,6 @@ inline Expr DivCeil(Expr a, Expr b) {
   return ir::Simplify((a + b - 1) / b);
 }
 
-inline bool prove_equal(Expr lhs, Expr rhs) {
-  return is_zero(ir::Simplify(lhs - rhs));
-}
-
 void Update(std::unordered_map<IterVar, Range>* p_state,
             const IterVar& iv,
             Range r) {
@@ -32,7 +28,7 @@ void Update(std::unordered_map<IterVar, Range>* p_state,
     (*p_state)[iv] = r;
   } else {
     bool match = is_zero(it->second->min);
-    if (!prove_equal(r->extent, it->second->extent)) match = false;
+    if (!arith::ProveEqual(r->extent, it->second->extent)) match = false;
     CHECK(match)
         << iv
         << " domain already inferred,"
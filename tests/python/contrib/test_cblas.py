@@ -1,6 +1,7 @@
 import tvm
 import numpy as np
 from tvm.contrib import cblas
+from topi.util import get_const_tuple
 
 def test_matmul_add():
     n = 1024
@@ -32,5 +33,42 @@ def test_matmul_add():
     verify()
 
 
+def verify_batch_matmul(batch_a, batch_b, n, l, m, transa, transb):
+    A = tvm.placeholder((batch_a, l, n) if transa else (batch_a, n, l), name='A')
+    B = tvm.placeholder((batch_b, m, l) if transb else (batch_b, l, m), name='B')
+    C = cblas.batch_matmul(A, B, transa, transb)
+    D = tvm.compute(C.shape, lambda k, i, j: C[k, i, j] + 1.0, name="D")
+    s = tvm.create_schedule(D.op)
+
+    def verify(target="llvm"):
+        if not tvm.module.enabled(target):
+            print("skip because %s is not enabled..." % target)
+            return
+        if not tvm.get_global_func("tvm.contrib.cblas.batch_matmul", True):
+            print("skip because extern function is not available")
+            return
+        ctx = tvm.cpu(0)
+        f = tvm.build(s, [A, B, D], target)
+        a_np = np.random.uniform(size=get_const_tuple(A.shape)).astype(A.dtype)
+        b_np = np.random.uniform(size=get_const_tuple(B.shape)).astype(B.dtype)
+        a = tvm.nd.array(a_np, ctx)
+        b = tvm.nd.array(b_np, ctx)
+        d = tvm.nd.array(np.zeros(get_const_tuple(D.shape), dtype=D.dtype), ctx)
+        f(a, b, d)
+        a_np = a_np.transpose(0, 2, 1) if transa else a_np
+        b_np = b_np.transpose(0, 2, 1) if transb else b_np
+        tvm.testing.assert_allclose(d.asnumpy(), np.matmul(a_np, b_np) + 1.0, rtol=1e-5)
+    verify()
+
+
+def test_batch_matmul():
+    verify_batch_matmul(16, 16, 128, 64, 96, False, False)
+    verify_batch_matmul(16, 16, 128, 64, 96, False, True)
+    verify_batch_matmul(16, 16, 128, 64, 96, True, False)
+    verify_batch_matmul(1, 16, 128, 64, 96, False, True)
+    verify_batch_matmul(16, 1, 128, 64, 96, True, True)
+
+
 if __name__ == "__main__":
     test_matmul_add()
+    test_batch_matmul()
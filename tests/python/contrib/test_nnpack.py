@@ -95,7 +95,7 @@ def test_convolution_inference():
     bias = tvm.placeholder(bshape, name='bias')
     def verify(target="llvm",
                algorithm=nnpack.ConvolutionAlgorithm.AUTO,
-               with_bias=True):
+               with_bias=True, nthreads=1):
         if not tvm.module.enabled(target):
             print("skip because %s is not enabled..." % target)
             return
@@ -109,7 +109,7 @@ def test_convolution_inference():
         output = nnpack.convolution_inference(
             data, kernel, bias if with_bias else None,
             [PAD, PAD, PAD, PAD], [STRIDE, STRIDE],
-            algorithm=algorithm)
+            nthreads=nthreads, algorithm=algorithm)
         s = tvm.create_schedule(output.op)
 
         f = tvm.build(s, [data, kernel, bias, output], target)
@@ -135,6 +135,8 @@ def test_convolution_inference():
     ]:
         for with_bias in [True, False]:
             verify(algorithm=algorithm, with_bias=with_bias)
+    # multi-threaded nnpack runs on the worker threads of the TVM pool
+    verify(nthreads=4)
 
 
 def test_convolution_inference_without_weight_transform():
@@ -73,7 +73,65 @@ def test_normal():
     verify()
 
 
+def test_philox():
+    m = 1024
+    n = 1024
+
+    def verify(A, check, target="llvm", exact=True):
+        if not tvm.module.enabled(target):
+            print("skip because %s is not enabled..." % target)
+            return
+        if not tvm.get_global_func("tvm.contrib.random.seed", True):
+            print("skip because extern function is not available")
+            return
+        ctx = tvm.cpu(0)
+        s = tvm.create_schedule(A.op)
+        f = tvm.build(s, [A], target)
+        a = tvm.nd.array(np.zeros((m, n), dtype=A.dtype), ctx)
+        random.seed(42)
+        f(a)
+        na = a.asnumpy()
+        check(na)
+        # the result only depends on the seed
+        f(a)
+        assert not np.array_equal(a.asnumpy(), na)
+        # the normal samples go through libm, which is only exact on one platform
+        assert_equal = np.testing.assert_array_equal if exact else \
+            lambda x, y: np.testing.assert_allclose(x, y, rtol=1e-5, atol=1e-5)
+        random.seed(42)
+        f(a)
+        assert_equal(a.asnumpy(), na)
+        # nor on the number of threads generating it
+        config_threadpool = tvm.get_global_func("runtime.config_threadpool")
+        for nthreads in [1, 2, 3, 4]:
+            config_threadpool(0, nthreads)
+            a = tvm.nd.array(np.zeros((m, n), dtype=A.dtype), ctx)
+            random.seed(42)
+            f(a)
+            assert_equal(a.asnumpy(), na)
+        config_threadpool(0, 0)
+
+    def check_uniform(na):
+        assert abs(np.mean(na) - 0.5) < 1e-2
+        assert np.min(na) >= 0 and np.max(na) < 1
+        assert abs(np.max(na) - 1.0) < 1e-3
+
+    def check_normal(na):
+        assert abs(np.mean(na) - 3) < 1e-2
+        assert abs(np.std(na) - 4) < 1e-2
+
+    def check_randint(na):
+        assert abs(np.mean(na)) < 0.2
+        assert np.min(na) == -127
+        assert np.max(na) == 127
+
+    verify(random.uniform(0, 1, size=(m, n), engine="philox"), check_uniform)
+    verify(random.normal(3, 4, size=(m, n), engine="philox"), check_normal, exact=False)
+    verify(random.randint(-127, 128, size=(m, n), engine="philox"), check_randint)
+
+
 if __name__ == "__main__":
     test_randint()
     test_uniform()
     test_normal()
+    test_philox()
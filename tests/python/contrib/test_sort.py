@@ -1,5 +1,6 @@
 import tvm
 import numpy as np
+from tvm.contrib import sort
 
 def test_sort():
     n = 2
@@ -57,6 +58,77 @@ def test_sort_np():
     f(a, b, c)
     tvm.testing.assert_allclose(c.asnumpy(), np_out, rtol=1e-5)
 
+def test_sort_dtype():
+    dshape = (4, 300, 5)
+    axis = 1
+    ctx = tvm.cpu(0)
+    for dtype in ["float16", "float64", "int8", "int32", "int64", "uint8"]:
+        for is_descend in [False, True]:
+            data = tvm.placeholder(dshape, name='data', dtype=dtype)
+            sort_num = tvm.placeholder((dshape[0], dshape[2]), name="sort_num", dtype="int32")
+            out = sort.argsort(data, sort_num, axis=axis, is_descend=is_descend)
+            s = tvm.create_schedule(out.op)
+            f = tvm.build(s, [data, sort_num, out], "llvm")
+
+            # few distinct values, so that the stable order of equal elements is checked
+            np_data = np.random.randint(0, 50, size=dshape).astype(dtype)
+            key = -np_data.astype("float64") if is_descend else np_data
+            np_out = np.argsort(key, axis=axis, kind="mergesort")
+            a = tvm.nd.array(np_data, ctx)
+            b = tvm.nd.array(np.full(sort_num.shape, dshape[axis], dtype="int32"), ctx)
+            c = tvm.nd.array(np.zeros(dshape, dtype=out.dtype), ctx)
+            f(a, b, c)
+            tvm.testing.assert_allclose(c.asnumpy(), np_out)
+
+def test_sort_nan():
+    dshape = (2, 100, 3)
+    axis = 1
+    ctx = tvm.cpu(0)
+    for dtype in ["float32", "float16"]:
+        for is_descend in [False, True]:
+            data = tvm.placeholder(dshape, name='data', dtype=dtype)
+            sort_num = tvm.placeholder((dshape[0], dshape[2]), name="sort_num", dtype="int32")
+            out = sort.argsort(data, sort_num, axis=axis, is_descend=is_descend)
+            s = tvm.create_schedule(out.op)
+            f = tvm.build(s, [data, sort_num, out], "llvm")
+
+            np_data = np.random.randint(0, 20, size=dshape).astype(dtype)
+            np_data[np.random.rand(*dshape) < 0.2] = np.nan
+            # numpy places NaNs last, in their original order
+            key = -np_data.astype("float64") if is_descend else np_data
+            np_out = np.argsort(key, axis=axis, kind="mergesort")
+            a = tvm.nd.array(np_data, ctx)
+            b = tvm.nd.array(np.full(sort_num.shape, dshape[axis], dtype="int32"), ctx)
+            c = tvm.nd.array(np.zeros(dshape, dtype=out.dtype), ctx)
+            f(a, b, c)
+            tvm.testing.assert_allclose(c.asnumpy(), np_out)
+
+def test_topk():
+    dshape = (3, 1000, 4)
+    axis = 1
+    k = 10
+    ctx = tvm.cpu(0)
+    for dtype in ["float32", "float16", "int32"]:
+        for is_descend in [False, True]:
+            data = tvm.placeholder(dshape, name='data', dtype=dtype)
+            values, indices = sort.topk(data, k, axis=axis, is_descend=is_descend)
+            s = tvm.create_schedule([values.op])
+            f = tvm.build(s, [data, values, indices], "llvm")
+
+            np_data = np.random.permutation(np.prod(dshape)).reshape(dshape).astype(dtype)
+            key = -np_data.astype("float64") if is_descend else np_data
+            np_indices = np.argsort(key, axis=axis, kind="mergesort")[:, :k, :]
+            np_values = np.take_along_axis(np_data, np_indices, axis=axis)
+            a = tvm.nd.array(np_data, ctx)
+            b = tvm.nd.array(np.zeros(values.shape, dtype=dtype), ctx)
+            c = tvm.nd.array(np.zeros(indices.shape, dtype="int32"), ctx)
+            f(a, b, c)
+            tvm.testing.assert_allclose(b.asnumpy(), np_values)
+            tvm.testing.assert_allclose(c.asnumpy(), np_indices)
+
 if __name__ == "__main__":
     test_sort()
     test_sort_np()
+    test_sort_dtype()
+    test_sort_nan()
+    test_topk()
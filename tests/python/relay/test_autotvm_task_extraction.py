@@ -52,5 +52,14 @@ def test_task_extraction():
                                             ops=(relay.op.nn.conv2d_transpose,))
     assert len(tasks) == 4
 
+    x = relay.var("x", shape=(4, 32, 64))
+    y = relay.var("y", shape=(4, 16, 64))
+    z = relay.var("z", shape=(4, 8, 16))
+    net = relay.Function([x, y, z], relay.nn.batch_matmul(relay.nn.batch_matmul(x, y), z))
+    tasks = autotvm.task.extract_from_program(net, target=target,
+                                            params={},
+                                            ops=(relay.op.nn.batch_matmul,))
+    assert len(tasks) == 2
+
 if __name__ == '__main__':
     test_task_extraction()
@@ -1,5 +1,7 @@
+import json
 import tvm
 import tvm.testing
+from tvm.contrib import util
 import numpy as np
 from tvm import relay
 
@@ -33,6 +35,51 @@ def test_compile_engine():
                 y.asnumpy(), x.asnumpy() * 3)
     engine.dump()
 
+def test_compile_engine_kernel_cache():
+    engine = relay.backend.compile_engine.get()
+    def get_func(shape):
+        x = relay.var("x", shape=shape)
+        y = relay.multiply(x, relay.const(2.0))
+        f = relay.ir_pass.infer_type(relay.Function([x], relay.exp(y)))
+        return f
+    temp = util.tempdir()
+    tvm.codegen.kernel_cache_config(temp.temp_dir)
+    try:
+        engine.clear()
+        before = tvm.codegen.kernel_cache_stats()
+        z1 = engine.lower(get_func((7, 3)), "llvm")
+        # a new engine state has to reuse the kernel from disk.
+        engine.clear()
+        z2 = engine.lower(get_func((7, 3)), "llvm")
+        after = tvm.codegen.kernel_cache_stats()
+        assert after["inserts"] == before["inserts"] + 1
+        assert after["hits"] == before["hits"] + 1
+        assert str(z1.funcs[0].body) == str(z2.funcs[0].body)
+        assert z2.funcs[0].name == z2.func_name
+        # a corrupted entry is a miss, and is lowered again.
+        for name in temp.listdir():
+            if name.endswith(".json"):
+                with open(temp.relpath(name)) as f:
+                    entry = json.load(f)
+                entry["funcs"] = "corrupted"
+                with open(temp.relpath(name), "w") as f:
+                    json.dump(entry, f)
+        engine.clear()
+        z3 = engine.lower(get_func((7, 3)), "llvm")
+        assert str(z1.funcs[0].body) == str(z3.funcs[0].body)
+        assert tvm.codegen.kernel_cache_stats()["misses"] == after["misses"] + 1
+        after = tvm.codegen.kernel_cache_stats()
+        # eviction keeps the directory below the limit.
+        tvm.codegen.kernel_cache_config(temp.temp_dir, max_bytes=0)
+        engine.clear()
+        engine.lower(get_func((5,)), "llvm")
+        assert tvm.codegen.kernel_cache_stats()["evictions"] > after["evictions"]
+        assert not [x for x in temp.listdir() if x.endswith(".json")]
+    finally:
+        tvm.codegen.kernel_cache_config(None)
+        engine.clear()
+
+
 def test_compile_placeholder_bypass():
     engine = relay.backend.compile_engine.get()
     x = relay.var("x", shape=(2, 3))
@@ -55,6 +102,7 @@ def test_compile_injective_with_tuple():
 
 if __name__ == "__main__":
     test_compile_engine()
+    test_compile_engine_kernel_cache()
     test_compile_placeholder_bypass()
     test_compile_injective_with_tuple()
 
@@ -127,8 +127,51 @@ def test_plan_memory():
     assert len(device_types) == 1
 
 
+def test_plan_memory_arena():
+    x = relay.var("x", shape=(10,))
+    y = relay.var("y", shape=(1,))
+    z = relay.add(x, relay.exp(y))
+    z = relay.exp(z)
+    z = relay.reshape(relay.exp(z), (2, 5))
+    z = relay.exp(z)
+    func = relay.Function([x, y], z)
+    func = relay.ir_pass.infer_type(func)
+    func = relay.ir_pass.fuse_ops(func, opt_level=0)
+    func = relay.ir_pass.infer_type(func)
+
+    for heuristic in ["greedy_by_size", "best_fit_by_lifetime", "auto"]:
+        smap = relay.backend._backend.GraphPlanMemoryArena(func, heuristic)
+        storage_ids = set()
+        for k, v in smap.items():
+            assert len(v) == 3
+            for sid, offset in zip(v[0], v[2]):
+                storage_ids.add(sid.value)
+                assert offset.value % 64 == 0
+        # two inputs with their own storage and one arena.
+        assert len(storage_ids) == 3
+        planned, lower_bound = relay.backend._backend.GraphPlanMemoryArenaStat(
+            func, heuristic)
+        assert lower_bound.value <= planned.value
+        # no more than two temporaries are alive at a time.
+        assert planned.value <= 2 * 64
+
+    # run end to end with the arena planner
+    func = relay.Function([x, y], z)
+    x_data = np.random.rand(10).astype("float32")
+    y_data = np.random.rand(1).astype("float32")
+    with relay.build_config(memory_planner="arena"):
+        graph, lib, params = relay.build(func, "llvm")
+    assert "storage_offset" in graph
+    mod = graph_runtime.create(graph, lib, tvm.cpu(0))
+    mod.run(x=x_data, y=y_data)
+    ref = np.exp(np.exp(np.exp(x_data + np.exp(y_data)))).reshape(2, 5)
+    ref = np.exp(ref)
+    tvm.testing.assert_allclose(mod.get_output(0).asnumpy(), ref, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_plan_memory()
+    test_plan_memory_arena()
     test_with_params()
     test_add_op_scalar()
     test_add_op_tensor()
@@ -144,8 +144,60 @@ def test_reverse_reshape():
     verify_reverse_reshape((2, 3, 4), (-1, 0), (6, 4))
     verify_reverse_reshape((2, 3, 4), (0, -3), (2, 12))
 
+def verify_batch_matmul(x_shape, y_shape, out_shape, dtype="float32"):
+    x = relay.var("x", relay.TensorType(x_shape, dtype))
+    y = relay.var("y", relay.TensorType(y_shape, dtype))
+    z = relay.nn.batch_matmul(x, y)
+    zz = relay.ir_pass.infer_type(z)
+    assert zz.checked_type == relay.ty.TensorType(out_shape, dtype)
+
+    func = relay.Function([x, y], z)
+    x_np = np.random.uniform(size=x_shape).astype(dtype)
+    y_np = np.random.uniform(size=y_shape).astype(dtype)
+    z_np = np.matmul(x_np, y_np.transpose(0, 2, 1))
+
+    # batch_matmul is only scheduled for cpu
+    for target, ctx in [("llvm", tvm.cpu(0))]:
+        for kind in ["graph", "debug"]:
+            intrp = relay.create_executor(kind, ctx=ctx, target=target)
+            z = intrp.evaluate(func)(x_np, y_np)
+            tvm.testing.assert_allclose(z.asnumpy(), z_np, rtol=1e-5)
+
+def test_batch_matmul():
+    b, m, n, k = tvm.var("b"), tvm.var("m"), tvm.var("n"), tvm.var("k")
+    x = relay.var("x", relay.TensorType((b, m, k), "float32"))
+    y = relay.var("y", relay.TensorType((b, n, k), "float32"))
+    z = relay.nn.batch_matmul(x, y)
+    zz = relay.ir_pass.infer_type(z)
+    assert zz.checked_type == relay.TensorType((b, m, n), "float32")
+
+    verify_batch_matmul((1, 16, 32), (1, 16, 32), (1, 16, 16))
+    verify_batch_matmul((5, 16, 32), (5, 16, 32), (5, 16, 16))
+    verify_batch_matmul((5, 16, 32), (5, 20, 32), (5, 16, 20))
+    verify_batch_matmul((30, 16, 32), (30, 20, 32), (30, 16, 20))
+
+def test_sparse_dense():
+    m = tvm.var("m")
+    x = relay.var("x", relay.TensorType((m, 128), "float32"))
+    # CSR weight of 64 rows
+    w_data = relay.var("w_data", relay.TensorType((300,), "float32"))
+    w_indices = relay.var("w_indices", relay.TensorType((300,), "int32"))
+    w_indptr = relay.var("w_indptr", relay.TensorType((65,), "int32"))
+    y = relay.nn.sparse_dense(x, w_data, w_indices, w_indptr)
+    yy = relay.ir_pass.infer_type(y)
+    assert yy.checked_type == relay.TensorType((m, 64), "float32")
+    # BSR weight of 8 block rows of 8x1 blocks
+    w_data = relay.var("w_data", relay.TensorType((30, 8, 1), "float32"))
+    w_indices = relay.var("w_indices", relay.TensorType((30,), "int32"))
+    w_indptr = relay.var("w_indptr", relay.TensorType((9,), "int32"))
+    y = relay.nn.sparse_dense(x, w_data, w_indices, w_indptr)
+    yy = relay.ir_pass.infer_type(y)
+    assert yy.checked_type == relay.TensorType((m, 64), "float32")
+
 if __name__ == "__main__":
     test_collapse_sum_like()
     test_broadcast_to_like()
     test_slice_like()
     test_reverse_reshape()
+    test_batch_matmul()
+    test_sparse_dense()
@@ -2,7 +2,9 @@
 """
 import tvm
 from tvm import relay
+from tvm import autotvm
 from tvm.relay.testing import ctx_list
+from tvm.contrib import graph_runtime
 import numpy as np
 import topi.testing
 
@@ -120,6 +122,45 @@ def test_conv2d_run():
                     padding=(1, 1), channels=10, kernel_size=(3 ,3), dilation=(3, 3))
 
 
+def test_conv2d_winograd_x86():
+    dshape = (1, 64, 16, 16)
+    kshape = (64, 64, 3, 3)
+    x = relay.var("x", shape=dshape)
+    w = relay.var("w", shape=kshape)
+    # out_dtype is set so that the workload matches the tuned record.
+    y = relay.nn.conv2d(x, w, padding=(1, 1), channels=64, kernel_size=(3, 3),
+                        out_dtype="float32")
+    func = relay.Function([x, w], y)
+    data = np.random.uniform(-1, 1, size=dshape).astype("float32")
+    kernel = np.random.uniform(-1, 1, size=kshape).astype("float32")
+    ref_res = topi.testing.conv2d_nchw_python(data, kernel, 1, (1, 1))
+
+    # without a tuned config, the direct template is kept.
+    with relay.build_config(opt_level=3):
+        graph, _, _ = relay.build(func, "llvm", params={"w": kernel})
+    assert "winograd" not in graph
+
+    # with a tuned winograd config, the x86 alter layout picks winograd
+    # and the kernel transform is folded into the params.
+    target = tvm.target.create("llvm")
+    task = autotvm.task.create("topi_nn_conv2d",
+                               args=(('TENSOR', dshape, 'float32'),
+                                     ('TENSOR', kshape, 'float32'),
+                                     (1, 1), (1, 1), (1, 1), 'NCHW', 'float32'),
+                               target=target, template_key="winograd")
+    inp = autotvm.MeasureInput(target, task, task.config_space.get(0))
+    res = autotvm.MeasureResult((1e-3,), 0, 0, 0)
+    with autotvm.apply_history_best([(inp, res)]):
+        with relay.build_config(opt_level=3):
+            graph, lib, params = relay.build(func, target, params={"w": kernel})
+    assert "winograd_without_weight_transform" in graph
+    m = graph_runtime.create(graph, lib, tvm.cpu())
+    m.set_input("x", data)
+    m.set_input(**params)
+    m.run()
+    tvm.testing.assert_allclose(m.get_output(0).asnumpy(), ref_res, rtol=1e-4, atol=1e-4)
+
+
 def test_conv2d_transpose_infer_type():
     # symbolic in batch dimension
     n, c, h, w = tvm.var("n"), 10, 10, 12
@@ -476,5 +517,6 @@ if __name__ == "__main__":
     test_conv2d_transpose_infer_type()
     test_conv2d_transpose_run()
     test_conv2d_run()
+    test_conv2d_winograd_x86()
     test_batch_flatten()
     test_upsampling()
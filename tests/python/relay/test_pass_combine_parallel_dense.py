@@ -0,0 +1,108 @@
+from tvm import relay
+
+
+def test_combine_parallel_dense():
+    """Simple testcase. One dense cannot be combined due to shape mismatch"""
+    def before(x, w1, w2, w3, w4):
+        args = [x, w1, w2, w3, w4]
+        y1 = relay.nn.dense(x, w1)
+        y2 = relay.nn.dense(x, w2)
+        # y3 cannot be combined
+        y3 = relay.nn.dense(x, w3)
+        y4 = relay.nn.dense(x, w4)
+        y = relay.Tuple((y1, y2, y3, y4))
+        return relay.Function(args, y)
+
+    def expected(x, w1, w2, w3, w4, units1, units2, units4):
+        # use a fixed order of args so alpha equal check can pass
+        args = [x, w1, w2, w3, w4]
+        w = relay.concatenate((w1, w2, w4), axis=0)
+        y = relay.nn.dense(x, w, units=units1 + units2 + units4)
+        y1 = relay.strided_slice(y, [0, 0], [None, units1])
+        y2 = relay.strided_slice(y, [0, units1], [None, units1 + units2])
+        y3 = relay.nn.dense(x, w3)
+        y4 = relay.strided_slice(y, [0, units1 + units2],
+                                 [None, units1 + units2 + units4])
+        y = relay.Tuple((y1, y2, y3, y4))
+        return relay.Function(args, y)
+
+    def check(i, j, k, units1, units2, units4):
+        x = relay.var("x", shape=(i, k))
+        w1 = relay.var("w1", shape=(units1, k))
+        w2 = relay.var("w2", shape=(units2, k))
+        w3 = relay.var("w3", shape=(j, k + 1))
+        w4 = relay.var("w4", shape=(units4, k))
+
+        y_before = before(x, w1, w2, w3, w4)
+        y = relay.ir_pass.infer_type(y_before)
+        y = relay.ir_pass.combine_parallel_dense(y)
+        y = relay.ir_pass.infer_type(y)
+        y_expected = expected(x, w1, w2, w3, w4, units1, units2, units4)
+        y_expected = relay.ir_pass.infer_type(y_expected)
+        assert relay.ir_pass.alpha_equal(y, y_expected)
+
+    check(3, 5, 4, 8, 8, 8)
+    check(100, 200, 300, 16, 32, 24)
+
+
+def test_combine_parallel_dense_biasadd():
+    """Testcase of combining dense + bias add + relu"""
+    def before(x, w1, w2, w3, b1, b2, b3):
+        args = [x, w1, w2, w3, b1, b2, b3]
+        ys = []
+        for w, b in [(w1, b1), (w2, b2), (w3, b3)]:
+            y = relay.nn.dense(x, w)
+            y = relay.add(y, b)
+            ys.append(relay.nn.relu(y))
+        return relay.Function(args, relay.Tuple(ys))
+
+    def expected(x, w1, w2, w3, b1, b2, b3, units):
+        args = [x, w1, w2, w3, b1, b2, b3]
+        w = relay.concatenate((w1, w2, w3), axis=0)
+        y = relay.nn.dense(x, w, units=sum(units))
+        b = relay.concatenate((b1, b2, b3), axis=0)
+        y = relay.add(y, b)
+        y = relay.nn.relu(y)
+        ys = []
+        begin = 0
+        for u in units:
+            ys.append(relay.strided_slice(y, [0, begin], [None, begin + u]))
+            begin += u
+        return relay.Function(args, relay.Tuple(ys))
+
+    def check(i, k, units):
+        x = relay.var("x", shape=(i, k))
+        w1, w2, w3 = [relay.var("w%d" % n, shape=(u, k)) for n, u in enumerate(units)]
+        b1, b2, b3 = [relay.var("b%d" % n, shape=(u,)) for n, u in enumerate(units)]
+        y = relay.ir_pass.infer_type(before(x, w1, w2, w3, b1, b2, b3))
+        y = relay.ir_pass.combine_parallel_dense(y)
+        y = relay.ir_pass.infer_type(y)
+        y_expected = expected(x, w1, w2, w3, b1, b2, b3, units)
+        y_expected = relay.ir_pass.infer_type(y_expected)
+        assert relay.ir_pass.alpha_equal(y, y_expected)
+
+    check(4, 16, (8, 8, 8))
+    check(4, 16, (8, 4, 12))
+
+
+def test_combine_parallel_dense_min_num_branches():
+    """Two branches are only combined if allowed by min_num_branches"""
+    x = relay.var("x", shape=(4, 16))
+    w1 = relay.var("w1", shape=(8, 16))
+    w2 = relay.var("w2", shape=(8, 16))
+    y = relay.Tuple((relay.nn.dense(x, w1), relay.nn.dense(x, w2)))
+    f = relay.ir_pass.infer_type(relay.Function([x, w1, w2], y))
+
+    y = relay.ir_pass.combine_parallel_dense(f)
+    assert relay.ir_pass.alpha_equal(y, f)
+
+    y = relay.ir_pass.combine_parallel_dense(f, min_num_branches=2)
+    y = relay.ir_pass.infer_type(y)
+    assert not relay.ir_pass.alpha_equal(y, f)
+    assert y.body.fields[0].op.name == "strided_slice"
+
+
+if __name__ == "__main__":
+    test_combine_parallel_dense()
+    test_combine_parallel_dense_biasadd()
+    test_combine_parallel_dense_min_num_branches()
@@ -0,0 +1,99 @@
+import numpy as np
+import tvm
+from tvm import relay
+from tvm.contrib import graph_runtime
+
+
+def random_sparse_weight(N, K, density, BS_R=1, BS_C=1):
+    mask = np.random.uniform(size=(N // BS_R, K // BS_C)) < density
+    mask = np.repeat(np.repeat(mask, BS_R, axis=0), BS_C, axis=1)
+    return (np.random.uniform(size=(N, K)) * mask).astype("float32")
+
+
+def run(func, params, x_np):
+    with relay.build_config(opt_level=3):
+        graph, lib, params = relay.build(func, "llvm", params=params)
+    m = graph_runtime.create(graph, lib, tvm.cpu(0))
+    m.set_input("x", x_np)
+    m.set_input(**params)
+    m.run()
+    return m.get_output(0).asnumpy()
+
+
+def verify_dense_to_sparse(M, N, K, density, blocksize, converted):
+    x = relay.var("x", shape=(M, K))
+    w = relay.var("w", shape=(N, K))
+    y = relay.nn.relu(relay.nn.dense(x, w))
+    func = relay.Function([x, w], y)
+
+    x_np = np.random.uniform(size=(M, K)).astype("float32")
+    w_np = random_sparse_weight(N, K, density, *blocksize)
+    params = {"w": tvm.nd.array(w_np)}
+    sparse_func, sparse_params = relay.ir_pass.dense_to_sparse(
+        func, params, blocksize=blocksize, sparsity_threshold=0.7)
+
+    assert ("sparse_dense" in sparse_func.astext()) == converted
+    assert ("w" in sparse_params) != converted
+    ref = np.maximum(x_np.dot(w_np.T), 0)
+    tvm.testing.assert_allclose(run(sparse_func, sparse_params, x_np), ref, rtol=1e-5)
+
+
+def test_dense_to_sparse_shared_weight():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    M, N, K = 4, 64, 128
+    x = relay.var("x", shape=(M, K))
+    w = relay.var("w", shape=(N, K))
+    y = relay.add(relay.nn.dense(x, w), relay.nn.dense(relay.nn.relu(x), w))
+    func = relay.Function([x, w], y)
+
+    x_np = np.random.uniform(-1, 1, size=(M, K)).astype("float32")
+    w_np = random_sparse_weight(N, K, 0.1, 8, 1)
+    sparse_func, sparse_params = relay.ir_pass.dense_to_sparse(
+        func, {"w": tvm.nd.array(w_np)}, blocksize=(8, 1), sparsity_threshold=0.7)
+
+    # the two dense ops share one converted weight
+    assert sorted(sparse_params.keys()) == ["w.data", "w.indices", "w.indptr"]
+    assert len(sparse_func.params) == 4
+    ref = x_np.dot(w_np.T) + np.maximum(x_np, 0).dot(w_np.T)
+    tvm.testing.assert_allclose(run(sparse_func, sparse_params, x_np), ref, rtol=1e-5)
+
+
+def test_dense_to_sparse_symbolic_batch():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    N, K = 64, 128
+    x = relay.var("x", shape=(tvm.var("n"), K))
+    w = relay.var("w", shape=(N, K))
+    func = relay.Function([x, w], relay.nn.dense(x, w))
+    w_np = random_sparse_weight(N, K, 0.1, 8, 1)
+    sparse_func, sparse_params = relay.ir_pass.dense_to_sparse(
+        func, {"w": tvm.nd.array(w_np)}, sparsity_threshold=0.7)
+    assert "sparse_dense" in sparse_func.astext()
+
+    # the kernel binds the batch when it is called
+    sparse_func = relay.ir_pass.infer_type(sparse_func)
+    f = relay.backend.compile_engine.get().jit(sparse_func, "llvm")
+    x_np = np.random.uniform(size=(7, K)).astype("float32")
+    args = [tvm.nd.array(x_np)] + [sparse_params[p.name_hint] for p in sparse_func.params[1:]]
+    out = tvm.nd.empty((7, N))
+    f(*(args + [out]))
+    tvm.testing.assert_allclose(out.asnumpy(), x_np.dot(w_np.T), rtol=1e-5)
+
+
+def test_dense_to_sparse():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    verify_dense_to_sparse(1, 64, 128, 0.1, (1, 1), True)
+    verify_dense_to_sparse(4, 64, 128, 0.1, (8, 1), True)
+    verify_dense_to_sparse(4, 64, 128, 0.1, (16, 4), True)
+    verify_dense_to_sparse(4, 64, 128, 0.9, (8, 1), False)
+
+
+if __name__ == "__main__":
+    test_dense_to_sparse()
+    test_dense_to_sparse_shared_weight()
+    test_dense_to_sparse_symbolic_batch()
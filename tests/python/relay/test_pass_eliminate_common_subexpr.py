@@ -0,0 +1,72 @@
+"""Test eliminate common subexpr pass"""
+from tvm import relay
+from tvm.relay import ir_pass
+
+
+def test_simple():
+    def before():
+        x = relay.var("x", shape=(1, 16))
+        one = relay.const(1.0, "float32")
+        y1 = relay.nn.relu(x)
+        y2 = relay.nn.relu(x)
+        y1 = relay.add(y1, one)
+        y2 = relay.add(y2, one)
+        y = relay.add(y1, y2)
+        f = relay.Function([x], y)
+        return f
+
+    def expected():
+        x = relay.var("x", shape=(1, 16))
+        y = relay.nn.relu(x)
+        y = relay.add(y, relay.const(1.0, "float32"))
+        y = relay.add(y, y)
+        f = relay.Function([x], y)
+        return f
+
+    z = before()
+    z = ir_pass.eliminate_common_subexpr(z)
+    assert ir_pass.alpha_equal(z, expected())
+
+
+def test_attrs():
+    def before():
+        x = relay.var("x", shape=(1, 16))
+        y1 = relay.reshape(x, newshape=(4, 4))
+        y2 = relay.reshape(x, newshape=(4, 4))
+        y3 = relay.reshape(x, newshape=(2, 8))
+        y = relay.Tuple([y1, y2, y3])
+        return relay.Function([x], y)
+
+    def expected():
+        x = relay.var("x", shape=(1, 16))
+        y1 = relay.reshape(x, newshape=(4, 4))
+        y3 = relay.reshape(x, newshape=(2, 8))
+        y = relay.Tuple([y1, y1, y3])
+        return relay.Function([x], y)
+
+    z = ir_pass.eliminate_common_subexpr(before())
+    assert ir_pass.alpha_equal(z, expected())
+
+
+def test_report():
+    def before():
+        x = relay.var("x", shape=(1, 8, 16, 16))
+        w = relay.var("w", shape=(8, 8, 3, 3))
+        y1 = relay.nn.conv2d(x, w, kernel_size=(3, 3), padding=(1, 1), channels=8)
+        y2 = relay.nn.conv2d(x, w, kernel_size=(3, 3), padding=(1, 1), channels=8)
+        y = relay.add(relay.nn.relu(y1), relay.nn.relu(y2))
+        return relay.Function([x, w], y)
+
+    z = ir_pass.infer_type(before())
+    z, num_nodes, num_macs = ir_pass.eliminate_common_subexpr_report(z)
+    # the second conv2d and relu are removed.
+    assert num_nodes == 2
+    assert num_macs == 8 * 8 * 16 * 16 * 3 * 3
+    z = ir_pass.infer_type(z)
+    assert ir_pass.get_total_mac_number(z) == num_macs
+
+
+if __name__ == "__main__":
+    test_simple()
+    test_attrs()
+    test_report()
@@ -287,6 +287,93 @@ def test_fuse_myia_regression():
     assert relay.ir_pass.alpha_equal(f, after)
 
 
+def test_fuse_cost_model():
+    """Test the fusion gated by a cost model."""
+    def before():
+        x = relay.var("x", shape=(10, 20))
+        y = relay.add(x, relay.const(1, "float32"))
+        z = relay.exp(y)
+        return relay.Function([x], z)
+
+    def expected():
+        x = relay.var("p", shape=(10, 20))
+        y = relay.add(x, relay.const(1, "float32"))
+        f1 = relay.Function([x], y)
+        x = relay.var("p", shape=(10, 20))
+        z = relay.exp(x)
+        f2 = relay.Function([x], z)
+        x = relay.var("x", shape=(10, 20))
+        y = relay.Call(f1, [x])
+        z = relay.Call(f2, [y])
+        return relay.Function([x], z)
+
+    z = relay.ir_pass.infer_type(before())
+    # the memory traffic estimate accepts the elemwise chain.
+    zz = relay.ir_pass.fuse_ops(z, opt_level=2, cost_model="memory")
+    zz = relay.ir_pass.infer_type(zz)
+    after = relay.ir_pass.infer_type(relay.ir_pass.fuse_ops(z, opt_level=2))
+    assert relay.ir_pass.alpha_equal(zz, after)
+
+    calls = []
+    def reject_all(src, sink, nodes, gain):
+        calls.append((src, sink, len(nodes), gain))
+        return -1.0
+    zz = relay.ir_pass.fuse_ops(z, opt_level=2, cost_model=reject_all)
+    zz = relay.ir_pass.infer_type(zz)
+    assert relay.ir_pass.alpha_equal(zz, relay.ir_pass.infer_type(expected()))
+    assert len(calls) == 1
+    assert calls[0][2] == 1
+    # the add result is neither written nor read back.
+    assert calls[0][3] == 10 * 20 * 4 * 2
+
+
+def test_fuse_cost_model_recompute():
+    """Injective op with several consumers which reads a slice of a large input."""
+    def before():
+        x = relay.var("x", shape=(1000,))
+        y = relay.strided_slice(x, begin=[0], end=[10])
+        z = relay.add(relay.exp(y), relay.sqrt(y))
+        return relay.Function([x], z)
+
+    z = relay.ir_pass.infer_type(before())
+    report = relay.ir_pass.fuse_ops_report(z, opt_level=2)
+    # recomputing the slice only reads the 10 elements it produces.
+    assert "accept strided_slice" in report
+    assert "reject" not in report
+    zz = relay.ir_pass.fuse_ops(z, opt_level=2, cost_model="memory")
+    zz = relay.ir_pass.infer_type(zz)
+    # everything is fused into a single function.
+    assert zz.body.op.body.op.name == "add"
+    assert isinstance(zz.body.args[0], relay.Var)
+
+
+def test_fuse_cost_model_locality():
+    """A long elementwise chain is split by the memory cost model."""
+    x = relay.var("x", shape=(10, 20))
+    y = x
+    for _ in range(20):
+        y = relay.exp(y)
+    z = relay.ir_pass.infer_type(relay.Function([x], y))
+
+    # the patterns alone fuse the whole chain.
+    zz = relay.ir_pass.fuse_ops(z, opt_level=2)
+    assert isinstance(zz.body.args[0], relay.Var)
+
+    report = relay.ir_pass.fuse_ops_report(z, opt_level=2)
+    assert report.count("reject") == 1
+    zz = relay.ir_pass.fuse_ops(z, opt_level=2, cost_model="memory")
+    zz = relay.ir_pass.infer_type(zz)
+    # the first group stops at 16 nodes, beyond which it would spill.
+    inner = zz.body.args[0]
+    assert isinstance(inner.args[0], relay.Var)
+    num_ops = 0
+    body = inner.op.body
+    while isinstance(body, relay.Call):
+        num_ops += 1
+        body = body.args[0]
+    assert num_ops == 16
+
+
 if __name__ == "__main__":
     test_fuse_simple()
     test_conv2d_fuse()
@@ -295,3 +382,6 @@ if __name__ == "__main__":
     test_tuple_strided_slice()
     test_stop_fusion()
     test_fuse_myia_regression()
+    test_fuse_cost_model()
+    test_fuse_cost_model_recompute()
+    test_fuse_cost_model_locality()
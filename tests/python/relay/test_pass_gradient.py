@@ -8,6 +8,15 @@ import numpy as np
 def rand(dtype='float32', *shape):
     return tvm.nd.array(np.random.rand(*shape).astype(dtype))
 
+def count_calls(expr, op_name):
+    calls = []
+    def fvisit(e):
+        if isinstance(e, relay.Call) and isinstance(e.op, relay.Op) \
+           and e.op.name == op_name:
+            calls.append(e)
+    relay.ir_pass.post_order_visit(expr, fvisit)
+    return len(calls)
+
 def test_id():
     shape = (10, 10)
     dtype = 'float32'
@@ -123,6 +132,54 @@ def test_broadcast_subtract():
                                -np.ones_like(expected_forward).sum(axis=(0, 1), keepdims=True).squeeze(axis=0))
 
 
+def test_checkpoint():
+    shape = (10, 10)
+    dtype = 'float32'
+    t = relay.TensorType(shape, dtype)
+    x = relay.var("x", t)
+    h = relay.nn.relu(x * x)
+    h = relay.annotation.checkpoint(h)
+    h = relay.nn.relu(h * x)
+    h = relay.exp(h * x)
+    func = relay.Function([x], h * x)
+
+    ex = create_executor()
+    x = rand(dtype, *shape)
+    back_func = relay.ir_pass.infer_type(gradient(func))
+    forward, (grad,) = ex.evaluate(back_func)(x)
+    for checkpoint in ["annotation", 10 * 10 * 4 * 2]:
+        func = relay.ir_pass.infer_type(func)
+        remat_func = relay.ir_pass.infer_type(gradient(func, checkpoint=checkpoint))
+        assert remat_func.checked_type == back_func.checked_type
+        # the intermediates after the checkpoint are recomputed.
+        assert count_calls(remat_func, "multiply") > count_calls(back_func, "multiply")
+        remat_forward, (remat_grad,) = ex.evaluate(remat_func)(x)
+        np.testing.assert_allclose(remat_forward.asnumpy(), forward.asnumpy())
+        np.testing.assert_allclose(remat_grad.asnumpy(), grad.asnumpy(), rtol=1e-5)
+
+
+def test_lazy_zero_adjoint():
+    shape = (10, 10)
+    dtype = 'float32'
+    t = relay.TensorType(shape, dtype)
+    x = relay.var("x", t)
+    y = relay.var("y", t)
+    h = relay.exp(relay.exp(x))
+    func = relay.Function([x, y], h * h)
+    back_func = relay.ir_pass.infer_type(gradient(func))
+    # no zero adjoint is kept alive for the intermediates, only y,
+    # which does not reach the output, gets a zero gradient.
+    assert count_calls(back_func, "zeros_like") == 1
+    ex = create_executor()
+    x = rand(dtype, *shape)
+    y = rand(dtype, *shape)
+    forward, (grad_x, grad_y) = ex.evaluate(back_func)(x, y)
+    e = np.exp(np.exp(x.asnumpy()))
+    np.testing.assert_allclose(forward.asnumpy(), e * e, rtol=1e-5)
+    np.testing.assert_allclose(grad_x.asnumpy(), 2 * e * e * np.exp(x.asnumpy()), rtol=1e-5)
+    np.testing.assert_allclose(grad_y.asnumpy(), np.zeros_like(y.asnumpy()))
+
+
 if __name__ == "__main__":
     test_id()
     test_add()
@@ -130,3 +187,5 @@ if __name__ == "__main__":
     test_sub()
     test_broadcast_add()
     test_broadcast_subtract()
+    test_checkpoint()
+    test_lazy_zero_adjoint()
@@ -78,7 +78,104 @@ def test_quantize_pass():
     tvm.testing.assert_allclose(res0.asnumpy(), res1.asnumpy())
 
 
+def test_quantize_per_channel():
+    n, c, h, w = 1, 4, 8, 8
+    data = relay.var("data", relay.TensorType((n, c, h, w), "float32"))
+    weight = relay.var("conv_weight")
+    out = relay.nn.conv2d(data, weight, kernel_size=(3, 3), padding=(1, 1), channels=c)
+    out = relay.nn.relu(out)
+    out = relay.nn.batch_flatten(out)
+    out = relay.nn.dense(out, relay.var("dense_weight"), units=16)
+    graph = relay.Function(relay.ir_pass.free_vars(out), out)
+    dataset, params = make_dataset(graph, 1)
+    # scale the output channels of the weights so that a per tensor scale loses precision
+    for name in ['conv_weight', 'dense_weight']:
+        arr = params[name].asnumpy()
+        arr *= np.logspace(-2, 0, arr.shape[0]).reshape((-1,) + (1,) * (arr.ndim - 1))
+        params[name] = tvm.nd.array(arr.astype('float32'))
+
+    executor = relay.create_executor('graph')
+    expected = executor.evaluate(relay.build_module._bind_params_by_name(graph, params))(
+        dataset[0]['data']).asnumpy()
+
+    # fixed_point_requantize is enabled along with per_channel_weight.
+    with qtz.qconfig(skip_k_conv=0, global_scale=8.0, per_channel_weight=True):
+        assert qtz.current_qconfig().fixed_point_requantize
+        qgraph = qtz.quantize(graph, params)
+        qgraph = relay.ir_pass.infer_type(qgraph)
+    # the conv output is requantized with an integer multiplier per channel
+    assert any(p.data.dtype == 'int64' and p.data.shape == (c, 1, 1)
+               for p in _collect_constants(qgraph))
+    res = executor.evaluate(qgraph)(dataset[0]['data']).asnumpy()
+    tvm.testing.assert_allclose(res, expected, rtol=0.1, atol=0.1 * np.abs(expected).max())
+
+    try:
+        qtz.qconfig(per_channel_weight=True, fixed_point_requantize=False)
+        assert False
+    except ValueError:
+        pass
+
+
+def test_quantize_dense_float():
+    n, c, h, w = 1, 4, 8, 8
+    data = relay.var("data", relay.TensorType((n, c, h, w), "float32"))
+    weight = relay.var("conv_weight")
+    out = relay.nn.conv2d(data, weight, kernel_size=(3, 3), padding=(1, 1), channels=c)
+    out = relay.nn.batch_flatten(out)
+    out = relay.nn.dense(out, relay.var("dense_weight"), units=16)
+    graph = relay.Function(relay.ir_pass.free_vars(out), out)
+    dataset, params = make_dataset(graph, 1)
+
+    # without per channel weights dense is not quantized and runs in float32.
+    with qtz.qconfig(skip_k_conv=0, global_scale=8.0):
+        qgraph = qtz.quantize(graph, params)
+        qgraph = relay.ir_pass.infer_type(qgraph)
+    dense = []
+    relay.ir_pass.post_order_visit(
+        qgraph, lambda e: dense.append(e) if isinstance(e, relay.Call)
+        and e.op.name == "nn.dense" else None)
+    assert len(dense) == 1
+    assert all(arg.checked_type.dtype == "float32" for arg in dense[0].args)
+    assert isinstance(dense[0].args[1], relay.Constant)
+    assert dense[0].args[1].data.dtype == "float32"
+
+
+def test_quantize_per_channel_add():
+    n, c, h, w = 1, 4, 8, 8
+    data = relay.var("data", relay.TensorType((n, c, h, w), "float32"))
+    weight = relay.var("conv_weight")
+    out = relay.nn.conv2d(data, weight, kernel_size=(3, 3), padding=(1, 1), channels=c)
+    out = relay.add(out, data)
+    graph = relay.Function(relay.ir_pass.free_vars(out), out)
+    dataset, params = make_dataset(graph, 1)
+    # the scales of the channels are 4 orders of magnitude apart
+    arr = params['conv_weight'].asnumpy()
+    arr *= np.logspace(-4, 0, c).reshape((-1, 1, 1, 1))
+    params['conv_weight'] = tvm.nd.array(arr.astype('float32'))
+
+    executor = relay.create_executor('graph')
+    expected = executor.evaluate(relay.build_module._bind_params_by_name(graph, params))(
+        dataset[0]['data']).asnumpy()
+
+    with qtz.qconfig(skip_k_conv=0, global_scale=8.0, per_channel_weight=True):
+        qgraph = qtz.quantize(graph, params)
+        qgraph = relay.ir_pass.infer_type(qgraph)
+    # the per channel conv output is requantized before the add, only scaling down.
+    res = executor.evaluate(qgraph)(dataset[0]['data']).asnumpy()
+    tvm.testing.assert_allclose(res, expected, rtol=0.1, atol=0.1 * np.abs(expected).max())
+
+
+def _collect_constants(expr):
+    consts = []
+    relay.ir_pass.post_order_visit(
+        expr, lambda e: consts.append(e) if isinstance(e, relay.Constant) else None)
+    return consts
+
+
 if __name__ == "__main__":
     np.random.seed(42)
     test_simulated_quantize()
     test_quantize_pass()
+    test_quantize_per_channel()
+    test_quantize_dense_float()
+    test_quantize_per_channel_add()
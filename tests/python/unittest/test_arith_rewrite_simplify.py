@@ -0,0 +1,163 @@
+import tvm
+
+class RewriteChecker:
+    def __init__(self):
+        self.analyzer = tvm.arith.Analyzer()
+
+    def verify(self, data, expected):
+        res = self.analyzer.rewrite_simplify(data)
+        assert tvm.ir_pass.Equal(res, expected), "data={}, res={}, expected={}".format(
+            data, res, expected)
+
+
+def test_vector_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+    ck.verify(tvm.expr.Ramp(x, 1, 4) + tvm.expr.Ramp(y, 2, 4),
+              tvm.expr.Ramp(x + y, 3, 4))
+    ck.verify(tvm.expr.Ramp(x, 1, 2) + y,
+              tvm.expr.Ramp(x + y, 1, 2))
+    ck.verify(y + tvm.expr.Ramp(x, 1, 2) ,
+              tvm.expr.Ramp(y + x, 1, 2))
+    ck.verify(y.astype("int32x2") + x.astype("int32x2"),
+              (y + x).astype("int32x2"))
+
+
+def test_add_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+
+    ck.verify(x + (y - x), y)
+    ck.verify((x - 10) + (10 - z), x - z)
+    ck.verify((x - y) + (z - x), z - y)
+
+    ck.verify(tvm.min(x, y - z) + z, tvm.min(x + z, y))
+    ck.verify(tvm.max(x, y) + tvm.min(x, y), x + y)
+
+    ck.verify(x + x, x * 2)
+    ck.verify(x * y + x, x * (y + 1))
+    ck.verify(x * y + x * z, x * (y + z))
+
+    ck.verify((x / 8) * 8 + x % 8, x)
+    ck.verify(x % 8 + (x / 8) * 8, x)
+
+    ck.verify((x + 1) + 2, x + 3)
+    ck.verify(2 + x, x + 2)
+
+
+def test_sub_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+
+    ck.verify(x + y - y, x)
+    ck.verify(x + y - x, y)
+    ck.verify(x - (y + x), 0 - y)
+    ck.verify(x - x, 0)
+    ck.verify((x + y) - (x + z), y - z)
+    ck.verify(tvm.min(x, y) - x, tvm.min(0, y - x))
+    ck.verify(x - tvm.max(x, y), tvm.min(0, x - y))
+    ck.verify(x * y - x, x * (y + (-1)))
+    ck.verify(x - (x / 3) * 3, x % 3)
+
+
+def test_mul_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+    ck.verify((x + 2) * 3, x * 3 + 6)
+    ck.verify((x * 2) * 3, x * 6)
+    ck.verify(tvm.min(x, y) * tvm.max(x, y), x * y)
+
+
+def test_div_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+    ck.analyzer.update(x, tvm.arith.ConstIntBound(0, 1000), override=True)
+    ck.analyzer.update(y, tvm.arith.ConstIntBound(0, 1000), override=True)
+
+    ck.verify(x / 2 / 3, x / 6)
+    ck.verify((x * 4) / 2, x * 2)
+    ck.verify((x * 4 + y) / 2, x * 2 + y / 2)
+    ck.verify((x * 4) / 8, x / 2)
+    # not simplified when the sign of the operand is unknown.
+    ck.verify((z * 4 + y) / 2, (z * 4 + y) / 2)
+
+
+def test_mod_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+    ck.analyzer.update(x, tvm.arith.ConstIntBound(0, 1000), override=True)
+    ck.analyzer.update(y, tvm.arith.ConstIntBound(0, 1000), override=True)
+
+    ck.verify((x * 10) % 2, 0)
+    ck.verify((x * 10 + y) % 2, y % 2)
+    ck.verify((x % 4) % 2, x % 2)
+
+
+def test_min_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+    ck.verify(tvm.min(x, x), x)
+    ck.verify(tvm.min(x + 1, x + 10), x + 1)
+    ck.verify(tvm.min(x + 111, x + 10), x + 10)
+    ck.verify(tvm.min(x, x + 10), x)
+    ck.verify(tvm.min(tvm.max(x, y), x), x)
+    ck.verify(tvm.min(tvm.min(x, y), x), tvm.min(x, y))
+    ck.verify(tvm.min(y + x, z + x), tvm.min(y, z) + x)
+
+    ck.analyzer.update(x, tvm.arith.ConstIntBound(0, 10), override=True)
+    ck.verify(tvm.min(x, 11), x)
+
+
+def test_max_index_simplify():
+    ck = RewriteChecker()
+    x, y, z = tvm.var("x"), tvm.var("y"), tvm.var("z")
+    ck.verify(tvm.max(x, x), x)
+    ck.verify(tvm.max(tvm.min(x, y), x), x)
+    ck.verify(tvm.max(tvm.max(x, y), x), tvm.max(x, y))
+    ck.verify(tvm.max(y + x, z + x), tvm.max(y, z) + x)
+
+    ck.analyzer.update(x, tvm.arith.ConstIntBound(0, 10), override=True)
+    ck.verify(tvm.max(x, -1), x)
+
+
+def test_cmp_simplify():
+    ck = RewriteChecker()
+    x, y = tvm.var("x"), tvm.var("y")
+    ck.verify(x + 10 == 0, x == -10)
+    ck.verify(x - 10 != 0, x != 10)
+    ck.verify(x + 2 < 10, x < 8)
+    ck.verify(x + 2 >= 10, x >= 8)
+
+    ck.analyzer.update(x, tvm.arith.ConstIntBound(0, 10), override=True)
+    assert ck.analyzer.can_prove(x < 11)
+    assert ck.analyzer.can_prove(x >= 0)
+    assert not ck.analyzer.can_prove(x < 10)
+
+
+def test_logical_simplify():
+    ck = RewriteChecker()
+    x, y = tvm.var("x"), tvm.var("y")
+    ck.verify(tvm.expr.And(x == y, x != y), tvm.const(False, "bool"))
+    ck.verify(tvm.expr.Or(x == y, x != y), tvm.const(True, "bool"))
+    ck.verify(tvm.expr.Not(x < y), y <= x)
+
+
+def test_bind_simplify():
+    ck = RewriteChecker()
+    x, y = tvm.var("x"), tvm.var("y")
+    ck.analyzer.bind(y, x + 1)
+    ck.verify(y - x, 1)
+
+
+if __name__ == "__main__":
+    test_vector_simplify()
+    test_add_index_simplify()
+    test_sub_index_simplify()
+    test_mul_index_simplify()
+    test_div_index_simplify()
+    test_mod_index_simplify()
+    test_min_index_simplify()
+    test_max_index_simplify()
+    test_cmp_simplify()
+    test_logical_simplify()
+    test_bind_simplify()
@@ -94,6 +94,46 @@ def test_feature_shape():
                                                    " for different configurations"
 
 
+def test_feature_batch():
+    """test batched extraction matches the one-by-one extraction"""
+
+    N = 128
+
+    def get_gemm(factor):
+        k = tvm.reduce_axis((0, N), 'k')
+        A = tvm.placeholder((N, N), name='A')
+        B = tvm.placeholder((N, N), name='B')
+        C = tvm.compute(A.shape, lambda y, x: tvm.sum(A[y, k] * B[k, x], axis=k),
+                        name='C')
+        s = tvm.create_schedule(C.op)
+        y, x = s[C].op.axis
+        if factor > 1:
+            s[C].tile(y, x, factor, factor)
+        return s, [A, B, C]
+
+    factors = [1, 2, 4, 8, 16, 32]
+
+    for num_threads in [1, 4]:
+        feas = feature.get_itervar_feature_flatten_batch(
+            [get_gemm(f) for f in factors], take_log=True, num_threads=num_threads)
+        assert feas.shape[0] == len(factors)
+        for i, f in enumerate(factors):
+            s, args = get_gemm(f)
+            expected = np.array(feature.get_itervar_feature_flatten(s, args, take_log=True))
+            np.testing.assert_allclose(feas[i, :len(expected)], expected)
+            assert np.all(feas[i, len(expected):] == 0)
+
+        feas = feature.get_buffer_curve_sample_flatten_batch(
+            [get_gemm(f) for f in factors], sample_n=10, num_threads=num_threads)
+        for i, f in enumerate(factors):
+            s, args = get_gemm(f)
+            expected = np.array(feature.get_buffer_curve_sample_flatten(s, args, sample_n=10))
+            np.testing.assert_allclose(feas[i, :len(expected)], expected)
+
+    assert feature.get_itervar_feature_flatten_batch([]).shape == (0, 0)
+
+
 if __name__ == "__main__":
     test_iter_feature_gemm()
     test_feature_shape()
+    test_feature_batch()
@@ -8,6 +8,7 @@ import tvm
 from tvm import autotvm
 from test_autotvm_common import get_sample_task, bad_matmul
 from tvm.autotvm.measure.measure import Runner, MeasureResult, MeasureErrorNo
+from tvm.autotvm.measure.measure_methods import reject_noisy_costs
 
 def test_task_tuner_without_measurement():
     """test task and tuner without measurement"""
@@ -69,9 +70,38 @@ def test_check_correctness():
                callbacks=[_callback_wrong])
 
 
+def test_reject_noisy_costs():
+    kept, noisy = reject_noisy_costs((1.0, 1.02, 1.5, 0.99), 0.05)
+    assert kept == (1.0, 1.02, 0.99)
+    assert not noisy
+
+    kept, noisy = reject_noisy_costs((1.0, 2.0, 3.0), 0.05)
+    assert kept == (1.0,)
+    assert noisy
+
+
+def test_noise_tolerant_runner():
+    task, target = get_sample_task()
+
+    measure_option = autotvm.measure_option(
+        builder=autotvm.LocalBuilder(),
+        runner=autotvm.LocalRunner(repeat=5, noise_tolerance=0.5)
+    )
+
+    def _callback(tuner, measure_inputs, measure_results):
+        for inp, res in zip(measure_inputs, measure_results):
+            assert res.error_no == 0
+            assert 0 < len(res.costs) <= 5
+
+    tuner = autotvm.tuner.RandomTuner(task)
+    tuner.tune(n_trial=2, measure_option=measure_option, callbacks=[_callback])
+
+
 if __name__ == '__main__':
     logging.basicConfig(level=logging.INFO)
 
     test_task_tuner_without_measurement()
     test_check_correctness()
+    test_reject_noisy_costs()
+    test_noise_tolerant_runner()
 
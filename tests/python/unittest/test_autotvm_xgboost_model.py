@@ -5,7 +5,10 @@ import numpy as np
 import tvm
 from tvm import autotvm
 from tvm.autotvm import MeasureInput, MeasureResult
+from tvm.autotvm.tuner import xgboost_cost_model
 from tvm.autotvm.tuner.xgboost_cost_model import XGBoostCostModel
+from tvm.autotvm.tuner.sa_model_optimizer import NativeSimulatedAnnealingOptimizer
+from tvm.autotvm.tuner.tree_ensemble import TreeEnsemble
 
 from test_autotvm_common import get_sample_task, get_sample_records
 
@@ -26,6 +29,18 @@ def test_fit():
     upper_model.fit(xs, ys, plan_size=32)
 
 
+def test_get_feature_batch():
+    """the batched extraction of the cost model matches the one-by-one extraction"""
+    task, target = get_sample_task()
+    indexes = np.arange(16)
+    for fea_type, extract in [('itervar', xgboost_cost_model._extract_itervar_feature_index),
+                              ('curve', xgboost_cost_model._extract_curve_feature_index)]:
+        model = XGBoostCostModel(task, feature_type=fea_type, loss_type='rank')
+        feas = model._get_feature(indexes)
+        for index, fea in zip(indexes, feas):
+            np.testing.assert_allclose(fea, extract(index), rtol=1e-5)
+
+
 def test_tuner():
     task, target = get_sample_task()
     records = get_sample_records(n=100)
@@ -34,7 +49,48 @@ def test_tuner():
     tuner.load_history(records)
 
 
+def test_tree_ensemble():
+    # tree 0: f0 < 1 ? (f1 < 2 ? 1 : 2) : 3, tree 1: a single leaf
+    model = TreeEnsemble(tree_root=[0, 5],
+                         split_feature=[0, 1, 0, 0, 0, 0],
+                         threshold=[1, 2, 0, 0, 0, 0],
+                         left=[1, 2, -1, -1, -1, -1],
+                         right=[4, 3, -1, -1, -1, -1],
+                         missing=[1, 3, -1, -1, -1, -1],
+                         leaf_value=[0, 0, 1, 2, 3, 0.5],
+                         base_margin=0.25)
+    feas = np.array([[0, 0], [0, 5], [4, 0]], dtype=np.float32)
+    np.testing.assert_allclose(model.predict(feas), [1.75, 2.75, 3.75])
+    # missing feature
+    np.testing.assert_allclose(model.predict(np.zeros((1, 1))), [2.75])
+
+
+def test_native_sa():
+    task, target = get_sample_task()
+
+    model = XGBoostCostModel(task, feature_type='knob', loss_type='reg')
+    xs = np.arange(64)
+    ys = np.array([task.config_space.get(x).get_flatten_feature()[0] for x in xs])
+    model.fit(xs, ys, plan_size=8)
+
+    # the native model predicts the same as xgboost
+    native = model.to_native()
+    points = np.arange(len(task.config_space))
+    np.testing.assert_allclose(native.predict(model._get_feature(points)),
+                               model.predict(points), rtol=1e-4, atol=1e-4)
+
+    exclusive = set(range(0, len(task.config_space), 2))
+    opt = NativeSimulatedAnnealingOptimizer(task, n_iter=50, parallel_size=16, num_threads=2)
+    maximums = opt.find_maximums(model, 8, exclusive)
+    assert len(maximums) == 8
+    assert len(set(maximums)) == 8
+    assert all(0 <= x < len(task.config_space) and x not in exclusive for x in maximums)
+
+
 if __name__ == "__main__":
     test_fit()
+    test_get_feature_batch()
     test_tuner()
+    test_tree_ensemble()
+    test_native_sa()
 
@@ -3,6 +3,7 @@ from tvm.contrib import util, clang
 import numpy as np
 import ctypes
 import math
+import os
 
 def test_llvm_intrin():
     ib = tvm.ir_builder.create()
@@ -286,6 +287,37 @@ def test_multiple_func():
     check_llvm()
 
 
+def test_llvm_lazy_jit():
+    nn = 64
+    n = tvm.convert(nn)
+    A = tvm.placeholder((n,), name='A')
+    B = tvm.compute(A.shape, lambda *i: A(*i) + 1, name='B')
+    s = tvm.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], factor=8)
+    s[B].parallel(xo)
+    def check_llvm(mode):
+        if not tvm.module.enabled("llvm"):
+            return
+        funcs = [tvm.lower(s, [A, B], name="fadd%d" % i) for i in range(4)]
+        m = tvm.build(funcs, "llvm")
+        os.environ["TVM_LLVM_JIT_MODE"] = mode
+        try:
+            fadd = [m["fadd%d" % i] for i in reversed(range(4))]
+        finally:
+            del os.environ["TVM_LLVM_JIT_MODE"]
+        ctx = tvm.cpu(0)
+        a = tvm.nd.array(np.random.uniform(size=nn).astype(A.dtype), ctx)
+        for f in fadd:
+            b = tvm.nd.array(np.zeros(nn, dtype=B.dtype), ctx)
+            f(a, b)
+            tvm.testing.assert_allclose(b.asnumpy(), a.asnumpy() + 1)
+        # the entry function is still available.
+        b = tvm.nd.array(np.zeros(nn, dtype=B.dtype), ctx)
+        m.entry_func(a, b)
+        tvm.testing.assert_allclose(b.asnumpy(), a.asnumpy() + 1)
+    check_llvm("lazy")
+    check_llvm("lazy_async")
+
 
 def test_llvm_condition():
     def check_llvm(n, offset):
@@ -467,6 +499,7 @@ if __name__ == "__main__":
     test_llvm_add_pipeline()
     test_llvm_intrin()
     test_multiple_func()
+    test_llvm_lazy_jit()
     test_llvm_flip_pipeline()
     test_llvm_madd_pipeline()
     test_llvm_temp_space()
@@ -0,0 +1,78 @@
+import json
+import tvm
+from tvm.contrib import util
+
+
+def test_pass_profiler_lower():
+    n = 64
+    A = tvm.placeholder((n, n), name='A')
+    B = tvm.compute((n, n), lambda i, j: A[i, j] * 2, name='B')
+    s = tvm.create_schedule(B.op)
+    s[B].split(B.op.axis[1], factor=4)
+    with tvm.pass_profiler.PassProfiler() as prof:
+        tvm.lower(s, [A, B], name="fdouble")
+    records = prof.records()
+    names = [r["name"] for r in records]
+    for name in ["InferBound", "ScheduleOps", "StorageFlatten",
+                 "CanonicalSimplify", "Simplify", "MakeAPI"]:
+        assert name in names, name
+    for r in records:
+        assert r["duration_us"] >= 0
+        assert r["nodes_before"] > 0
+        assert r["peak_rss_bytes"] >= 0
+    assert "StorageFlatten" in prof.summary()
+    # nothing is recorded outside of the profiler scope.
+    tvm.lower(s, [A, B], name="fdouble")
+    assert len(prof.records()) == len(records)
+
+
+def test_pass_profiler_chrome_trace():
+    A = tvm.placeholder((16,), name='A')
+    B = tvm.compute((16,), lambda i: A[i] + 1, name='B')
+    s = tvm.create_schedule(B.op)
+    with tvm.pass_profiler.PassProfiler() as prof:
+        tvm.lower(s, [A, B])
+    temp = util.tempdir()
+    path = temp.relpath("trace.json")
+    prof.export_chrome_trace(path)
+    with open(path) as f:
+        trace = json.load(f)
+    events = trace["traceEvents"]
+    assert len(events) == len(prof.records())
+    assert all(e["ph"] == "X" for e in events)
+    assert "nodes_after" in events[0]["args"]
+
+
+def test_pass_profiler_relay():
+    from tvm import relay
+    x = relay.var("x", shape=(10,))
+    f = relay.Function([x], relay.add(x, x))
+    with tvm.pass_profiler.PassProfiler() as prof:
+        relay.ir_pass.infer_type(f)
+        # analyses are not recorded
+        relay.ir_pass.free_vars(f)
+    records = prof.records()
+    assert [r["name"] for r in records] == ["relay.infer_type"]
+    assert records[0]["nodes_after"] >= records[0]["nodes_before"]
+
+
+def test_pass_profiler_enabled_from_ffi():
+    from tvm import relay
+    x = relay.var("x", shape=(10,))
+    f = relay.Function([x], relay.add(x, x))
+    set_enabled = tvm.get_global_func("_PassProfilerSetEnabled")
+    tvm.get_global_func("_PassProfilerClear")()
+    set_enabled(True)
+    try:
+        relay.ir_pass.infer_type(f)
+    finally:
+        set_enabled(False)
+    records = json.loads(tvm.get_global_func("_PassProfilerToJSON")())
+    assert [r["name"] for r in records] == ["relay.infer_type"]
+
+
+if __name__ == "__main__":
+    test_pass_profiler_lower()
+    test_pass_profiler_chrome_trace()
+    test_pass_profiler_relay()
+    test_pass_profiler_enabled_from_ffi()
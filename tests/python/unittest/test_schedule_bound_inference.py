@@ -290,6 +290,26 @@ def test_bound_tensor_compute_op():
     assert isinstance(bounds, tvm.container.Map)
     assert(bounds[B.op.axis[0]].extent.value == 10)
 
+def test_bound_shared_consumer():
+    m = tvm.var('m')
+    l = tvm.var('l')
+    A = tvm.placeholder((m, l), name='A')
+    A1 = tvm.compute((m, l), lambda i, j: A[i, j] + 1, name='A1')
+    A2 = tvm.compute((m, l), lambda i, j: A[i, j] * 2, name='A2')
+    A3 = tvm.compute((m, l), lambda i, j: A[i, j] - 1, name='A3')
+    B = tvm.compute((m, l), lambda i, j: A1[i, j] + A2[i, j] + A3[i, j], name='B')
+    s = tvm.create_schedule(B.op)
+    xo, xi = s[B].split(B.op.axis[0], 8)
+    # A1 and A3 request the same domain of B, A2 a different one.
+    s[A1].compute_at(s[B], xo)
+    s[A2].compute_at(s[B], xi)
+    s[A3].compute_at(s[B], xo)
+    bounds = tvm.schedule.InferBound(s)
+    assert isinstance(bounds, tvm.container.Map)
+    assert(bounds[A1.op.axis[0]].extent.value == 8)
+    assert(bounds[A2.op.axis[0]].extent.value == 1)
+    assert(bounds[A3.op.axis[0]].extent.value == 8)
+
 if __name__ == "__main__":
     test_bound_nest_thread()
     test_bound1()
@@ -304,3 +324,4 @@ if __name__ == "__main__":
     test_gemm_bound()
     test_bound_warp()
     test_bound_tensor_compute_op()
+    test_bound_shared_consumer()
@@ -450,6 +450,135 @@ inline tvm::Tensor group_conv2d_ngchw(const tvm::Tensor& I,
   return tvm::compute(output_shape, l, name, tag);
 }
 
+/*!
+ * \brief Creates an operation that performs a 2-D convolution with an
+ * NCHW[x]c-layout, where the channels are split into blocks of x channels
+ *
+ * \param I The 5-D input tensor of shape [batch, ic_chunk, height, width, ic_block]
+ * \param W The 6-D weight tensor of shape
+ * [oc_chunk, ic_chunk, kernel_h, kernel_w, ic_block, oc_block]
+ * \param pad_h A static constant padding amount applied to the height of the
+ * image, before and after (symmetric padding)
+ * \param pad_w A static constant padding amount applied to the width of the
+ * image, before and after (symmetric padding)
+ * \param stride_h A static constant striding amount applied to the height of
+ * the image
+ * \param stride_w A static constant striding amount applied to the width of
+ * the image
+ * \param out_dtype The data type of the output, which is also the accumulation type
+ * \param name The name of the operation
+ * \param tag The tag to mark the operation
+ *
+ * \return A Tensor whose op member is the 2-D convolution operation, of shape
+ * [batch, oc_chunk, out_height, out_width, oc_block]
+ */
+inline tvm::Tensor conv2d_NCHWc(const tvm::Tensor& I,
+                                const tvm::Tensor& W,
+                                int pad_h,
+                                int pad_w,
+                                int stride_h,
+                                int stride_w,
+                                Type out_dtype,
+                                std::string name = "conv2d_NCHWc",
+                                std::string tag = kConv2dNCHWc) {
+  CHECK_EQ(5, I->shape.size());
+  CHECK_EQ(6, W->shape.size());
+  auto ic_bn = I->shape[4];
+  tvm::Array<tvm::Expr> output_shape{
+      I->shape[0],                                             // B
+      W->shape[0],                                             // O chunk
+      (I->shape[2] - W->shape[2] + 2 * pad_h) / stride_h + 1,  // H
+      (I->shape[3] - W->shape[3] + 2 * pad_w) / stride_w + 1,  // W
+      W->shape[5]                                              // O block
+  };
+  auto ic = tvm::reduce_axis(tvm::Range{0, I->shape[1] * ic_bn}, "ic");
+  auto kh = tvm::reduce_axis(tvm::Range{0, W->shape[2]}, "kh");
+  auto kw = tvm::reduce_axis(tvm::Range{0, W->shape[3]}, "kw");
+  auto T = (pad_h == 0 && pad_w == 0)
+               ? I
+               : pad(I, {tvm::Expr(0), tvm::Expr(0), pad_h, pad_w, tvm::Expr(0)},
+                     {tvm::Expr(0), tvm::Expr(0), pad_h, pad_w, tvm::Expr(0)},
+                     Expr(), "data_pad", kInjective);
+  auto l = [&](tvm::Array<tvm::Var> args) {
+    tvm::Var b = args[0];
+    tvm::Var oc_chunk = args[1];
+    tvm::Var h = args[2];
+    tvm::Var w = args[3];
+    tvm::Var oc_block = args[4];
+    return tvm::sum(
+        tvm::cast(out_dtype, T(b, ic / ic_bn, stride_h * h + kh, stride_w * w + kw, ic % ic_bn)) *
+        tvm::cast(out_dtype, W(oc_chunk, ic / ic_bn, kh, kw, ic % ic_bn, oc_block)),
+        {ic, kh, kw});
+  };
+  return tvm::compute(output_shape, l, name, tag);
+}
+
+/*!
+ * \brief Creates an operation that performs a 2-D depthwise convolution with an
+ * NCHW[x]c-layout
+ *
+ * \param I The 5-D input tensor of shape [batch, ic_chunk, height, width, ic_block]
+ * \param W The 4-D weight tensor of shape [oc_chunk, kernel_h, kernel_w, oc_block],
+ * where the number of output channels is a multiple of the number of input channels
+ * \param pad_h A static constant padding amount applied to the height of the
+ * image, before and after (symmetric padding)
+ * \param pad_w A static constant padding amount applied to the width of the
+ * image, before and after (symmetric padding)
+ * \param stride_h A static constant striding amount applied to the height of
+ * the image
+ * \param stride_w A static constant striding amount applied to the width of
+ * the image
+ * \param out_dtype The data type of the output, which is also the accumulation type
+ * \param name The name of the operation
+ * \param tag The tag to mark the operation
+ *
+ * \return A Tensor whose op member is the 2-D depthwise convolution operation,
+ * of shape [batch, oc_chunk, out_height, out_width, oc_block]
+ */
+inline tvm::Tensor depthwise_conv2d_NCHWc(const tvm::Tensor& I,
+                                          const tvm::Tensor& W,
+                                          int pad_h,
+                                          int pad_w,
+                                          int stride_h,
+                                          int stride_w,
+                                          Type out_dtype,
+                                          std::string name = "depthwise_conv2d_NCHWc",
+                                          std::string tag = kDepthwiseConv2dNCHWc) {
+  CHECK_EQ(5, I->shape.size());
+  CHECK_EQ(4, W->shape.size());
+  auto ic_bn = I->shape[4];
+  auto oc_bn = W->shape[3];
+  auto pCM = tvm::ir::Simplify(W->shape[0] * oc_bn / (I->shape[1] * ic_bn));  // channel_multiplier
+  tvm::Array<tvm::Expr> output_shape{
+      I->shape[0],                                             // B
+      W->shape[0],                                             // O chunk
+      (I->shape[2] - W->shape[1] + 2 * pad_h) / stride_h + 1,  // H
+      (I->shape[3] - W->shape[2] + 2 * pad_w) / stride_w + 1,  // W
+      oc_bn                                                    // O block
+  };
+  auto kh = tvm::reduce_axis(tvm::Range{0, W->shape[1]}, "kh");
+  auto kw = tvm::reduce_axis(tvm::Range{0, W->shape[2]}, "kw");
+  auto T = (pad_h == 0 && pad_w == 0)
+               ? I
+               : pad(I, {tvm::Expr(0), tvm::Expr(0), pad_h, pad_w, tvm::Expr(0)},
+                     {tvm::Expr(0), tvm::Expr(0), pad_h, pad_w, tvm::Expr(0)},
+                     Expr(), "data_pad", kInjective);
+  auto l = [&](tvm::Array<tvm::Var> args) {
+    tvm::Var b = args[0];
+    tvm::Var oc_chunk = args[1];
+    tvm::Var h = args[2];
+    tvm::Var w = args[3];
+    tvm::Var oc_block = args[4];
+    // the input channel read by output channel oc
+    auto ic = (oc_chunk * oc_bn + oc_block) / pCM;
+    return tvm::sum(
+        tvm::cast(out_dtype, T(b, ic / ic_bn, stride_h * h + kh, stride_w * w + kw, ic % ic_bn)) *
+        tvm::cast(out_dtype, W(oc_chunk, kh, kw, oc_block)),
+        {kh, kw});
+  };
+  return tvm::compute(output_shape, l, name, tag);
+}
+
 using FLayoutIndicesTransform = std::function<Array<Expr>(const Array<Var>& indices)>;
 
 /*!
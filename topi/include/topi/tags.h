@@ -23,6 +23,8 @@ constexpr auto kDepthwiseConv2dNHWC = "depthwise_conv2d_nhwc";
 constexpr auto kDepthwiseConv2dBackInputNHWC = "depthwise_conv2d_back_input_nhwc";
 constexpr auto kDepthwiseConv2dBackWeightNHWC = "depthwise_conv2d_back_weight_nhwc";
 constexpr auto kGroupConv2d = "group_conv2d";
+constexpr auto kConv2dNCHWc = "conv2d_NCHWc";
+constexpr auto kDepthwiseConv2dNCHWc = "depthwise_conv2d_NCHWc";
 
 inline bool is_broadcast(std::string tag) {
   return
@@ -0,0 +1,352 @@
+/*!
+*  Copyright (c) 2019 by Contributors
+* \file x86/conv2d.h
+* \brief x86 schedules for conv2d and depthwise conv2d in NCHW[x]c layout
+*/
+#ifndef TOPI_X86_CONV2D_H_
+#define TOPI_X86_CONV2D_H_
+
+#include <string>
+
+#include "topi/tags.h"
+#include "topi/detail/array_utils.h"
+#include "topi/detail/constant_utils.h"
+#include "topi/detail/fuse.h"
+#include "tvm/tvm.h"
+#include "tvm/build_module.h"
+
+namespace topi {
+using namespace tvm;
+
+namespace x86 {
+
+/*!
+* \brief Schedule parameters of conv2d in NCHW[x]c layout, which mirror the
+* "tile_ic", "tile_oc", "tile_ow" and "unroll_kw" knobs of the python templates.
+*/
+struct Conv2dNCHWcConfig {
+  /*! \brief Block size of the input channels, the x of the data layout */
+  int ic_bn;
+  /*! \brief Block size of the output channels, the x of the output layout */
+  int oc_bn;
+  /*! \brief Number of output columns computed in registers at once */
+  int reg_n;
+  /*! \brief Whether to unroll the kernel width loop */
+  bool unroll_kw;
+};
+
+/*!
+* \brief Get the number of float32 lanes of a SIMD register on the target,
+* 16 for AVX-512 (-mcpu=skylake-avx512) and 8 for AVX2.
+*
+* \param target The target to generate a schedule for.
+*
+* \return The number of float32 lanes.
+*/
+inline int GetFP32Len(const Target& target) {
+  if (target.defined()) {
+    for (const auto& opt : target->options()) {
+      if (opt == "-mcpu=skylake-avx512") {
+        return 16;
+      }
+    }
+  }
+  return 8;
+}
+
+/*!
+* \brief Get the default schedule parameters of a conv2d workload, which are
+* the same as the fallback config of the python schedules.
+*
+* \param target The target to generate a schedule for.
+* \param in_channel The number of input channels.
+* \param out_channel The number of output channels.
+* \param out_width The width of the output.
+*
+* \return The default config.
+*/
+inline Conv2dNCHWcConfig DefaultConv2dNCHWcConfig(const Target& target,
+                                                  int in_channel,
+                                                  int out_channel,
+                                                  int out_width) {
+  // The largest divisor of n which is no more than max_factor
+  auto largest_factor = [](int n, int max_factor) {
+    for (int bn = max_factor; bn > 1; --bn) {
+      if (n % bn == 0) return bn;
+    }
+    return 1;
+  };
+  Conv2dNCHWcConfig cfg;
+  cfg.oc_bn = largest_factor(out_channel, GetFP32Len(target));
+  cfg.ic_bn = largest_factor(in_channel, cfg.oc_bn);
+  cfg.reg_n = largest_factor(out_width, 31);
+  cfg.unroll_kw = false;
+  return cfg;
+}
+
+/*!
+* \brief Get the default schedule parameters of a conv2d NCHW[x]c output,
+* keeping the channel blocks of its layout.
+*
+* \param target The target to generate a schedule for.
+* \param conv_out The output of conv2d_NCHWc or depthwise_conv2d_NCHWc.
+*
+* \return The default config.
+*/
+inline Conv2dNCHWcConfig DefaultConv2dNCHWcConfig(const Target& target,
+                                                  const Tensor& conv_out) {
+  auto data = conv_out->op->InputTensors()[0];
+  int ic_bn = static_cast<int>(detail::GetConstInt(data->shape[4]));
+  int oc_bn = static_cast<int>(detail::GetConstInt(conv_out->shape[4]));
+  int out_width = static_cast<int>(detail::GetConstInt(conv_out->shape[3]));
+  auto cfg = DefaultConv2dNCHWcConfig(target, ic_bn, oc_bn, out_width);
+  cfg.ic_bn = ic_bn;
+  cfg.oc_bn = oc_bn;
+  return cfg;
+}
+
+/*!
+* \brief Parallelize the padding stage of the data, if any.
+*/
+inline void ScheduleNCHWcData(Schedule s, const Tensor& data) {
+  if (data->op.as<ComputeOpNode>()) {
+    auto axis = s[data]->op.as<ComputeOpNode>()->axis;
+    IterVar fused;
+    s[data].fuse(axis[1], axis[2], &fused);
+    s[data].parallel(fused);
+  }
+}
+
+/*!
+* \brief Schedule the output stage following a conv2d in NCHW[x]c layout, which
+* holds the convolution computed at its outer loop.
+*/
+inline void ScheduleNCHWcOutput(Schedule s, const Tensor& conv, const Tensor& out, int reg_n) {
+  auto axis = s[out]->op.as<ComputeOpNode>()->axis;
+  IterVar ow_chunk, ow_block, fused;
+  s[out].split(axis[3], reg_n, &ow_chunk, &ow_block);
+  s[out].reorder({ axis[1], axis[2], ow_chunk, ow_block, axis[4] });
+  s[out].fuse(axis[1], axis[2], &fused);
+  s[conv].compute_at(s[out], fused);
+  s[out].vectorize(axis[4]);
+  s[out].parallel(fused);
+}
+
+/*!
+* \brief Create an x86 schedule for conv2d in NCHW[x]c layout. The output
+* channel block is vectorized, so that an AVX2 or AVX-512 register holds a block
+* when oc_bn is the number of float32 lanes of the target.
+*
+* \param target The target to generate a schedule for.
+* \param outs The output tensors.
+* \param cfg The schedule parameters. ic_bn and oc_bn are given by the layouts
+* of the tensors and are ignored here.
+*
+* \return A schedule for the given ops.
+*/
+inline Schedule schedule_conv2d_NCHWc_with_config(const Target &target,
+                                                  const Array<Tensor>& outs,
+                                                  const Conv2dNCHWcConfig& cfg) {
+  Array<Operation> out_ops;
+  for (auto t : outs) {
+    out_ops.push_back(t->op);
+  }
+  auto s = create_schedule(out_ops);
+
+  auto _schedule = [&](const Tensor& data, const Tensor& conv_out, const Tensor& last) {
+    int ic_bn = static_cast<int>(detail::GetConstInt(data->shape[4]));
+    ScheduleNCHWcData(s, data);
+
+    auto C = conv_out;
+    auto CC = s.cache_write(C, "global");
+
+    auto c_axis = s[C]->op.as<ComputeOpNode>()->axis;
+    IterVar ow_chunk, ow_block, fused;
+    s[C].split(c_axis[3], cfg.reg_n, &ow_chunk, &ow_block);
+    s[C].reorder({ c_axis[1], c_axis[2], ow_chunk, ow_block, c_axis[4] });
+    s[C].fuse(c_axis[1], c_axis[2], &fused);
+    s[C].vectorize(c_axis[4]);
+    if (C->op.same_as(last->op)) {
+      s[C].parallel(fused);
+    }
+    s[CC].compute_at(s[C], ow_chunk);
+
+    auto cc_axis = s[CC]->op.as<ComputeOpNode>()->axis;
+    auto cc_reduce = s[CC]->op.as<ComputeOpNode>()->reduce_axis;
+    auto ic = cc_reduce[0];
+    auto kh = cc_reduce[1];
+    auto kw = cc_reduce[2];
+    IterVar cc_ow_chunk, cc_ow_block, ic_chunk, ic_block;
+    s[CC].split(cc_axis[3], cfg.reg_n, &cc_ow_chunk, &cc_ow_block);
+    s[CC].split(ic, ic_bn, &ic_chunk, &ic_block);
+    if (cfg.unroll_kw) {
+      s[CC].reorder({ cc_axis[1], cc_axis[2], cc_ow_chunk, ic_chunk, kh, ic_block, kw,
+                      cc_ow_block, cc_axis[4] });
+      s[CC].unroll(kw);
+    } else {
+      s[CC].reorder({ cc_axis[1], cc_axis[2], cc_ow_chunk, ic_chunk, kh, kw, ic_block,
+                      cc_ow_block, cc_axis[4] });
+    }
+    s[CC].vectorize(cc_axis[4]);
+    s[CC].unroll(cc_ow_block);
+
+    if (!C->op.same_as(last->op)) {
+      ScheduleNCHWcOutput(s, C, last, cfg.reg_n);
+    }
+  };
+
+  std::function<void(Operation)> traverse;
+  traverse = [&](const Operation& op) {
+    // Inline all one-to-one-mapping operators except the last stage (output)
+    if (is_broadcast(op->tag)) {
+      if (!detail::contains(s->outputs, op)) {
+        s[op].compute_inline();
+      }
+      for (auto tensor : op->InputTensors()) {
+        if (tensor->op->InputTensors().size() > 0) {
+          traverse(tensor->op);
+        }
+      }
+    } else if (op->tag == kConv2dNCHWc) {
+      auto conv_out = op.output(0);
+      auto data = op->InputTensors()[0];
+      _schedule(data, conv_out, outs[0]);
+    } else {
+      LOG(ERROR) << "Unsupported operator " << op->tag;
+    }
+  };
+
+  traverse(outs[0]->op);
+  return s;
+}
+
+/*!
+* \brief Create an x86 schedule for conv2d in NCHW[x]c layout with the default
+* config of the workload.
+*
+* \param target The target to generate a schedule for.
+* \param outs The output tensors.
+*
+* \return A schedule for the given ops.
+*/
+inline Schedule schedule_conv2d_NCHWc(const Target &target, const Array<Tensor>& outs) {
+  Tensor conv_out;
+  std::function<void(const Tensor&)> find_conv;
+  find_conv = [&](const Tensor& t) {
+    if (t->op->tag == kConv2dNCHWc) {
+      conv_out = t;
+    } else if (is_broadcast(t->op->tag)) {
+      for (auto tensor : t->op->InputTensors()) {
+        if (!conv_out.defined()) find_conv(tensor);
+      }
+    }
+  };
+  find_conv(outs[0]);
+  CHECK(conv_out.defined()) << "Cannot find conv2d_NCHWc in " << outs[0]->op->name;
+  return schedule_conv2d_NCHWc_with_config(target, outs,
+                                           DefaultConv2dNCHWcConfig(target, conv_out));
+}
+
+/*!
+* \brief Create an x86 schedule for depthwise conv2d in NCHW[x]c layout. Only
+* reg_n of the config is used.
+*
+* \param target The target to generate a schedule for.
+* \param outs The output tensors.
+* \param cfg The schedule parameters.
+*
+* \return A schedule for the given ops.
+*/
+inline Schedule schedule_depthwise_conv2d_NCHWc_with_config(const Target &target,
+                                                            const Array<Tensor>& outs,
+                                                            const Conv2dNCHWcConfig& cfg) {
+  Array<Operation> out_ops;
+  for (auto t : outs) {
+    out_ops.push_back(t->op);
+  }
+  auto s = create_schedule(out_ops);
+
+  auto _schedule = [&](const Tensor& data, const Tensor& conv_out, const Tensor& last) {
+    ScheduleNCHWcData(s, data);
+
+    auto C = conv_out;
+    auto CC = s.cache_write(C, "global");
+
+    auto c_axis = s[C]->op.as<ComputeOpNode>()->axis;
+    IterVar ow_chunk, ow_block, fused;
+    s[C].split(c_axis[3], cfg.reg_n, &ow_chunk, &ow_block);
+    s[C].reorder({ c_axis[1], c_axis[2], ow_chunk, ow_block, c_axis[4] });
+    s[C].fuse(c_axis[1], c_axis[2], &fused);
+    s[C].parallel(fused);
+    s[CC].compute_at(s[C], ow_chunk);
+
+    auto cc_axis = s[CC]->op.as<ComputeOpNode>()->axis;
+    auto cc_reduce = s[CC]->op.as<ComputeOpNode>()->reduce_axis;
+    IterVar cc_ow_chunk, cc_ow_block;
+    s[CC].split(cc_axis[3], cfg.reg_n, &cc_ow_chunk, &cc_ow_block);
+    s[CC].reorder({ cc_axis[1], cc_axis[2], cc_reduce[0], cc_reduce[1],
+                    cc_ow_block, cc_axis[4] });
+    s[CC].vectorize(cc_axis[4]);
+    s[CC].unroll(cc_ow_block);
+
+    if (!C->op.same_as(last->op)) {
+      ScheduleNCHWcOutput(s, C, last, cfg.reg_n);
+    }
+  };
+
+  std::function<void(Operation)> traverse;
+  traverse = [&](const Operation& op) {
+    // Inline all one-to-one-mapping operators except the last stage (output)
+    if (is_broadcast(op->tag)) {
+      if (!detail::contains(s->outputs, op)) {
+        s[op].compute_inline();
+      }
+      for (auto tensor : op->InputTensors()) {
+        if (tensor->op->InputTensors().size() > 0) {
+          traverse(tensor->op);
+        }
+      }
+    } else if (op->tag == kDepthwiseConv2dNCHWc) {
+      auto conv_out = op.output(0);
+      auto data = op->InputTensors()[0];
+      _schedule(data, conv_out, outs[0]);
+    } else {
+      LOG(ERROR) << "Unsupported operator " << op->tag;
+    }
+  };
+
+  traverse(outs[0]->op);
+  return s;
+}
+
+/*!
+* \brief Create an x86 schedule for depthwise conv2d in NCHW[x]c layout with the
+* default config of the workload.
+*
+* \param target The target to generate a schedule for.
+* \param outs The output tensors.
+*
+* \return A schedule for the given ops.
+*/
+inline Schedule schedule_depthwise_conv2d_NCHWc(const Target &target,
+                                                const Array<Tensor>& outs) {
+  Tensor conv_out;
+  std::function<void(const Tensor&)> find_conv;
+  find_conv = [&](const Tensor& t) {
+    if (t->op->tag == kDepthwiseConv2dNCHWc) {
+      conv_out = t;
+    } else if (is_broadcast(t->op->tag)) {
+      for (auto tensor : t->op->InputTensors()) {
+        if (!conv_out.defined()) find_conv(tensor);
+      }
+    }
+  };
+  find_conv(outs[0]);
+  CHECK(conv_out.defined()) << "Cannot find depthwise_conv2d_NCHWc in " << outs[0]->op->name;
+  return schedule_depthwise_conv2d_NCHWc_with_config(target, outs,
+                                                     DefaultConv2dNCHWcConfig(target, conv_out));
+}
+
+}  // namespace x86
+}  // namespace topi
+#endif  // TOPI_X86_CONV2D_H_
@@ -17,3 +17,5 @@ from .upsampling import *
 from .local_response_norm import *
 from .bitserial_conv2d import *
 from .l2_normalize import *
+from .batch_matmul import *
+from .sparse import *
@@ -0,0 +1,70 @@
+"""Sparse operators"""
+# pylint: disable=invalid-name
+from __future__ import absolute_import as _abs
+import tvm
+from ..util import get_const_tuple
+
+
+def _sparse_dense_csrmm(data, weight_data, weight_indices, weight_indptr):
+    oshape = (data.shape[0], get_const_tuple(weight_indptr.shape)[0] - 1)
+
+    def f(i, row):
+        row_start = weight_indptr[row]
+        row_end = weight_indptr[row + 1]
+        elem_idx = tvm.reduce_axis((0, row_end - row_start), name="elem_idx")
+        elem = row_start + elem_idx
+        return tvm.sum(weight_data[elem] * data[i, weight_indices[elem]], axis=elem_idx)
+    return tvm.compute(oshape, f, tag="sparse_dense_csrmm")
+
+
+def _sparse_dense_bsrmm(data, weight_data, weight_indices, weight_indptr):
+    m = data.shape[0]
+    _, bs_r, bs_c = get_const_tuple(weight_data.shape)
+    num_blocks = get_const_tuple(weight_indptr.shape)[0] - 1
+
+    def f(i, nb_j, j):
+        row_start = weight_indptr[nb_j]
+        row_end = weight_indptr[nb_j + 1]
+        elem_idx = tvm.reduce_axis((0, row_end - row_start), name="elem_idx")
+        c = tvm.reduce_axis((0, bs_c), name="c")
+        block_offset = row_start + elem_idx
+        block_j = weight_indices[block_offset]
+        return tvm.sum(weight_data[block_offset, j, c] * data[i, bs_c * block_j + c],
+                       axis=[elem_idx, c])
+    bsrmm_block = tvm.compute((m, num_blocks, bs_r), f, tag="sparse_dense_bsrmm_block")
+    return tvm.compute((m, num_blocks * bs_r),
+                       lambda i, n: bsrmm_block[i, n // bs_r, n % bs_r],
+                       tag="sparse_dense_bsrmm")
+
+
+@tvm.target.generic_func
+def sparse_dense(data, weight_data, weight_indices, weight_indptr):
+    """Computes :math:`Y = XW^T` where the weight W is a sparse matrix in CSR
+    or BSR (block compressed sparse row) format.
+
+    Parameters
+    ----------
+    data : tvm.Tensor
+        2-D with shape [M, K], M may be symbolic
+
+    weight_data : tvm.Tensor
+        1-D with shape [nnz] (CSR) or
+        3-D with shape [num_blocks, bs_r, bs_c] (BSR)
+
+    weight_indices : tvm.Tensor
+        1-D with shape [nnz] (CSR) or
+        1-D with shape [num_blocks] (BSR), the column (block column) of each element
+
+    weight_indptr : tvm.Tensor
+        1-D with shape [N + 1] (CSR) or
+        1-D with shape [N / bs_r + 1] (BSR)
+
+    Returns
+    -------
+    output : tvm.Tensor
+        2-D with shape [M, N]
+    """
+    assert len(weight_data.shape) in (1, 3)
+    if len(weight_data.shape) == 1:
+        return _sparse_dense_csrmm(data, weight_data, weight_indices, weight_indptr)
+    return _sparse_dense_bsrmm(data, weight_data, weight_indices, weight_indptr)
@@ -0,0 +1,56 @@
+# pylint: disable=invalid-name, too-many-arguments, too-many-nested-blocks
+"""Non-maximum suppression in python"""
+import numpy as np
+
+def nms_python(data, valid_count, nms_threshold, force_suppress, nms_topk):
+    """Non-maximum suppression in python, box by box in score order.
+
+    Parameters
+    ----------
+    data : numpy.ndarray
+        3-D with shape [batch_size, num_anchors, 6], each box in format of
+        [class_id, score, box_left, box_top, box_right, box_bottom].
+
+    valid_count : numpy.ndarray
+        1-D with shape [batch_size], the number of valid boxes.
+
+    nms_threshold : float
+        Non-maximum suppression threshold.
+
+    force_suppress : boolean
+        Whether to suppress all detections regardless of class_id.
+
+    nms_topk : int
+        Keep maximum top k detections before nms, -1 for no limit.
+
+    Returns
+    -------
+    out : numpy.ndarray
+        3-D with shape [batch_size, num_anchors, 6]
+    """
+    out = np.full_like(data, -1)
+    for n in range(data.shape[0]):
+        valid = valid_count[n]
+        if not 0 < nms_threshold < 1:
+            out[n, :valid] = data[n, :valid]
+            continue
+        # descending stable sort of the valid scores
+        order = np.argsort(-data[n, :valid, 1], kind="mergesort")
+        nkeep = min(nms_topk, valid) if nms_topk > 0 else valid
+        out[n, :nkeep] = data[n, order[:nkeep]]
+        out[n, nkeep:valid] = data[n, nkeep:valid]
+        area = (out[n, :, 4] - out[n, :, 2]) * (out[n, :, 5] - out[n, :, 3])
+        for l in range(valid):
+            if out[n, l, 0] < 0:
+                continue
+            for m in range(l + 1, valid):
+                if out[n, m, 0] < 0 or \
+                        (not force_suppress and out[n, l, 0] != out[n, m, 0]):
+                    continue
+                w = max(0, min(out[n, l, 4], out[n, m, 4]) - max(out[n, l, 2], out[n, m, 2]))
+                h = max(0, min(out[n, l, 5], out[n, m, 5]) - max(out[n, l, 3], out[n, m, 3]))
+                i = w * h
+                u = area[l] + area[m] - i
+                if u > 0 and i / u >= np.float32(nms_threshold):
+                    out[n, m, 0] = -1
+    return out
@@ -1,12 +1,25 @@
-# pylint: disable=invalid-name, no-member, too-many-locals, too-many-arguments
+# pylint: disable=invalid-name, no-member, too-many-locals, too-many-arguments, too-many-statements
 """Non-maximum suppression operator"""
 import tvm
 
 from tvm import api
 
+# Boxes of different classes never suppress each other, so unless force_suppress
+# is set, the boxes of a batch are split by class_id % NUM_CLASS_GROUPS into
+# groups which are suppressed in parallel.
+NUM_CLASS_GROUPS = 8
+# The IoU of a kept box is computed with this many candidates at a time.
+VECTOR_LANES = 8
+
 def nms_ir(data, sort_result, valid_count, out, nms_threshold, force_suppress, nms_topk):
     """Low level IR routing for transform location in multibox_detection operator.
 
+    The boxes are first reordered by score in parallel over the batches. Then
+    every group of classes of every batch is suppressed in parallel: the boxes
+    of the group are gathered in score order into separate coordinate arrays,
+    and each kept box suppresses the following candidates VECTOR_LANES boxes at
+    a time. Suppressed boxes are skipped.
+
     Parameters
     ----------
     data: Buffer
@@ -35,20 +48,6 @@ def nms_ir(data, sort_result, valid_count, out, nms_threshold, force_suppress, n
     stmt : Stmt
         The result IR statement.
     """
-    def calculate_overlap(out_tensor, box_a_idx, box_b_idx):
-        """Calculate overlap of two boxes.
-        """
-        w = tvm.make.Max(0.0, tvm.make.Min(out_tensor[box_a_idx + 2], out_tensor[box_b_idx + 2])
-                         - tvm.make.Max(out_tensor[box_a_idx], out_tensor[box_b_idx]))
-        h = tvm.make.Max(0.0, tvm.make.Min(out_tensor[box_a_idx + 3], out_tensor[box_b_idx + 3])
-                         - tvm.make.Max(out_tensor[box_a_idx + 1], out_tensor[box_b_idx + 1]))
-        i = w * h
-        u = (out_tensor[box_a_idx + 2] - out_tensor[box_a_idx]) * \
-            (out_tensor[box_a_idx + 3] - out_tensor[box_a_idx + 1]) + \
-            (out_tensor[box_b_idx + 2] - out_tensor[box_b_idx]) * \
-            (out_tensor[box_b_idx + 3] - out_tensor[box_b_idx + 1]) - i
-        return tvm.expr.Select(u <= 0.0, 0.0, i / u)
-
     ib = tvm.ir_builder.create()
     p_data = ib.buffer_ptr(data)
     p_sort_result = ib.buffer_ptr(sort_result)
@@ -57,52 +56,114 @@ def nms_ir(data, sort_result, valid_count, out, nms_threshold, force_suppress, n
     batch_size = out.shape[0]
     num_anchors = out.shape[1]
 
-    nms_threshold_node = tvm.make.node("FloatImm", dtype="float32", value=nms_threshold)
-    nms_topk_node = tvm.make.node("IntImm", dtype="int32", value=nms_topk)
-    force_suppress_node = tvm.make.node("IntImm", dtype="int32", value=1 if force_suppress else 0)
+    lanes = VECTOR_LANES
+    num_groups = 1 if force_suppress else NUM_CLASS_GROUPS
+    # every group starts at a multiple of lanes, so its vectors stay within it
+    group_buf_len = ((num_anchors + lanes - 1) // lanes + num_groups) * lanes
+    group_begin = ib.allocate("int32", (batch_size * num_groups,), name="group_begin",
+                              scope="global")
+    box_x1 = ib.allocate("float32", (batch_size * group_buf_len,), name="box_x1",
+                         scope="global")
+    box_y1 = ib.allocate("float32", (batch_size * group_buf_len,), name="box_y1",
+                         scope="global")
+    box_x2 = ib.allocate("float32", (batch_size * group_buf_len,), name="box_x2",
+                         scope="global")
+    box_y2 = ib.allocate("float32", (batch_size * group_buf_len,), name="box_y2",
+                         scope="global")
+    box_area = ib.allocate("float32", (batch_size * group_buf_len,), name="box_area",
+                           scope="global")
+    box_cls = ib.allocate("float32", (batch_size * group_buf_len,), name="box_cls",
+                          scope="global")
+    box_idx = ib.allocate("int32", (batch_size * group_buf_len,), name="box_idx",
+                          scope="global")
+
+    def group_of(class_id):
+        return class_id.astype("int32") % num_groups
+
+    apply_nms = 0 < nms_threshold < 1
+
     with ib.for_range(0, batch_size, for_type="parallel", name="n") as n:
-        with ib.if_scope(tvm.all(nms_threshold_node > 0, nms_threshold_node < 1,
-                                 p_valid_count[0] > 0)):
+        base = n * num_anchors * 6
+        if apply_nms:
             # Reorder output
-            nkeep = tvm.if_then_else(
-                tvm.all(nms_topk_node > 0, nms_topk < p_valid_count[n]),
-                nms_topk, p_valid_count[n])
+            nkeep = tvm.min(nms_topk, p_valid_count[n]) if nms_topk > 0 else p_valid_count[n]
             with ib.for_range(0, nkeep, name="l") as l:
                 with ib.for_range(0, 6, name="m") as m:
-                    p_out[(n * num_anchors * 6
-                           + l * 6 + m)] = p_data[(n * num_anchors * 6
-                                                   + p_sort_result[n * num_anchors + l] * 6 + m)]
-            with ib.if_scope(tvm.all(nms_topk_node > 0, nms_topk < p_valid_count[n])):
-                with ib.for_range(0, p_valid_count[n] - nkeep, name="l") as l:
-                    with ib.for_range(0, 6, name="m") as m:
-                        p_out[(n * num_anchors * 6
-                               + (l + nkeep) * 6 + m)] = p_data[(n * num_anchors * 6
-                                                                 + (l + nkeep) * 6 + m)]
-            # Apply nms
+                    p_out[base + l * 6 + m] = \
+                        p_data[base + p_sort_result[n * num_anchors + l] * 6 + m]
+            with ib.for_range(nkeep, p_valid_count[n], name="l") as l:
+                with ib.for_range(0, 6, name="m") as m:
+                    p_out[base + l * 6 + m] = p_data[base + l * 6 + m]
+            # Count the boxes of each group to place the groups
+            with ib.for_range(0, num_groups, name="g") as g:
+                group_begin[n * num_groups + g] = 0
             with ib.for_range(0, p_valid_count[n], name="l") as l:
-                offset_l = l * 6
-                with ib.if_scope(p_out[n * num_anchors * 6 + offset_l] >= 0):
-                    with ib.for_range(0, p_valid_count[n], name="m") as m:
-                        offset_m = m * 6
-                        with ib.if_scope(tvm.all(m > l, p_out[n * num_anchors * 6
-                                                              + offset_m] >= 0)):
-                            with ib.if_scope(tvm.any(force_suppress_node > 0,
-                                                     p_out[n * num_anchors * 6 + offset_l] ==
-                                                     p_out[n * num_anchors * 6 + offset_m])):
-                                # When force_suppress == True or class_id equals
-                                iou = calculate_overlap(p_out, n * num_anchors * 6 + offset_l + 2,
-                                                        n * num_anchors * 6 + offset_m + 2)
-                                with ib.if_scope(iou >= nms_threshold):
-                                    p_out[n * num_anchors * 6 + offset_m] = -1.0
-        with ib.else_scope():
+                class_id = p_out[base + l * 6]
+                with ib.if_scope(class_id >= 0):
+                    group_begin[n * num_groups + group_of(class_id)] += 1
+            offset = ib.allocate("int32", (1,), name="offset", scope="local")
+            offset[0] = n * group_buf_len
+            with ib.for_range(0, num_groups, name="g") as g:
+                count = group_begin[n * num_groups + g]
+                group_begin[n * num_groups + g] = offset[0]
+                offset[0] += (count + lanes - 1) // lanes * lanes
+        else:
             with ib.for_range(0, p_valid_count[n], name="l") as l:
                 with ib.for_range(0, 6, name="m") as m:
-                    p_out[(n * num_anchors * 6
-                           + l * 6 + m)] = p_data[n * num_anchors * 6 + l * 6 + m]
+                    p_out[base + l * 6 + m] = p_data[base + l * 6 + m]
         # Set invalid entry to be -1
         with ib.for_range(0, num_anchors - p_valid_count[n], name="l") as l:
             with ib.for_range(0, 6, name="m") as m:
-                p_out[n * num_anchors * 6 + (l + p_valid_count[n]) * 6 + m] = -1.0
+                p_out[base + (l + p_valid_count[n]) * 6 + m] = -1.0
+
+    if not apply_nms:
+        return ib.get()
+
+    with ib.for_range(0, batch_size * num_groups, for_type="parallel", name="t") as t:
+        n = t // num_groups
+        base = n * num_anchors * 6
+        begin = group_begin[t]
+        # Gather the boxes of the group in score order
+        count = ib.allocate("int32", (1,), name="count", scope="local")
+        count[0] = 0
+        with ib.for_range(0, p_valid_count[n], name="l") as l:
+            class_id = p_out[base + l * 6]
+            with ib.if_scope(tvm.all(class_id >= 0, group_of(class_id) == t % num_groups)):
+                j = begin + count[0]
+                box_x1[j] = p_out[base + l * 6 + 2]
+                box_y1[j] = p_out[base + l * 6 + 3]
+                box_x2[j] = p_out[base + l * 6 + 4]
+                box_y2[j] = p_out[base + l * 6 + 5]
+                box_area[j] = (box_x2[j] - box_x1[j]) * (box_y2[j] - box_y1[j])
+                box_cls[j] = class_id
+                box_idx[j] = l
+                count[0] += 1
+        # Apply nms, each kept box suppresses the overlapping boxes after it
+        num_boxes = count[0]
+        with ib.for_range(0, num_boxes, name="l") as l:
+            a = begin + l
+            with ib.if_scope(box_cls[a] >= 0):
+                with ib.for_range((l + 1) // lanes, (num_boxes + lanes - 1) // lanes,
+                                  name="mo") as mo:
+                    with ib.for_range(0, lanes, for_type="vectorize", name="mi") as mi:
+                        m = mo * lanes + mi
+                        b = begin + m
+                        w = tvm.max(0.0, tvm.min(box_x2[a], box_x2[b]) -
+                                    tvm.max(box_x1[a], box_x1[b]))
+                        h = tvm.max(0.0, tvm.min(box_y2[a], box_y2[b]) -
+                                    tvm.max(box_y1[a], box_y1[b]))
+                        i = w * h
+                        u = box_area[a] + box_area[b] - i
+                        iou = tvm.expr.Select(u <= 0.0, 0.0, i / u)
+                        suppress = tvm.all(m > l, m < num_boxes, box_cls[b] >= 0,
+                                           iou >= nms_threshold)
+                        if not force_suppress:
+                            suppress = tvm.all(suppress, box_cls[a] == box_cls[b])
+                        box_cls[b] = tvm.expr.Select(suppress, -1.0, box_cls[b])
+        # Scatter the suppressed boxes back
+        with ib.for_range(0, num_boxes, name="l") as l:
+            with ib.if_scope(box_cls[begin + l] < 0):
+                p_out[base + box_idx[begin + l] * 6] = -1.0
     return ib.get()
 
 
@@ -3,10 +3,14 @@
 from __future__ import absolute_import as _abs
 
 from .conv2d import schedule_conv2d, schedule_conv2d_nhwc
+from . import conv2d_winograd
 from .binarize_pack import schedule_binarize_pack
 from .binary_dense import schedule_binary_dense
 from .nn import *
 from .injective import *
+from .reduction import schedule_reduce
 from .pooling import schedule_pool, schedule_global_pool
 from .bitserial_conv2d import schedule_bitserial_conv2d
 from .depthwise_conv2d import schedule_depthwise_conv2d_NCHWc
+from . import batch_matmul
+from .sparse import schedule_sparse_dense
@@ -0,0 +1,132 @@
+# pylint: disable=invalid-name,too-many-locals,unused-variable
+"""x86 batch_matmul operators"""
+from __future__ import absolute_import as _abs
+import tvm
+from tvm import autotvm
+from tvm.contrib import cblas
+
+from .nn import _default_dense_pack_config
+from .. import generic, nn
+from ..util import traverse_inline, get_const_tuple
+
+
+@autotvm.register_topi_compute(nn.batch_matmul, "cpu", "direct")
+def _declaration_batch_matmul(cfg, x, y):
+    """Computes batch matrix multiplication of `x` and `y` when `x` and `y` are
+    data in batch.
+
+    y is packed into [batch, N // bn, K, bn] with bn the innermost tile of the
+    columns, so the rows of a block of bn output columns are contiguous, as in
+    the packed x86 dense.
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        Autotvm tuning space config file
+
+    x: tvm.Tensor
+        3-D with shape [batch, M, K]
+
+    y: tvm.Tensor
+        3-D with shape [batch, N, K]
+
+    Returns
+    -------
+    output: tvm.Tensor
+        3-D with shape [batch, M, N]
+    """
+    target = tvm.target.current_target()
+    if "cblas" in target.libs:
+        return cblas.batch_matmul(x, y, False, True)
+
+    assert len(x.shape) == 3 and len(y.shape) == 3, "only support 3-dim batch_matmul"
+    XB, M, XK = get_const_tuple(x.shape)
+    YB, N, YK = get_const_tuple(y.shape)
+    assert XB == YB, "batch dimension doesn't match"
+    assert XK == YK, "shapes of x and y is inconsistant"
+    batch, K = XB, XK
+    # create tuning space
+    cfg.define_split("tile_y", M, num_outputs=3)
+    cfg.define_split("tile_x", N, num_outputs=3)
+    cfg.define_split("tile_k", K, num_outputs=2)
+    if cfg.is_fallback:
+        _default_dense_pack_config(cfg, M, N, K)
+
+    packy_bn = cfg["tile_x"].size[-1]
+    packy_shape = (batch, N // packy_bn, K, packy_bn)
+    packy = tvm.compute(packy_shape,
+                        lambda b, z, k, j: y[b, z * packy_bn + j, k], name="packed_y")
+
+    k = tvm.reduce_axis((0, K), name="k")
+    return tvm.compute((batch, M, N),
+                       lambda b, i, j: tvm.sum(
+                           x[b, i, k] * packy[b, j // packy_bn, k, j % packy_bn],
+                           axis=k),
+                       tag="batch_matmul_pack")
+
+
+@autotvm.register_topi_schedule(generic.schedule_batch_matmul, "cpu", "direct")
+def _schedule_batch_matmul(cfg, outs):
+    """Schedule for batch_matmul
+
+    Parameters
+    ----------
+    cfg : ConfigSpace
+        Autotvm tuning space config file
+
+    outs: Array of Tensor
+          The computation graph description of batch_matmul
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    target = tvm.target.current_target()
+    if "cblas" in target.libs:
+        return generic.schedule_extern(outs)
+
+    outs = [outs] if isinstance(outs, tvm.tensor.Tensor) else outs
+    s = tvm.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if "batch_matmul_pack" in op.tag:
+            _schedule_batch_matmul_pack_template(cfg, s, op.output(0), outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+def _schedule_batch_matmul_pack_template(cfg, s, C, O):
+    A, packedB = s[C].op.input_tensors
+
+    # the outer tiles of every batch are the parallel blocks, sized for L2,
+    # and a tile_k chunk of a packed column block stays in L1 for a middle tile
+    CC = s.cache_write(C, "global")
+    b, y, x = s[O].op.axis
+    yt, yo, yi = cfg["tile_y"].apply(s, O, y)
+    xt, xo, xi = cfg["tile_x"].apply(s, O, x)
+    s[O].reorder(b, yt, xt, yo, xo, yi, xi)
+    bxyt = s[O].fuse(b, yt, xt)
+    s[O].parallel(bxyt)
+    xyo = s[O].fuse(yo, xo)
+    s[O].unroll(yi)
+    s[O].vectorize(xi)
+
+    s[CC].compute_at(s[O], xyo)
+    _, y, x = s[CC].op.axis
+    k, = s[CC].op.reduce_axis
+    ko, ki = cfg["tile_k"].apply(s, CC, k)
+    s[CC].reorder(ko, ki, y, x)
+    s[CC].vectorize(x)
+    s[CC].unroll(y)
+    s[CC].unroll(ki)
+    if C != O:
+        s[C].compute_inline()
+
+    b, z, k, x = s[packedB].op.axis
+    bz = s[packedB].fuse(b, z)
+    s[packedB].parallel(bz)
+    s[packedB].vectorize(x)
+    return s
@@ -13,8 +13,9 @@ from ..nn.conv2d import conv2d, conv2d_NCHWc, \
 from ..nn.depthwise_conv2d import _get_workload as _get_depthwise_conv2d_workload
 from ..nn.depthwise_conv2d import depthwise_conv2d_NCHWc, depthwise_conv2d_nchw
 from ..nn.pad import pad
+from ..nn import conv2d_winograd_without_weight_transform
 
-from . import conv2d_avx_1x1, conv2d_avx_common
+from . import conv2d_avx_1x1, conv2d_avx_common, conv2d_winograd
 
 def _get_default_config(cfg, data, kernel, strides, padding, out_dtype, is_depthwise=False):
     """
@@ -319,6 +320,12 @@ def _alter_conv2d_layout(attrs, inputs, tinfo, F):
         autotvm.task.args_to_workload(
             [data, kernel, strides, padding, dilation, layout, out_dtype], conv2d)
     cfg = dispatch_ctx.query(target, workload)
+    # only switch to winograd with a tuned config, the untuned
+    # winograd schedule is not known to beat the direct one.
+    if not is_depthwise and not cfg.is_fallback and cfg.template_key == 'winograd':
+        return _alter_conv2d_layout_winograd(cfg, new_attrs, copy_inputs, data, kernel,
+                                             strides, padding, dilation, layout_name,
+                                             out_dtype, F)
     if cfg.is_fallback:
         _get_default_config(cfg, data, kernel, strides, padding, out_dtype, is_depthwise)
 
@@ -474,3 +481,36 @@ def _schedule_conv2d_NCHWc(cfg, outs):
 
     traverse(outs[0].op)
     return s
+
+
+def _alter_conv2d_layout_winograd(cfg, new_attrs, copy_inputs, data, kernel, strides, padding,
+                                  dilation, layout_name, out_dtype, F):
+    """Pre-compute the kernel transformation of winograd, so that it is folded
+    into the params at compile time."""
+    batch_size, in_channel, height, width = get_const_tuple(data.shape)
+    out_channel, _, kh, kw = get_const_tuple(kernel.shape)
+    out_height = height + 2 * padding[0] - kh + 1
+    out_width = width + 2 * padding[1] - kw + 1
+    tile_size = conv2d_winograd.pick_tile_size(out_height, out_width)
+    if cfg.is_fallback:
+        num_tiles = batch_size * ((out_height + tile_size - 1) // tile_size) * \
+                    ((out_width + tile_size - 1) // tile_size)
+        conv2d_winograd.fallback_schedule(cfg, out_channel, num_tiles, in_channel)
+    VK = cfg['tile_k'].size[-1]
+
+    # (oc, ic, h, w) -> (alpha, alpha, OC, ic, oc)
+    weight = F.nn.contrib_conv2d_winograd_weight_transform(copy_inputs[1], tile_size=tile_size)
+    weight = F.reshape(weight, newshape=(kh + tile_size - 1, kw + tile_size - 1,
+                                         out_channel // VK, VK, in_channel))
+    weight = F.transpose(weight, axes=[0, 1, 2, 4, 3])
+    copy_inputs[1] = weight
+    new_attrs['tile_size'] = tile_size
+
+    # Store the same config for the altered operator (workload)
+    new_weight = tvm.placeholder((kh + tile_size - 1, kw + tile_size - 1, out_channel // VK,
+                                  in_channel, VK), kernel.dtype)
+    new_workload = autotvm.task.args_to_workload(
+        [data, new_weight, strides, padding, dilation, new_attrs[layout_name], out_dtype,
+         tile_size], conv2d_winograd_without_weight_transform)
+    autotvm.task.DispatchContext.current.update(tvm.target.current_target(), new_workload, cfg)
+    return F.nn.contrib_conv2d_winograd_without_weight_transform(*copy_inputs, **new_attrs)
@@ -0,0 +1,313 @@
+# pylint: disable=invalid-name,unused-variable,unused-argument,no-member
+"""Winograd conv2d schedule on x86"""
+from __future__ import absolute_import as _abs
+
+import numpy as np
+
+import tvm
+from tvm import autotvm
+from tvm.autotvm.task.space import SplitEntity
+
+from .. import generic
+from ..util import traverse_inline, get_const_tuple, const_matrix
+from ..nn import pad, conv2d, conv2d_winograd_without_weight_transform
+from ..nn.util import get_pad_tuple
+from .util import get_fp32_len
+
+
+def _winograd_matrices(tile_size, out_dtype):
+    """Get the transform matrices (A, B, G) of F(m x m, 3 x 3) with m = tile_size"""
+    if tile_size == 4:
+        G_data = np.array([
+            [1 / 4.0, 0, 0],
+            [-1 / 6.0, -1 / 6.0, -1 / 6.0],
+            [-1 / 6.0, 1 / 6.0, -1 / 6.0],
+            [1 / 24.0, 1 / 12.0, 1 / 6.0],
+            [1 / 24.0, -1 / 12.0, 1 / 6.0],
+            [0, 0, 1]], dtype=np.float32)
+
+        B_data = np.array([
+            [4, 0, 0, 0, 0, 0],
+            [0, -4, 4, -2, 2, 4],
+            [-5, -4, -4, -1, -1, 0],
+            [0, 1, -1, 2, -2, -5],
+            [1, 1, 1, 1, 1, 0],
+            [0, 0, 0, 0, 0, 1]], out_dtype)
+
+        A_data = np.array([
+            [1, 0, 0, 0],
+            [1, 1, 1, 1],
+            [1, -1, 1, -1],
+            [1, 2, 4, 8],
+            [1, -2, 4, -8],
+            [0, 0, 0, 1]], out_dtype)
+    elif tile_size == 2:
+        G_data = np.array([
+            [1, 0, 0],
+            [1.0/2, 1.0/2, 1.0/2],
+            [1.0/2, -1.0/2, 1.0/2],
+            [0, 0, 1]], np.float32)
+
+        B_data = np.array([
+            [1, 0, 0, 0],
+            [0, 1, -1, 1],
+            [-1, 1, 1, 0],
+            [0, 0, 0, -1]], out_dtype)
+
+        A_data = np.array([
+            [1, 0],
+            [1, 1],
+            [1, -1],
+            [0, -1]], out_dtype)
+    else:
+        raise ValueError("Unsupported tile size for winograd: " + str(tile_size))
+    return A_data, B_data, G_data
+
+
+def pick_tile_size(out_height, out_width):
+    """F(4x4, 3x3) does 4x less multiplications than direct conv, but it wastes
+    more work on the border tiles of small feature maps."""
+    if out_height >= 8 and out_width >= 8:
+        return 4
+    return 2
+
+
+def fallback_schedule(cfg, K, P, C):
+    """Register block the batched gemm with one SIMD register of output channels
+    times at most 8 tiles, which uses at most 8 accumulator registers."""
+    simd_width = get_fp32_len()
+
+    def _largest_factor(n, max_factor):
+        for bn in range(max_factor, 0, -1):
+            if n % bn == 0:
+                return bn
+        return 1
+
+    VK = _largest_factor(K, simd_width)
+    VP = _largest_factor(P, 8)
+    VC = _largest_factor(C, 32)
+    cfg["tile_k"] = SplitEntity([K // VK, VK])
+    cfg["tile_p"] = SplitEntity([P // VP, VP])
+    cfg["tile_c"] = SplitEntity([C // VC, VC])
+
+
+def _decl_winograd(cfg, data, kernel, strides, padding, dilation, layout, out_dtype,
+                   tile_size=None):
+    out_dtype = data.dtype if out_dtype is None else out_dtype
+    N, CI, IH, IW = get_const_tuple(data.shape)
+
+    dilation_h, dilation_w = dilation if isinstance(dilation, (tuple, list)) \
+        else (dilation, dilation)
+    assert (dilation_h, dilation_w) == (1, 1), "Does not support dilation"
+
+    if len(kernel.shape) == 4:
+        pre_computed = False
+        CO, _, KH, KW = get_const_tuple(kernel.shape)
+    else:
+        # kernel is pre-transformed to [alpha, alpha, CO // VK, CI, VK]
+        assert tile_size is not None, "tile size is required by the transformed kernel"
+        pre_computed = True
+        H_CAT, W_CAT, CO, CI, VK = get_const_tuple(kernel.shape)
+        CO *= VK
+        KH, KW = H_CAT - tile_size + 1, W_CAT - tile_size + 1
+    HSTR, WSTR = strides if isinstance(strides, (tuple, list)) else (strides, strides)
+    HPAD, WPAD, _, _ = get_pad_tuple(padding, (KH, KW))
+
+    assert layout == 'NCHW'
+    assert KH == 3 and KW == 3 and HSTR == 1 and WSTR == 1
+
+    H = (IH + 2 * HPAD - KH) // HSTR + 1
+    W = (IW + 2 * WPAD - KW) // WSTR + 1
+
+    # the tile size is not a knob, since the other knobs split axes whose lengths depend on it
+    if tile_size is None:
+        tile_size = pick_tile_size(H, W)
+    A_data, B_data, G_data = _winograd_matrices(tile_size, out_dtype)
+
+    m = tile_size
+    r = 3
+    alpha = m + r - 1
+    K = CO
+    C = CI
+
+    nH, nW = (H + m-1) // m, (W + m-1) // m
+    P = N * nH * nW
+
+    cfg.define_split('tile_k', cfg.axis(K), num_outputs=2,
+                     filter=lambda x: x.size[-1] <= 2 * get_fp32_len())
+    cfg.define_split('tile_p', cfg.axis(P), num_outputs=2, filter=lambda x: x.size[-1] <= 16)
+    cfg.define_split('tile_c', cfg.axis(C), num_outputs=2, filter=lambda x: x.size[-1] <= 64)
+    if cfg.is_fallback:
+        fallback_schedule(cfg, K, P, C)
+    VK = cfg['tile_k'].size[-1]
+    VP = cfg['tile_p'].size[-1]
+
+    # pad the bottom and right borders up to whole tiles
+    pad_before = (0, 0, HPAD, WPAD)
+    pad_after = (0, 0, HPAD + nH * m - H, WPAD + nW * m - W)
+    data_pad = pad(data, pad_before, pad_after, name="data_pad")
+
+    # pack input tile
+    input_tile = tvm.compute((C, P // VP, alpha, alpha, VP),
+                             lambda c, b, eps, nu, bb:
+                             data_pad[(b*VP+bb) // (nH*nW)][c][(b*VP+bb) // nW % nH * m + eps]
+                             [(b*VP+bb) % nW * m + nu],
+                             name='d')
+
+    # transform kernel
+    if pre_computed:
+        U = kernel
+    else:
+        G = const_matrix(G_data, 'G')
+        r_kh = tvm.reduce_axis((0, KH), 'r_kh')
+        r_kw = tvm.reduce_axis((0, KW), 'r_kw')
+        U = tvm.compute((alpha, alpha, K // VK, C, VK), lambda eps, nu, k, c, kk:
+                        tvm.sum(kernel[k * VK + kk][c][r_kh][r_kw].astype(out_dtype) *
+                                G[eps][r_kh] * G[nu][r_kw], axis=[r_kh, r_kw]), name='U')
+
+    # transform image
+    B = const_matrix(B_data, 'B')
+    r_eps = tvm.reduce_axis((0, alpha), 'r_eps')
+    r_nu = tvm.reduce_axis((0, alpha), 'r_nu')
+    V = tvm.compute((alpha, alpha, P // VP, C, VP), lambda eps, nu, b, c, bb:
+                    tvm.sum(input_tile[c][b][r_eps][r_nu][bb].astype(out_dtype) *
+                            B[r_eps][eps] * B[r_nu][nu], axis=[r_eps, r_nu]), name='V')
+
+    # batch gemm, with a block of VK output channels in the innermost axis for the FMAs
+    c = tvm.reduce_axis((0, C), name='c')
+    M = tvm.compute((alpha, alpha, K // VK, P, VK), lambda eps, nu, k, b, kk:
+                    tvm.sum(U[eps][nu][k][c][kk] *
+                            V[eps][nu][b // VP][c][b % VP], axis=c), name='M')
+
+    # inverse transform
+    A = const_matrix(A_data, 'A')
+    r_eps = tvm.reduce_axis((0, alpha), 'r_eps')
+    r_nu = tvm.reduce_axis((0, alpha), 'r_nu')
+    Y = tvm.compute((K, P, m, m), lambda k, b, vh, vw:
+                    tvm.sum(M[r_eps][r_nu][k // VK][b][k % VK] * A[r_eps][vh] * A[r_nu][vw],
+                            axis=[r_eps, r_nu]), name='Y')
+
+    # unpack output
+    output = tvm.compute((N, K, H, W), lambda n, k, h, w:
+                         Y[k][n * nH * nW + (h//m) * nW + w//m][h % m][w % m],
+                         name='output', tag='winograd_conv2d_output')
+
+    # we have to manually assign effective GFLOP for winograd
+    cfg.add_flop(2 * N * K * H * W * KH * KW * C)
+    return output
+
+
+def _schedule_winograd(cfg, s, output, last):
+    Y = output.op.input_tensors[0]
+    M, A = Y.op.input_tensors
+    U, V = M.op.input_tensors
+    d, B = V.op.input_tensors
+    data_pad = d.op.input_tensors[0]
+
+    # padding
+    s[data_pad].compute_inline()
+
+    # pack input tiles
+    s[d].compute_inline()
+
+    # transform kernel
+    if isinstance(U.op, tvm.tensor.ComputeOp):
+        kernel, G = U.op.input_tensors
+        s[G].compute_inline()
+        eps, nu, k, c, kk, = s[U].op.axis
+        if autotvm.GLOBAL_SCOPE.in_tuning:
+            # kernel transformation will be pre-computed during compilation, so we skip
+            # this part to make tuning records correct
+            s[U].pragma(eps, 'debug_skip_region')
+        else:
+            r_kh, r_kw = s[U].op.reduce_axis
+            s[U].reorder(k, c, eps, nu, r_kh, r_kw, kk)
+            for axis in [eps, nu, r_kh, r_kw]:
+                s[U].unroll(axis)
+            s[U].vectorize(kk)
+            s[U].parallel(k)
+
+    # transform image
+    DD = s.cache_read(d, 'global', [V])
+    s[B].compute_inline()
+    eps, nu, b, c, bb = s[V].op.axis
+    r_eps, r_nu = s[V].op.reduce_axis
+    s[V].reorder(b, c, eps, nu, r_eps, r_nu, bb)
+    for axis in [eps, nu, r_eps, r_nu]:
+        s[V].unroll(axis)
+    s[DD].compute_at(s[V], c)
+    s[V].vectorize(bb)
+    s[V].parallel(b)
+
+    # batch gemm, accumulate a tile_p x tile_k block in registers
+    MM = s.cache_write(M, 'global')
+    eps, nu, k, b, kk = s[M].op.axis
+    bo, bi = cfg['tile_p'].apply(s, M, b)
+    s[M].reorder(eps, nu, k, bo, bi, kk)
+    fused = s[M].fuse(eps, nu, k)
+    s[M].vectorize(kk)
+    s[M].parallel(fused)
+    s[MM].compute_at(s[M], bo)
+
+    _, _, _, b, kk = s[MM].op.axis
+    c = s[MM].op.reduce_axis[0]
+    co, ci = cfg['tile_c'].apply(s, MM, c)
+    s[MM].reorder(co, ci, b, kk)
+    s[MM].unroll(b)
+    s[MM].vectorize(kk)
+
+    # inverse transform
+    s[A].compute_inline()
+    k, b, vh, vw = s[Y].op.axis
+    r_eps, r_nu = s[Y].op.reduce_axis
+    for axis in [vh, vw, r_eps, r_nu]:
+        s[Y].unroll(axis)
+
+    # output
+    n, co, h, w = s[last].op.axis
+    m = get_const_tuple(Y.shape)[-1]
+    ho, wo, hi, wi = s[last].tile(h, w, m, m)
+    fused = s[last].fuse(n, co, ho)
+    s[last].parallel(fused)
+    s[Y].compute_at(s[last], wo)
+    s[last].unroll(hi)
+    s[last].unroll(wi)
+
+    if output != last:
+        s[output].compute_inline()
+
+
+@autotvm.register_topi_compute(conv2d, 'cpu', ['winograd'])
+def _declaration_conv_winograd(cfg, data, kernel, strides, padding, dilation, layout, out_dtype):
+    """TOPI compute callback. Use winograd template"""
+    return _decl_winograd(cfg, data, kernel, strides, padding, dilation, layout, out_dtype)
+
+
+@autotvm.register_topi_schedule(generic.schedule_conv2d_nchw, 'cpu', ['winograd'])
+def _schedule_conv2d_winograd(cfg, outs):
+    """TOPI schedule callback"""
+    s = tvm.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if 'winograd_conv2d_output' in op.tag:
+            output = op.output(0)
+            _schedule_winograd(cfg, s, output, outs[0])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+##### REGISTER TOPI COMPUTE / SCHEDULE FOR WINOGRAD WITH WEIGHT TRANSFORM #####
+@autotvm.register_topi_compute(conv2d_winograd_without_weight_transform, 'cpu', ['winograd'])
+def _declaration_conv_winograd_ww(cfg, data, kernel, strides, padding, dilation, layout,
+                                  out_dtype, tile_size):
+    """TOPI compute callback"""
+    return _decl_winograd(cfg, data, kernel, strides, padding, dilation, layout, out_dtype,
+                          tile_size)
+
+
+@autotvm.register_topi_schedule(generic.schedule_conv2d_winograd_without_weight_transform,
+                                'cpu', ['winograd'])
+def _schedule_conv2d_winograd_ww(cfg, outs):
+    """TOPI schedule callback"""
+    return _schedule_conv2d_winograd(cfg, outs)
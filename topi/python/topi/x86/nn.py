@@ -6,6 +6,7 @@ from tvm import autotvm
 from tvm.autotvm.task.space import SplitEntity
 
 from .util import get_fp32_len
+from .reduction import _get_reduce_layout, _is_const_shape
 from .. import generic, tag, nn
 from ..util import traverse_inline, get_const_tuple
 
@@ -13,6 +14,11 @@ from ..util import traverse_inline, get_const_tuple
 def schedule_softmax(outs):
     """Schedule for softmax
 
+    The max, the exp sum and the normalization of a row are computed in the same
+    parallel iteration, so the row is read from cache by the last two passes.
+    The split factors are tunable with the "topi_x86_softmax" autotvm task.
+    Symbolic shapes only get their outer axes parallelized.
+
     Parameters
     ----------
     outs: Array of Tensor
@@ -28,17 +34,107 @@ def schedule_softmax(outs):
     x = outs[0]
     s = tvm.create_schedule([x.op for x in outs])
     tvm.schedule.AutoInlineInjective(s)
-    if len(s[x].op.axis) >= 5:
-        fused = s[x].fuse(s[x].op.axis[0], s[x].op.axis[1], s[x].op.axis[2])
-        s[x].parallel(fused)
-    elif len(s[x].op.axis) >= 3:
-        fused = s[x].fuse(s[x].op.axis[0], s[x].op.axis[1])
-        s[x].parallel(fused)
-    else:
-        s[x].parallel(s[x].op.axis[0])
+    if not _is_const_shape(x.shape):
+        if len(s[x].op.axis) >= 5:
+            fused = s[x].fuse(s[x].op.axis[0], s[x].op.axis[1], s[x].op.axis[2])
+            s[x].parallel(fused)
+        elif len(s[x].op.axis) >= 3:
+            fused = s[x].fuse(s[x].op.axis[0], s[x].op.axis[1])
+            s[x].parallel(fused)
+        else:
+            s[x].parallel(s[x].op.axis[0])
+        return s
+    max_elem = x.op.input_tensors[1]
+    expsum = x.op.input_tensors[2]
+    _softmax_dispatcher(s, x, max_elem, expsum)
     return s
 
 
+@autotvm.task.dispatcher
+def _softmax_dispatcher(s, softmax, max_elem, expsum):
+    """Workload of softmax and log_softmax: the input shape, dtype and axis."""
+    data, dims = _get_reduce_layout(max_elem.op)
+    return ('topi_x86_softmax', get_const_tuple(data.shape), data.dtype, dims[0])
+
+
+@_softmax_dispatcher.register('direct')
+def _schedule_softmax(cfg, s, softmax, max_elem, expsum):
+    _, dims = _get_reduce_layout(max_elem.op)
+    axis = dims[0]
+    ndim = len(softmax.shape)
+    vec = get_fp32_len()
+
+    if axis == ndim - 1:
+        # reduce a row with acc vectors of partial results, see x86 schedule_reduce
+        cfg.define_split('tile_k', max_elem.op.reduce_axis[0], num_outputs=3,
+                         filter=lambda x: x.size[-1] <= 64)
+        cfg.define_split('tile_x', softmax.op.axis[-1], num_outputs=2,
+                         filter=lambda x: x.size[-1] <= 64)
+        if cfg.is_fallback:
+            cfg.fallback_split('tile_k', [-1, 4, vec])
+            cfg.fallback_split('tile_x', [-1, vec])
+        _, acc, lanes = cfg['tile_k'].size
+
+        outer = list(softmax.op.axis[:-1])
+        _, xi = cfg['tile_x'].apply(s, softmax, softmax.op.axis[-1])
+        s[softmax].vectorize(xi)
+
+        stages = []
+        for tensor in [max_elem, expsum]:
+            _, ki = s[tensor].split(s[tensor].op.reduce_axis[0], factor=acc * lanes)
+            rf = s.rfactor(tensor, ki, factor_axis=len(outer))
+            ka, kv = s[rf].split(s[rf].op.axis[-1], factor=lanes)
+            s[rf].reorder(*(list(s[rf].op.axis[:-1]) + list(s[rf].op.reduce_axis) + [ka, kv]))
+            s[rf].unroll(ka)
+            s[rf].vectorize(kv)
+            stages += [rf, tensor]
+    else:
+        # vectorize along the innermost axis, which all three passes keep
+        cfg.define_split('tile_x', softmax.op.axis[-1], num_outputs=3,
+                         filter=lambda x: x.size[-1] <= 64)
+        if cfg.is_fallback:
+            cfg.fallback_split('tile_x', [-1, 4, vec])
+
+        outer = [ax for i, ax in enumerate(softmax.op.axis) if i not in (axis, ndim - 1)]
+        xo, xa, xv = cfg['tile_x'].apply(s, softmax, softmax.op.axis[-1])
+        s[softmax].reorder(*(outer + [softmax.op.axis[axis], xo, xa, xv]))
+        s[softmax].vectorize(xv)
+
+        stages = []
+        for tensor in [max_elem, expsum]:
+            axes = list(s[tensor].op.axis)
+            k = s[tensor].op.reduce_axis[0]
+            txo, txa, txv = cfg['tile_x'].apply(s, tensor, axes[-1])
+            s[tensor].reorder(*(axes[:-1] + [txo, k, txa, txv]))
+            s[tensor].unroll(txa)
+            s[tensor].vectorize(txv)
+            if not outer:
+                s[tensor].parallel(txo)
+            stages.append(tensor)
+
+    if outer:
+        fused = s[softmax].fuse(*outer)
+        s[softmax].parallel(fused)
+        for tensor in stages:
+            s[tensor].compute_at(s[softmax], fused)
+    else:
+        s[softmax].parallel(s[softmax].leaf_iter_vars[0])
+
+
+@autotvm.task.register("topi_x86_softmax")
+def _topi_x86_softmax(shape, dtype, axis):
+    """Tuning task of the x86 softmax schedule, which log_softmax shares.
+
+    Its arguments are the workload without the leading name, e.g.
+    ``autotvm.task.create("topi_x86_softmax", args=((64, 1000), "float32", 1),
+    target="llvm", template_key="direct")``.
+    """
+    data = tvm.placeholder(shape, dtype=dtype, name="data")
+    out = nn.softmax(data, axis)
+    s = schedule_softmax([out])
+    return s, [data, out]
+
+
 @autotvm.register_topi_compute(nn.dense, "cpu", "direct")
 def _declaration_dense(cfg, data, weight, bias=None):
     batch, _ = get_const_tuple(data.shape)
@@ -0,0 +1,222 @@
+# pylint: disable=invalid-name,too-many-locals
+"""x86 schedule for reduction operators"""
+from __future__ import absolute_import as _abs
+import tvm
+from tvm import autotvm
+
+from .util import get_fp32_len
+from .. import tag, generic
+from ..reduction import sum as _sum, argmax as _argmax
+from ..util import get_const_tuple
+
+
+def _get_reduce_layout(op):
+    """Get the input tensor of a reduction and the dimensions it reduces.
+
+    Parameters
+    ----------
+    op : tvm.tensor.ComputeOp
+        The reduction op, reading its input at the reduce axes.
+
+    Returns
+    -------
+    data : tvm.Tensor or None
+        The reduced tensor, None if the op does not read one tensor element.
+    dims : list of int
+        The reduced dimensions of data, in increasing order.
+    """
+    src = op.body[0].source[-1]
+    if not isinstance(src, tvm.expr.Call) or src.call_type != tvm.expr.Call.Halide:
+        return None, []
+    data = src.func.output(src.value_index)
+    reduce_vars = [iv.var for iv in op.reduce_axis]
+    dims = [i for i, arg in enumerate(src.args)
+            if any(arg.same_as(var) for var in reduce_vars)]
+    return data, dims
+
+
+def _is_const_shape(shape):
+    """Whether all the extents of shape are constant integers."""
+    return all(isinstance(x, (int, tvm.expr.IntImm, tvm.expr.UIntImm)) for x in shape)
+
+
+def _parallel_outer(sch, out):
+    """Fuse all the axes of out but the innermost one and parallelize them."""
+    axis = sch[out].op.axis
+    if len(axis) >= 2:
+        fused = sch[out].fuse(*axis[:-1])
+        sch[out].parallel(fused)
+    elif len(axis) == 1:
+        sch[out].parallel(axis[0])
+
+
+@autotvm.task.dispatcher
+def _reduce_dispatcher(sch, red_op, out_op):
+    """Workload of a reduction: the input shape, dtype and the reduced dimensions."""
+    data, dims = _get_reduce_layout(red_op)
+    return ('topi_x86_reduce', get_const_tuple(data.shape), data.dtype, tuple(dims),
+            red_op.num_outputs > 1)
+
+
+@_reduce_dispatcher.register('direct')
+def _schedule_reduce(cfg, sch, red_op, out_op):
+    """Schedule a reduction and its output.
+
+    red_op is the reduction itself, out_op is the op writing its result, which is
+    the index copy of an argmax/argmin and red_op for other reductions.
+    """
+    red = red_op.output(0)
+    out = out_op.output(0)
+    data, dims = _get_reduce_layout(red_op)
+    axis = list(sch[red].op.axis)
+    reduce_axis = list(sch[red].op.reduce_axis)
+    vec = get_fp32_len()
+
+    if dims[-1] == len(data.shape) - 1:
+        # The innermost dimension is reduced. Keep acc vectors of partial results
+        # in registers by factoring out the innermost part of the last reduce axis,
+        # then combine them once per output element.
+        cfg.define_split('tile_k', reduce_axis[-1], num_outputs=3,
+                         filter=lambda x: x.size[-1] <= 64)
+        if cfg.is_fallback:
+            cfg.fallback_split('tile_k', [-1, 4, vec])
+        _, acc, lanes = cfg['tile_k'].size
+
+        _, ki = sch[red].split(reduce_axis[-1], factor=acc * lanes)
+        rf = sch.rfactor(red, ki, factor_axis=len(axis))
+        rf_op = rf.op if isinstance(rf, tvm.tensor.Tensor) else rf[0].op
+        ka, kv = sch[rf_op].split(rf_op.axis[-1], factor=lanes)
+        sch[rf_op].reorder(*(list(rf_op.axis[:-1]) + list(rf_op.reduce_axis) + [ka, kv]))
+        sch[rf_op].unroll(ka)
+        sch[rf_op].vectorize(kv)
+
+        if out.op.axis:
+            fused = sch[out].fuse(*out.op.axis)
+            sch[out].parallel(fused)
+            sch[rf_op].compute_at(sch[out], fused)
+            if out_op != red_op:
+                sch[red_op].compute_at(sch[out], fused)
+    else:
+        # The innermost dimension is kept. Move the reduction outside of it and
+        # vectorize along the output instead, with acc independent vectors.
+        cfg.define_split('tile_x', axis[-1], num_outputs=3,
+                         filter=lambda x: x.size[-1] <= 64)
+        if cfg.is_fallback:
+            cfg.fallback_split('tile_x', [-1, 4, vec])
+
+        xo, xa, xv = cfg['tile_x'].apply(sch, red, axis[-1])
+        sch[red].reorder(*(axis[:-1] + [xo] + reduce_axis + [xa, xv]))
+        sch[red].unroll(xa)
+        sch[red].vectorize(xv)
+
+        if out_op == red_op:
+            fused = sch[red].fuse(*(axis[:-1] + [xo]))
+            sch[red].parallel(fused)
+        else:
+            oxo, _ = sch[out].split(out.op.axis[-1], factor=cfg['tile_x'].size[-2] *
+                                    cfg['tile_x'].size[-1])
+            fused = sch[out].fuse(*(list(out.op.axis[:-1]) + [oxo]))
+            sch[out].parallel(fused)
+            sch[red_op].compute_at(sch[out], fused)
+
+
+@generic.schedule_reduce.register(["cpu"])
+def schedule_reduce(outs):
+    """X86 schedule for inject->reduce->bcast ops.
+
+    The reductions are vectorized along the innermost dimension of their input,
+    either on the reduce axis with several accumulators or on the output axis.
+    The split factors are tunable with the "topi_x86_reduce" autotvm task.
+    Reductions of symbolic shapes keep the default fused schedule.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of reduce in the format
+          of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, tvm.tensor.Tensor) else outs
+    sch = tvm.create_schedule([x.op for x in outs])
+    scheduled_ops = []
+
+    def traverse_before_reduce(operator):
+        """Internal travserse function"""
+        if isinstance(operator, tvm.tensor.PlaceholderOp):
+            return
+        if tag.is_injective(operator.tag):
+            sch[operator].compute_inline()
+            for tensor in operator.input_tensors:
+                if tensor.op not in scheduled_ops:
+                    traverse_before_reduce(tensor.op)
+        else:
+            raise RuntimeError("Unsupported operator: %s" % operator.tag)
+
+        scheduled_ops.append(operator)
+
+    def schedule_reduce_op(red_op, out_op):
+        """Schedule a reduction, a reduce over no axis is just a copy"""
+        data, dims = _get_reduce_layout(red_op)
+        if data is None or not dims:
+            _parallel_outer(sch, out_op.output(0))
+            if out_op != red_op:
+                sch[red_op].compute_inline()
+        elif not _is_const_shape(data.shape):
+            # symbolic shapes have no workload to tune, keep the default schedule
+            if out_op.axis:
+                sch[out_op].fuse(*out_op.axis)
+        else:
+            _reduce_dispatcher(sch, red_op, out_op)
+
+    def traverse_after_reduce(operator):
+        """Internal travserse function"""
+        if isinstance(operator, tvm.tensor.PlaceholderOp) or operator in scheduled_ops:
+            return
+        if tag.is_broadcast(operator.tag):
+            if operator in sch.outputs:
+                _parallel_outer(sch, operator.output(0))
+            else:
+                sch[operator].compute_inline()
+            for tensor in operator.input_tensors:
+                traverse_after_reduce(tensor.op)
+        elif operator.tag == 'comm_reduce':
+            schedule_reduce_op(operator, operator)
+            for tensor in operator.input_tensors:
+                if tensor.op not in scheduled_ops:
+                    traverse_before_reduce(tensor.op)
+        elif operator.tag == 'comm_reduce_idx':
+            red_op = operator.input_tensors[0].op
+            schedule_reduce_op(red_op, operator)
+            for tensor in red_op.input_tensors:
+                if tensor.op not in scheduled_ops:
+                    traverse_before_reduce(tensor.op)
+        else:
+            raise RuntimeError("Unsupported operator: %s" % operator.tag)
+
+        scheduled_ops.append(operator)
+
+    for out in outs:
+        traverse_after_reduce(out.op)
+    return sch
+
+
+@autotvm.task.register("topi_x86_reduce")
+def _topi_x86_reduce(shape, dtype, axis, is_idx_reduce):
+    """Tuning task of the x86 reduction schedule.
+
+    Its arguments are the workload of a reduction without the leading name, e.g.
+    ``autotvm.task.create("topi_x86_reduce", args=((64, 512), "float32", (1,), False),
+    target="llvm", template_key="direct")``. Reductions of the same shape share
+    a config, so a sum task also tunes max and min, and an argmax task argmin.
+    """
+    data = tvm.placeholder(shape, dtype=dtype, name="data")
+    if is_idx_reduce:
+        out = _argmax(data, axis=axis)
+    else:
+        out = _sum(data, axis=axis)
+    s = schedule_reduce([out])
+    return s, [data, out]
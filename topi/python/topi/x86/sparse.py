@@ -0,0 +1,167 @@
+# pylint: disable=invalid-name
+"""x86 sparse_dense schedule and block size tuning template"""
+from __future__ import absolute_import as _abs
+import numpy as np
+import tvm
+from tvm import autotvm
+
+from .util import get_fp32_len
+from .. import generic, nn
+from ..util import traverse_inline, get_const_int
+
+
+@generic.schedule_sparse_dense.register(["cpu"])
+def schedule_sparse_dense(outs):
+    """Schedule for sparse_dense.
+
+    A BSR weight is multiplied block by block, vectorized along the rows of a
+    block. The rows of the output are parallelized for both CSR and BSR.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of sparse_dense
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, tvm.tensor.Tensor) else outs
+    s = tvm.create_schedule([x.op for x in outs])
+    out = outs[0]
+
+    def _callback(op):
+        if op.tag == "sparse_dense_csrmm":
+            # every output column is a sparse row of the weight,
+            # its elements are loaded once for all the rows of data
+            if op != out.op:
+                i, row = s[out].op.axis
+                s[out].reorder(row, i)
+                s[out].parallel(row)
+                s[op].compute_at(s[out], row)
+            else:
+                i, row = s[op].op.axis
+                s[op].reorder(row, i)
+                s[op].parallel(row)
+
+        if op.tag == "sparse_dense_bsrmm":
+            block = op.input_tensors[0]
+            bs_r = get_const_int(block.op.axis[2].dom.extent)
+            if op != out.op:
+                s[op].compute_inline()
+            i, n = s[out].op.axis
+            no, ni = s[out].split(n, bs_r)
+            s[out].reorder(no, i, ni)
+            fused = s[out].fuse(no, i)
+            s[out].parallel(fused)
+            s[out].vectorize(ni)
+
+            s[block].compute_at(s[out], fused)
+            j = s[block].op.axis[2]
+            elem_idx, c = s[block].op.reduce_axis
+            s[block].reorder(elem_idx, c, j)
+            s[block].unroll(c)
+            s[block].vectorize(j)
+
+    traverse_inline(s, out.op, _callback)
+    return s
+
+
+def _default_bsr_block_size(N):
+    """Blocks of one vector of rows by one column"""
+    bs_r = get_fp32_len()
+    while N % bs_r != 0:
+        bs_r //= 2
+    return bs_r, 1
+
+
+def bsr_block_density(weight):
+    """Get the block density of a weight at every candidate BSR block size.
+
+    Parameters
+    ----------
+    weight : numpy.ndarray
+        The [N, K] weight.
+
+    Returns
+    -------
+    block_density : tuple of (int, int, float)
+        (bs_r, bs_c, density) for each block size dividing the weight, where density
+        is the fraction of blocks with a non-zero element, rounded to 2 decimals.
+    """
+    N, K = weight.shape
+    block_density = []
+    for bs_r in [x for x in [1, 2, 4, 8, 16] if N % x == 0]:
+        for bs_c in [x for x in [1, 2, 4, 8] if K % x == 0]:
+            blocks = weight.reshape(N // bs_r, bs_r, K // bs_c, bs_c)
+            mask = np.any(blocks != 0, axis=(1, 3))
+            block_density.append((bs_r, bs_c, round(float(np.mean(mask)), 2)))
+    return tuple(block_density)
+
+
+def get_bsr_block_size(M, N, K, block_density, dtype):
+    """Get the BSR block size of a [N, K] weight multiplied with a [M, K] data.
+
+    The block size is looked up in the current autotvm dispatch context under
+    the workload of the ``topi_x86_sparse_dense_bsr`` template, otherwise a vector of
+    rows by one column is used.
+
+    Parameters
+    ----------
+    M, N, K : int
+        The shapes of the multiplication, M is None when it is symbolic,
+        which has no workload and uses the default block size.
+    block_density : tuple of (int, int, float)
+        The block density of the weight, see bsr_block_density.
+    dtype : str
+        The data type.
+
+    Returns
+    -------
+    blocksize : tuple of int
+        The block size (bs_r, bs_c).
+    """
+    if M is None:
+        return _default_bsr_block_size(N)
+    workload = ('topi_x86_sparse_dense_bsr', M, N, K, block_density, dtype)
+    target = tvm.target.current_target(allow_none=True)
+    cfg = autotvm.DispatchContext.current.query(target, workload)
+    if cfg.is_fallback:
+        return _default_bsr_block_size(N)
+    return cfg['bs_r'].val, cfg['bs_c'].val
+
+
+@autotvm.template
+def topi_x86_sparse_dense_bsr(M, N, K, block_density, dtype):
+    """Tuning template for the BSR block size of sparse_dense.
+
+    The sparsity pattern is synthesized in memory with the block density of the
+    weight at the block size of the config, its non-zero blocks evenly spread along
+    each block row, so the measurement does not depend on the uninitialized inputs
+    of the tuner. Create the task with ``autotvm.task.create("topi_x86_sparse_dense_bsr",
+    args=(M, N, K, bsr_block_density(weight), dtype), target)`` and apply its best
+    config when converting dense, see get_bsr_block_size.
+    """
+    cfg = autotvm.get_config()
+    cfg.define_knob('bs_r', sorted(set(bs[0] for bs in block_density)))
+    cfg.define_knob('bs_c', sorted(set(bs[1] for bs in block_density)))
+    bs_r, bs_c = cfg['bs_r'].val, cfg['bs_c'].val
+    density = dict(((r, c), d) for r, c, d in block_density)[(bs_r, bs_c)]
+
+    num_block_rows, num_block_cols = N // bs_r, K // bs_c
+    row_blocks = min(num_block_cols, max(1, int(round(density * num_block_cols))))
+    step = num_block_cols // row_blocks
+    indptr = tvm.compute((num_block_rows + 1,),
+                         lambda r: r * row_blocks, name="indptr")
+    indices = tvm.compute((num_block_rows * row_blocks,),
+                          lambda e: ((e % row_blocks) * step + e // row_blocks) % num_block_cols,
+                          name="indices")
+
+    data = tvm.placeholder((M, K), dtype=dtype, name="data")
+    weight_data = tvm.placeholder((num_block_rows * row_blocks, bs_r, bs_c),
+                                  dtype=dtype, name="weight_data")
+    out = nn.sparse_dense(data, weight_data, indices, indptr)
+    s = schedule_sparse_dense([out])
+    return s, [data, weight_data, out]
@@ -45,6 +45,7 @@
 #include <topi/cuda/normalization.h>
 
 #include <topi/x86/bnn.h>
+#include <topi/x86/conv2d.h>
 #include <topi/x86/default.h>
 #include <topi/x86/injective.h>
 
@@ -204,6 +205,17 @@ TVM_REGISTER_GLOBAL("topi.nn.pad")
   *rv = pad(args[0], args[1], args[2], args[3]);
   });
 
+TVM_REGISTER_GLOBAL("topi.nn.conv2d_NCHWc")
+.set_body([](TVMArgs args, TVMRetValue *rv) {
+  *rv = conv2d_NCHWc(args[0], args[1], args[2], args[3], args[4], args[5], args[6]);
+  });
+
+TVM_REGISTER_GLOBAL("topi.nn.depthwise_conv2d_NCHWc")
+.set_body([](TVMArgs args, TVMRetValue *rv) {
+  *rv = depthwise_conv2d_NCHWc(args[0], args[1], args[2], args[3], args[4], args[5],
+                               args[6]);
+  });
+
 /* Ops from reduction.h */
 TVM_REGISTER_GLOBAL("topi.sum")
 .set_body([](TVMArgs args, TVMRetValue *rv) {
@@ -453,6 +465,17 @@ TVM_REGISTER_GLOBAL("topi.generic.schedule_injective")
   });
 
 /* x86 schedules */
+/*! \brief Get the conv2d NCHW[x]c config from [ic_bn, oc_bn, reg_n, unroll_kw] */
+inline x86::Conv2dNCHWcConfig GetConv2dNCHWcConfig(const Array<Integer>& values) {
+  CHECK_EQ(values.size(), 4) << "expects config [ic_bn, oc_bn, reg_n, unroll_kw]";
+  x86::Conv2dNCHWcConfig cfg;
+  cfg.ic_bn = static_cast<int>(values[0]->value);
+  cfg.oc_bn = static_cast<int>(values[1]->value);
+  cfg.reg_n = static_cast<int>(values[2]->value);
+  cfg.unroll_kw = values[3]->value != 0;
+  return cfg;
+}
+
 TVM_REGISTER_GLOBAL("topi.x86.schedule_binarize_pack")
 .set_body([](TVMArgs args, TVMRetValue *rv) {
   *rv = topi::x86::schedule_binarize_pack(args[0], args[1]);
@@ -472,6 +495,27 @@ TVM_REGISTER_GLOBAL("topi.x86.default_schedule")
   }
   });
 
+// An optional third argument [ic_bn, oc_bn, reg_n, unroll_kw] overrides the default config.
+TVM_REGISTER_GLOBAL("topi.x86.schedule_conv2d_NCHWc")
+.set_body([](TVMArgs args, TVMRetValue *rv) {
+  if (args.size() > 2) {
+    *rv = topi::x86::schedule_conv2d_NCHWc_with_config(args[0], args[1],
+                                                       GetConv2dNCHWcConfig(args[2]));
+  } else {
+    *rv = topi::x86::schedule_conv2d_NCHWc(args[0], args[1]);
+  }
+  });
+
+TVM_REGISTER_GLOBAL("topi.x86.schedule_depthwise_conv2d_NCHWc")
+.set_body([](TVMArgs args, TVMRetValue *rv) {
+  if (args.size() > 2) {
+    *rv = topi::x86::schedule_depthwise_conv2d_NCHWc_with_config(args[0], args[1],
+                                                                 GetConv2dNCHWcConfig(args[2]));
+  } else {
+    *rv = topi::x86::schedule_depthwise_conv2d_NCHWc(args[0], args[1]);
+  }
+  });
+
 TVM_REGISTER_GLOBAL("topi.x86.schedule_injective")
 .set_body([](TVMArgs args, TVMRetValue *rv) {
   *rv = topi::x86::schedule_injective(args[0], args[1]);
@@ -617,6 +661,14 @@ TVM_REGISTER_GENERIC_FUNC(schedule_reduce)
 .register_func({ "cpu" }, WrapSchedule(topi::x86::default_schedule_auto_inline))
 .register_func({ "cuda", "gpu" }, WrapSchedule(topi::cuda::schedule_reduce));
 
+TVM_REGISTER_GENERIC_FUNC(schedule_conv2d_NCHWc)
+.set_default(WrapSchedule(topi::generic::default_schedule))
+.register_func({ "cpu" }, WrapSchedule(topi::x86::schedule_conv2d_NCHWc));
+
+TVM_REGISTER_GENERIC_FUNC(schedule_depthwise_conv2d_NCHWc)
+.set_default(WrapSchedule(topi::generic::default_schedule))
+.register_func({ "cpu" }, WrapSchedule(topi::x86::schedule_depthwise_conv2d_NCHWc));
+
 TVM_REGISTER_GENERIC_FUNC(schedule_binarize_pack)
 .set_default(WrapSchedule(topi::generic::default_schedule))
 .register_func({ "cpu" }, WrapSchedule(topi::x86::schedule_binarize_pack));
@@ -0,0 +1,78 @@
+"""Test code for batch_matmul operator"""
+import numpy as np
+import tvm
+import topi
+import topi.testing
+from tvm import autotvm
+from topi.util import get_const_tuple
+from tvm.contrib.pickle_memoize import memoize
+
+
+def verify_batch_matmul(batch, M, N, K):
+    x = tvm.placeholder((batch, M, K), name='x')
+    y = tvm.placeholder((batch, N, K), name='y')
+    dtype = x.dtype
+
+    # use memoize to pickle the test data for next time use
+    @memoize("topi.tests.test_topi_batch_matmul")
+    def get_ref_data():
+        a_np = np.random.uniform(size=(batch, M, K)).astype(dtype)
+        b_np = np.random.uniform(size=(batch, N, K)).astype(dtype)
+        c_np = np.matmul(a_np, b_np.transpose(0, 2, 1))
+        return (a_np, b_np, c_np)
+    # get the test data
+    a_np, b_np, c_np = get_ref_data()
+
+    def check_device(device):
+        ctx = tvm.context(device, 0)
+        if not ctx.exist:
+            print("Skip because %s is not enabled" % device)
+            return
+        if "cblas" in device and not tvm.get_global_func("tvm.contrib.cblas.batch_matmul", True):
+            print("Skip because cblas is not enabled")
+            return
+        print("Running on target: %s" % device)
+        with tvm.target.create(device):
+            out = topi.nn.batch_matmul(x, y)
+            s = topi.generic.schedule_batch_matmul([out])
+        a = tvm.nd.array(a_np, ctx)
+        b = tvm.nd.array(b_np, ctx)
+        c = tvm.nd.array(np.zeros(get_const_tuple(out.shape), dtype=dtype), ctx)
+        f = tvm.build(s, [x, y, out], device, name="batch_matmul")
+        f(a, b, c)
+        tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=1e-5)
+
+    for device in ["llvm", "llvm -libs=cblas"]:
+        check_device(device)
+
+def test_batch_matmul():
+    verify_batch_matmul(1, 16, 16, 32)
+    verify_batch_matmul(5, 16, 16, 32)
+    verify_batch_matmul(5, 16, 20, 32)
+    verify_batch_matmul(30, 16, 20, 32)
+
+def test_batch_matmul_tuning_task():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    batch, M, N, K = 4, 32, 48, 64
+    task = autotvm.task.create("topi_nn_batch_matmul",
+                               args=(('TENSOR', (batch, M, K), 'float32'),
+                                     ('TENSOR', (batch, N, K), 'float32')),
+                               target="llvm", template_key="direct")
+    a_np = np.random.uniform(size=(batch, M, K)).astype('float32')
+    b_np = np.random.uniform(size=(batch, N, K)).astype('float32')
+    c_np = np.matmul(a_np, b_np.transpose(0, 2, 1))
+    ctx = tvm.cpu(0)
+    for index in np.random.randint(0, len(task.config_space), size=5):
+        with tvm.target.create("llvm"):
+            s, args = task.instantiate(task.config_space.get(index))
+        f = tvm.build(s, args, "llvm")
+        c = tvm.nd.array(np.zeros((batch, M, N), dtype='float32'), ctx)
+        f(tvm.nd.array(a_np, ctx), tvm.nd.array(b_np, ctx), c)
+        tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=1e-5)
+
+
+if __name__ == "__main__":
+    test_batch_matmul()
+    test_batch_matmul_tuning_task()
@@ -113,6 +113,54 @@ def verify_conv2d_NCHWc(batch, in_channel, in_size, num_filter, kernel, stride,
             check_device(device)
 
 
+def verify_conv2d_NCHWc_cpp(batch, in_channel, in_size, num_filter, kernel, stride,
+                            padding, add_relu=False, config=None, dtype="float32"):
+    in_height = in_width = in_size
+    ic_block, oc_block = 8, 8
+    if config is not None:
+        ic_block, oc_block = config[0], config[1]
+
+    A = tvm.placeholder((batch, in_channel//ic_block, in_height, in_width, ic_block), name='A')
+    W = tvm.placeholder((num_filter//oc_block, in_channel//ic_block, kernel, kernel, ic_block, oc_block), name='W')
+
+    a_np = np.random.uniform(size=(batch, in_channel, in_height, in_width)).astype(dtype)
+    w_np = np.random.uniform(size=(num_filter, in_channel, kernel, kernel)).astype(dtype)
+    c_np = topi.testing.conv2d_nchw_python(a_np, w_np, stride, padding)
+    if add_relu:
+        c_np = np.maximum(c_np, 0)
+    a_np = _transform_data(a_np, ic_block)
+    w_np = _transform_kernel(w_np, ic_block, oc_block)
+    c_np = _transform_data(c_np, oc_block)
+
+    device = "llvm"
+    ctx = tvm.context(device, 0)
+    if not ctx.exist:
+        print("Skip because %s is not enabled" % device)
+        return
+    target = tvm.target.create(device)
+    C = topi.cpp.nn.conv2d_NCHWc(A, W, padding, padding, stride, stride, dtype)
+    if add_relu:
+        C = topi.cpp.nn.relu(C)
+    if config is None:
+        s = topi.cpp.x86.schedule_conv2d_NCHWc(target, [C])
+    else:
+        s = topi.cpp.x86.schedule_conv2d_NCHWc(target, [C], config)
+
+    a = tvm.nd.array(a_np, ctx)
+    w = tvm.nd.array(w_np, ctx)
+    c = tvm.nd.array(np.zeros(get_const_tuple(C.shape), dtype=C.dtype), ctx)
+    func = tvm.build(s, [A, W, C], target)
+    func(a, w, c)
+    tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=1e-5)
+
+
+def test_conv2d_NCHWc_cpp():
+    verify_conv2d_NCHWc_cpp(1, 64, 56, 64, 3, 1, 1)
+    verify_conv2d_NCHWc_cpp(1, 64, 56, 128, 1, 2, 0)
+    verify_conv2d_NCHWc_cpp(1, 64, 56, 64, 3, 1, 1, add_relu=True)
+    verify_conv2d_NCHWc_cpp(2, 32, 17, 64, 3, 2, 1, config=[16, 16, 9, True])
+
+
 def test_conv2d_NCHWc():
     # ResNet18 workloads
     verify_conv2d_NCHWc(1,   3, 224,  64, 7, 2, 3)
@@ -202,4 +250,5 @@ def test_conv2d_NCHWc():
     verify_conv2d_NCHWc(1,  256,   3, 126, 3, 1, 1)
 
 if __name__ == "__main__":
-    test_conv2d_NCHWc()
\ No newline at end of file
+    test_conv2d_NCHWc()
+    test_conv2d_NCHWc_cpp()
\ No newline at end of file
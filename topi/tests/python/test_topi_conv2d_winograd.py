@@ -67,7 +67,7 @@ def verify_conv2d_nchw(batch, in_channel, in_size, num_filter, kernel, stride, p
         tvm.testing.assert_allclose(c.asnumpy(), c_np, rtol=1e-5)
 
 
-    for device in ['cuda', 'llvm -device=arm_cpu', 'opencl -device=mali']:
+    for device in ['cuda', 'llvm', 'llvm -device=arm_cpu', 'opencl -device=mali']:
         check_device(device)
 
 
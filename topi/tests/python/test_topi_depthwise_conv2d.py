@@ -273,6 +273,11 @@ def depthwise_conv2d_with_workload_NCHWc(batch, in_channel, in_height, channel_m
         # build the kernels
         f1 = tvm.build(s1, [Input, Filter, DepthwiseConv2d], device)
         f2 = tvm.build(s2, [Input, Filter, Relu], device)
+        # the C++ compute and schedule of the same workload
+        ReluCpp = topi.cpp.nn.relu(topi.cpp.nn.depthwise_conv2d_NCHWc(
+            Input, Filter, pad_h, pad_w, stride_h, stride_w, dtype))
+        s3 = topi.cpp.x86.schedule_depthwise_conv2d_NCHWc(tvm.target.create(device), [ReluCpp])
+        f3 = tvm.build(s3, [Input, Filter, ReluCpp], device)
 
         # Prepare pod type for test data closure
         input_shape = (batch, in_channel, in_height, in_width)
@@ -306,6 +311,9 @@ def depthwise_conv2d_with_workload_NCHWc(batch, in_channel, in_height, channel_m
         f2(input_tvm, filter_tvm, relu_tvm)
         tvm.testing.assert_allclose(depthwise_conv2d_tvm.asnumpy(), depthwise_conv2d_scipy, rtol=1e-5)
         tvm.testing.assert_allclose(relu_tvm.asnumpy(), relu_scipy, rtol=1e-5)
+        relu_cpp_tvm = tvm.nd.array(np.zeros(shape=get_const_tuple(Relu.shape), dtype=Relu.dtype), ctx)
+        f3(input_tvm, filter_tvm, relu_cpp_tvm)
+        tvm.testing.assert_allclose(relu_cpp_tvm.asnumpy(), relu_scipy, rtol=1e-5)
 
     # test llvm only for now since depthwise_conv2d_NCHWc implement is missing in other backend.
     for device in ["llvm"]:
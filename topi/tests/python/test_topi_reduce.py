@@ -2,6 +2,7 @@
 import os
 import numpy as np
 import tvm
+from tvm import autotvm
 import topi
 
 from common import get_all_backend
@@ -139,5 +140,46 @@ def test_reduce_map():
                           type="sum",
                           dtype="float64")
 
+
+def test_reduce_x86_tuning_task():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    for args in [((64, 512), "float32", (1,), False),
+                 ((64, 512), "float32", (0,), False),
+                 ((64, 512), "float32", (1,), True)]:
+        shape, dtype, axis, is_idx_reduce = args
+        task = autotvm.task.create("topi_x86_reduce", args=args,
+                                   target="llvm", template_key="direct")
+        assert task.workload == ("topi_x86_reduce",) + args
+        assert len(task.config_space) > 1
+        a_np = np.random.uniform(size=shape).astype(dtype)
+        if is_idx_reduce:
+            out_np = a_np.argmax(axis=axis[0])
+        else:
+            out_np = a_np.sum(axis=axis)
+        ctx = tvm.cpu(0)
+        for index in np.random.randint(0, len(task.config_space), size=5):
+            with tvm.target.create("llvm"):
+                s, (data, out) = task.instantiate(task.config_space.get(index))
+            f = tvm.build(s, [data, out], "llvm")
+            out_tvm = tvm.nd.empty(out_np.shape, dtype=out.dtype, ctx=ctx)
+            f(tvm.nd.array(a_np, ctx), out_tvm)
+            tvm.testing.assert_allclose(out_tvm.asnumpy(), out_np, rtol=1e-4)
+
+    # symbolic shapes have no workload and keep the default schedule
+    n = tvm.var("n")
+    data = tvm.placeholder((n, 512), name="data")
+    out = topi.sum(data, axis=1)
+    with tvm.target.create("llvm"):
+        s = topi.generic.schedule_reduce(out)
+    f = tvm.build(s, [data, out], "llvm")
+    a_np = np.random.uniform(size=(7, 512)).astype("float32")
+    out_tvm = tvm.nd.empty((7,), ctx=tvm.cpu(0))
+    f(tvm.nd.array(a_np, tvm.cpu(0)), out_tvm)
+    tvm.testing.assert_allclose(out_tvm.asnumpy(), a_np.sum(axis=1), rtol=1e-4)
+
+
 if __name__ == "__main__":
     test_reduce_map()
+    test_reduce_x86_tuning_task()
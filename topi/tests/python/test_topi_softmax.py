@@ -2,6 +2,7 @@
 import os
 import numpy as np
 import tvm
+from tvm import autotvm
 import topi
 import topi.testing
 import logging
@@ -34,7 +35,7 @@ def verify_softmax(m, n, dtype="float32"):
     a_np = np.random.uniform(size=get_const_tuple(A.shape)).astype(A.dtype)
     b_np = topi.testing.softmax_python(a_np)
 
-    for device in ['cuda', 'opencl', 'metal', 'rocm', 'vulkan', 'nvptx']:
+    for device in ['llvm', 'cuda', 'opencl', 'metal', 'rocm', 'vulkan', 'nvptx']:
         check_device(A, B, a_np, b_np, device, "softmax")
 
 def verify_softmax_4d(shape, dtype="float32"):
@@ -46,7 +47,7 @@ def verify_softmax_4d(shape, dtype="float32"):
     b_np = topi.testing.softmax_python(a_np.transpose(0, 2, 3, 1).reshape(h*w, c))
     b_np = b_np.reshape(1, h, w, c).transpose(0, 3, 1, 2)
 
-    for device in ['cuda', 'opencl', 'metal', 'rocm', 'vulkan', 'nvptx']:
+    for device in ['llvm', 'cuda', 'opencl', 'metal', 'rocm', 'vulkan', 'nvptx']:
         check_device(A, B, a_np, b_np, device, "softmax")
 
 def test_softmax():
@@ -73,7 +74,42 @@ def test_log_softmax():
     verify_log_softmax(3, 4)
     verify_log_softmax(32, 10, "float64")
 
+def test_softmax_x86_tuning_task():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    for args in [((32, 1000), "float32", 1), ((1, 16, 32, 32), "float32", 1)]:
+        shape, dtype, axis = args
+        task = autotvm.task.create("topi_x86_softmax", args=args,
+                                   target="llvm", template_key="direct")
+        assert task.workload == ("topi_x86_softmax",) + args
+        assert len(task.config_space) > 1
+        a_np = np.random.uniform(size=shape).astype(dtype)
+        e_np = np.exp(a_np - a_np.max(axis=axis, keepdims=True))
+        b_np = e_np / e_np.sum(axis=axis, keepdims=True)
+        ctx = tvm.cpu(0)
+        for index in np.random.randint(0, len(task.config_space), size=5):
+            with tvm.target.create("llvm"):
+                s, (A, B) = task.instantiate(task.config_space.get(index))
+            f = tvm.build(s, [A, B], "llvm")
+            b = tvm.nd.array(np.zeros(shape, dtype=dtype), ctx)
+            f(tvm.nd.array(a_np, ctx), b)
+            tvm.testing.assert_allclose(b.asnumpy(), b_np, rtol=1e-5)
+
+    # symbolic shapes have no workload and keep the default schedule
+    n = tvm.var("n")
+    A = tvm.placeholder((n, 10), name="A")
+    B = topi.nn.softmax(A)
+    with tvm.target.create("llvm"):
+        s = topi.generic.schedule_softmax(B)
+    f = tvm.build(s, [A, B], "llvm")
+    a_np = np.random.uniform(size=(7, 10)).astype(A.dtype)
+    b = tvm.nd.array(np.zeros((7, 10), dtype=B.dtype), tvm.cpu(0))
+    f(tvm.nd.array(a_np, tvm.cpu(0)), b)
+    tvm.testing.assert_allclose(b.asnumpy(), topi.testing.softmax_python(a_np), rtol=1e-5)
+
 if __name__ == "__main__":
     logging.basicConfig(level=logging.DEBUG)
     test_softmax()
     test_log_softmax()
+    test_softmax_x86_tuning_task()
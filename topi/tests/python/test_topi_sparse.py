@@ -1,6 +1,7 @@
 """Test code for sparse operator"""
 import numpy as np
 import tvm
+from tvm import autotvm
 import topi
 import topi.testing
 from topi.util import get_const_tuple
@@ -168,6 +169,80 @@ def verify_dense_sw(batch, in_dim, out_dim, use_bias=True, dtype='float32'):
 
     check_device('llvm')
 
+def random_bsr_matrix(M, N, BS_R, BS_C, density, dtype="float32"):
+    """Random [M, N] matrix with density non-zero blocks, in dense and BSR format"""
+    blocks = np.random.uniform(size=(M // BS_R, N // BS_C, BS_R, BS_C)).astype(dtype)
+    mask = np.random.uniform(size=(M // BS_R, N // BS_C)) < density
+    blocks *= mask[:, :, None, None]
+    dense = blocks.transpose(0, 2, 1, 3).reshape(M, N)
+    indptr = np.concatenate([[0], np.cumsum(np.sum(mask, axis=1))]).astype("int32")
+    return dense, blocks[mask], np.nonzero(mask)[1].astype("int32"), indptr
+
+def verify_sparse_dense(M, N, K, BS_R, BS_C, density):
+    X_np = np.random.randn(M, K).astype("float32")
+    W_np, W_data, W_indices, W_indptr = random_bsr_matrix(N, K, BS_R, BS_C, density)
+    if (BS_R, BS_C) == (1, 1):
+        W_data = W_data.reshape(-1)
+    Y_np = X_np.dot(W_np.T)
+
+    W_data_tvm = tvm.placeholder(shape=W_data.shape, dtype=str(W_data.dtype))
+    W_indices_tvm = tvm.placeholder(shape=W_indices.shape, dtype=str(W_indices.dtype))
+    W_indptr_tvm = tvm.placeholder(shape=W_indptr.shape, dtype=str(W_indptr.dtype))
+    X_tvm = tvm.placeholder(shape=X_np.shape, dtype=str(X_np.dtype))
+    Y_tvm = topi.nn.sparse_dense(X_tvm, W_data_tvm, W_indices_tvm, W_indptr_tvm)
+    Z_tvm = topi.nn.relu(Y_tvm)
+
+    ctx = tvm.context('llvm', 0)
+    if not ctx.exist:
+        print("Skip because llvm is not enabled")
+        return
+    with tvm.target.create('llvm'):
+        s = topi.generic.schedule_sparse_dense([Y_tvm])
+        s_fused = topi.generic.schedule_sparse_dense([Z_tvm])
+    func = tvm.build(s, [X_tvm, W_data_tvm, W_indices_tvm, W_indptr_tvm, Y_tvm], 'llvm')
+    func_fused = tvm.build(s_fused, [X_tvm, W_data_tvm, W_indices_tvm, W_indptr_tvm, Z_tvm],
+                           'llvm')
+    args = [tvm.nd.array(x, ctx) for x in [X_np, W_data, W_indices, W_indptr]]
+    Y = tvm.nd.empty(Y_np.shape, dtype=Y_np.dtype, ctx=ctx)
+    Z = tvm.nd.empty(Y_np.shape, dtype=Y_np.dtype, ctx=ctx)
+    func(*(args + [Y]))
+    func_fused(*(args + [Z]))
+    tvm.testing.assert_allclose(Y.asnumpy(), Y_np, atol=1e-4, rtol=1e-4)
+    tvm.testing.assert_allclose(Z.asnumpy(), np.maximum(Y_np, 0), atol=1e-4, rtol=1e-4)
+
+def test_sparse_dense():
+    verify_sparse_dense(M=1, N=64, K=128, BS_R=1, BS_C=1, density=0.2)
+    verify_sparse_dense(M=5, N=64, K=128, BS_R=1, BS_C=1, density=0.2)
+    verify_sparse_dense(M=1, N=64, K=128, BS_R=8, BS_C=1, density=0.2)
+    verify_sparse_dense(M=5, N=64, K=128, BS_R=16, BS_C=4, density=0.3)
+
+def test_sparse_dense_bsr_tuning_task():
+    if not tvm.module.enabled("llvm"):
+        print("Skip because llvm is not enabled")
+        return
+    W_np, _, _, _ = random_bsr_matrix(64, 128, 8, 1, 0.1)
+    block_density = topi.x86.sparse.bsr_block_density(W_np)
+    density = dict(((r, c), d) for r, c, d in block_density)
+    # larger blocks fill in zeros
+    assert density[(1, 1)] == density[(8, 1)]
+    assert density[(16, 4)] > density[(8, 1)]
+
+    args = (1, 64, 128, block_density, "float32")
+    task = autotvm.task.create("topi_x86_sparse_dense_bsr", args=args, target="llvm")
+    assert len(task.config_space) == 5 * 4
+    for index in range(len(task.config_space)):
+        cfg = task.config_space.get(index)
+        bs_r, bs_c = cfg['bs_r'].val, cfg['bs_c'].val
+        with tvm.target.create("llvm"):
+            _, (_, weight_data, _) = task.instantiate(cfg)
+        # the measured weight has the block density of the config
+        num_block_cols = 128 // bs_c
+        row_blocks = min(num_block_cols,
+                         max(1, int(round(density[(bs_r, bs_c)] * num_block_cols))))
+        assert get_const_tuple(weight_data.shape) == (64 // bs_r * row_blocks, bs_r, bs_c)
+    with tvm.target.create("llvm"):
+        assert topi.x86.sparse.get_bsr_block_size(*args) == (8, 1)
+
 def test_csrmv():
     verify_dynamic_csrmv(batch=5, in_dim=7, out_dim=1, use_bias=False)
     verify_dynamic_csrmv(batch=5, in_dim=7, out_dim=1, use_bias=True)
@@ -203,3 +278,5 @@ if __name__ == "__main__":
     test_csrmv()
     test_csrmm()
     test_dense()
+    test_sparse_dense()
+    test_sparse_dense_bsr_tuning_task()
@@ -51,6 +51,40 @@ def test_nms():
         check_device(device)
 
 
+def verify_nms(batch_size, num_anchors, num_classes, nms_threshold, force_suppress, nms_topk):
+    dshape = (batch_size, num_anchors, 6)
+    data = tvm.placeholder(dshape, name="data")
+    valid_count = tvm.placeholder((batch_size,), dtype="int32", name="valid_count")
+
+    np_data = np.zeros(dshape, dtype=data.dtype)
+    np_data[:, :, 0] = np.random.randint(0, num_classes, size=(batch_size, num_anchors))
+    np_data[:, :, 1] = np.random.uniform(size=(batch_size, num_anchors))
+    np_data[:, :, 2:4] = np.random.uniform(0, 1, size=(batch_size, num_anchors, 2))
+    np_data[:, :, 4:6] = np_data[:, :, 2:4] + \
+        np.random.uniform(0.1, 0.5, size=(batch_size, num_anchors, 2))
+    np_valid_count = np.random.randint(num_anchors // 2, num_anchors + 1,
+                                       size=(batch_size,)).astype(valid_count.dtype)
+    np_result = topi.testing.nms_python(np_data, np_valid_count, nms_threshold,
+                                        force_suppress, nms_topk)
+
+    ctx = tvm.cpu(0)
+    with tvm.target.create("llvm"):
+        out = nms(data, valid_count, nms_threshold, force_suppress, nms_topk)
+        s = topi.generic.schedule_nms(out)
+    f = tvm.build(s, [data, valid_count, out], "llvm")
+    tvm_out = tvm.nd.array(np.zeros(dshape, dtype=data.dtype), ctx)
+    f(tvm.nd.array(np_data, ctx), tvm.nd.array(np_valid_count, ctx), tvm_out)
+    tvm.testing.assert_allclose(tvm_out.asnumpy(), np_result, rtol=1e-4)
+
+
+def test_nms_batch_classes():
+    for force_suppress in [True, False]:
+        verify_nms(1, 37, 1, 0.5, force_suppress, -1)
+        verify_nms(2, 100, 3, 0.5, force_suppress, -1)
+        verify_nms(3, 200, 20, 0.3, force_suppress, 50)
+    verify_nms(2, 64, 3, 1.0, False, -1)
+
+
 def verify_multibox_prior(dshape, sizes=(1,), ratios=(1,), steps=(-1, -1), offsets=(0.5, 0.5), clip=False):
     data = tvm.placeholder(dshape, name="data")
 
@@ -275,6 +309,7 @@ def test_proposal():
 
 if __name__ == "__main__":
     test_nms()
+    test_nms_batch_classes()
     test_multibox_prior()
     test_multibox_detection()
     test_roi_align()